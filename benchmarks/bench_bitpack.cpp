@@ -0,0 +1,177 @@
+#include "ilp_for.hpp"
+#include "ilp_for/kernels/bitpack.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== Bit-packed and dictionary columns: fused decode vs decode-then-scan ====================
+// Pattern: scans over a 12-bit packed integer column and a dictionary-encoded string column.
+// Decode: unpack the whole column into a std::vector, then ILP_FOR_RANGE over it; the column
+// is read once and the decoded copy is written and read again.
+// View: ILP_FOR_RANGE over the packed_view itself, decoding one value per index.
+// Fused: for_each_decoded<8>, which unpacks 8 values at a time with compile-time shifts
+// straight into the body and stops decoding at the break.
+//  - Sum: every value.
+//  - Search: the first value above a threshold, placed 90% of the way in.
+//  - Dict: the first row whose string is a rare entry of a 1024-string dictionary, through
+//    10-bit packed codes.
+
+constexpr unsigned BITS = 12;
+constexpr unsigned CODE_BITS = 10;
+
+struct Column {
+    std::vector<std::uint64_t> words;
+    std::size_t size;
+    ilp::packed_view<BITS> view() const { return {words, size}; }
+};
+
+static Column make_column(std::size_t n) {
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_int_distribution<std::uint32_t> dist(0, 4000);
+    std::vector<std::uint32_t> v(n);
+    for (auto& x : v)
+        x = dist(rng);
+    v[n / 10 * 9] = 4095;
+    return {ilp::bitpack::pack<BITS>(v), n};
+}
+
+static std::vector<std::uint32_t> decode(ilp::packed_view<BITS> col) {
+    std::vector<std::uint32_t> out(col.size());
+    ilp::for_each_decoded<8>(col, [p = out.data()](std::uint32_t v) mutable { *p++ = v; });
+    return out;
+}
+
+NOINLINE static std::uint64_t sum_decode(ilp::packed_view<BITS> col) {
+    const auto values = decode(col);
+    std::uint64_t s = 0;
+    ILP_FOR_RANGE(auto v, values, 8) {
+        s += v;
+    }
+    ILP_END;
+    return s;
+}
+
+NOINLINE static std::uint64_t sum_view(ilp::packed_view<BITS> col) {
+    std::uint64_t s = 0;
+    ILP_FOR_RANGE(auto v, col, 8) {
+        s += v;
+    }
+    ILP_END;
+    return s;
+}
+
+NOINLINE static std::uint64_t sum_fused(ilp::packed_view<BITS> col) {
+    std::uint64_t s = 0;
+    ilp::for_each_decoded<8>(col, [&](std::uint32_t v) { s += v; });
+    return s;
+}
+
+NOINLINE static std::size_t search_decode(ilp::packed_view<BITS> col) {
+    const auto values = decode(col);
+    ILP_FOR(auto i, std::size_t{0}, values.size(), 8) {
+        if (values[i] > 4000)
+            ILP_RETURN(i);
+    }
+    ILP_END_RETURN;
+    return values.size();
+}
+
+NOINLINE static std::size_t search_view(ilp::packed_view<BITS> col) {
+    ILP_FOR(auto i, std::size_t{0}, col.size(), 8) {
+        if (col[i] > 4000)
+            ILP_RETURN(i);
+    }
+    ILP_END_RETURN;
+    return col.size();
+}
+
+NOINLINE static std::size_t search_fused(ilp::packed_view<BITS> col) {
+    return ilp::for_each_decoded<8>(col, [](std::uint32_t v, ilp::LoopCtrl<void>& ctrl) {
+               if (v > 4000)
+                   ctrl.break_loop();
+           }) - 1;
+}
+
+struct DictColumn {
+    std::vector<std::string> dict;
+    std::vector<std::uint64_t> words;
+    std::size_t size;
+    ilp::dict_view<ilp::packed_view<CODE_BITS>, std::vector<std::string>> view() const {
+        return {ilp::packed_view<CODE_BITS>(words, size), dict};
+    }
+};
+
+static DictColumn make_dict_column(std::size_t n) {
+    DictColumn c;
+    for (std::size_t i = 0; i < 1024; ++i)
+        c.dict.push_back("venue-" + std::to_string(i * 7919));
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_int_distribution<std::uint32_t> dist(0, 1022);
+    std::vector<std::uint32_t> codes(n);
+    for (auto& x : codes)
+        x = dist(rng);
+    codes[n / 10 * 9] = 1023;
+    c.words = ilp::bitpack::pack<CODE_BITS>(codes);
+    c.size = n;
+    return c;
+}
+
+NOINLINE static std::size_t dict_decode(const DictColumn& c, const std::string& needle) {
+    std::vector<const std::string*> values(c.size);
+    ilp::for_each_decoded<8>(c.view(), [p = values.data()](const std::string& s) mutable { *p++ = &s; });
+    ILP_FOR(auto i, std::size_t{0}, values.size(), 8) {
+        if (*values[i] == needle)
+            ILP_RETURN(i);
+    }
+    ILP_END_RETURN;
+    return values.size();
+}
+
+NOINLINE static std::size_t dict_fused(const DictColumn& c, const std::string& needle) {
+    return ilp::for_each_decoded<8>(c.view(), [&](const std::string& s, ilp::LoopCtrl<void>& ctrl) {
+               if (s == needle)
+                   ctrl.break_loop();
+           }) - 1;
+}
+
+template<auto Fn>
+static void BM_Packed(benchmark::State& state) {
+    const auto col = make_column(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Fn(col.view()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<auto Fn>
+static void BM_Dict(benchmark::State& state) {
+    const auto col = make_dict_column(static_cast<std::size_t>(state.range(0)));
+    const std::string needle = col.dict.back();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Fn(col, needle));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) / 10 * 9);
+}
+
+// 64 Ki values (96 KiB packed) to 64 Mi values (96 MiB packed, 256 MiB decoded)
+#define ILP_BENCH_SIZES ->RangeMultiplier(32)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMicrosecond)
+
+BENCHMARK(BM_Packed<sum_decode>)->Name("BM_Sum_Decode") ILP_BENCH_SIZES;
+BENCHMARK(BM_Packed<sum_view>)->Name("BM_Sum_View") ILP_BENCH_SIZES;
+BENCHMARK(BM_Packed<sum_fused>)->Name("BM_Sum_Fused") ILP_BENCH_SIZES;
+BENCHMARK(BM_Packed<search_decode>)->Name("BM_Search_Decode") ILP_BENCH_SIZES;
+BENCHMARK(BM_Packed<search_view>)->Name("BM_Search_View") ILP_BENCH_SIZES;
+BENCHMARK(BM_Packed<search_fused>)->Name("BM_Search_Fused") ILP_BENCH_SIZES;
+BENCHMARK(BM_Dict<dict_decode>)->Name("BM_Dict_Decode") ILP_BENCH_SIZES;
+BENCHMARK(BM_Dict<dict_fused>)->Name("BM_Dict_Fused") ILP_BENCH_SIZES;
+
+BENCHMARK_MAIN();
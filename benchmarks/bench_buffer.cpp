@@ -0,0 +1,150 @@
+#include "ilp_for.hpp"
+#include "ilp_for/memory/buffer.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== ilp::buffer: pages, alignment and padding ====================
+// Pattern: the same loops over a std::vector and an ilp::buffer.
+//  - Gather: random reads over 256 MiB. With 4 KiB pages nearly every read misses the TLB and
+//    walks the page tables; with 2 MiB pages (Pages::Huge) the walks mostly hit in cache.
+//  - Scan: a sequential sum over 256 MiB, where the prefetchers hide most of the walks.
+//  - Misaligned: a sum over L1-resident words starting 4 bytes past a cache line, so every
+//    full-width vector load splits across two lines, against the same sum over a buffer.
+//  - Padded: many short sums of an odd length, where the remainder loop is a visible share of
+//    the work, over the buffer's elements and over padded().
+
+constexpr std::size_t BIG = std::size_t{256} << 20;
+
+template<typename Storage>
+static Storage& big_floats(Storage& s) {
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (std::size_t i = 0; i < s.size(); ++i)
+        s[i] = dist(rng);
+    return s;
+}
+
+static const std::vector<std::uint32_t>& gather_indices() {
+    static const std::vector<std::uint32_t> idx = [] {
+        std::mt19937 rng(BENCH_SEED + 1);
+        std::uniform_int_distribution<std::uint32_t> dist(0, BIG / sizeof(float) - 1);
+        std::vector<std::uint32_t> v(std::size_t{1} << 20);
+        for (auto& i : v)
+            i = dist(rng);
+        return v;
+    }();
+    return idx;
+}
+
+NOINLINE static float gather(const float* p, const std::vector<std::uint32_t>& idx) {
+    float s = 0.0f;
+    ILP_FOR_RANGE(auto i, idx, 8) {
+        s += p[i];
+    }
+    ILP_END;
+    return s;
+}
+
+template<typename Range>
+NOINLINE static std::uint32_t sum(const Range& r) {
+    std::uint32_t s = 0;
+    ILP_FOR_RANGE(auto x, r, 8) {
+        s += x;
+    }
+    ILP_END;
+    return s;
+}
+
+static void BM_Gather_Vector(benchmark::State& state) {
+    std::vector<float> v(BIG / sizeof(float));
+    big_floats(v);
+    const auto& idx = gather_indices();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(gather(v.data(), idx));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * idx.size()));
+}
+
+template<ilp::Pages P>
+static void BM_Gather_Buffer(benchmark::State& state) {
+    ilp::buffer<float> buf(BIG / sizeof(float), P);
+    big_floats(buf);
+    const auto& idx = gather_indices();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(gather(buf.data(), idx));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * idx.size()));
+}
+
+static void BM_Scan_Vector(benchmark::State& state) {
+    std::vector<std::uint32_t> v(BIG / sizeof(std::uint32_t), 1u);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(v));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * BIG));
+}
+
+template<ilp::Pages P>
+static void BM_Scan_Buffer(benchmark::State& state) {
+    ilp::buffer<std::uint32_t> buf(BIG / sizeof(std::uint32_t), 1u, P);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(buf));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * BIG));
+}
+
+constexpr std::size_t SMALL = 4096; // 16 KiB, L1-resident
+
+static void BM_Sum_Misaligned(benchmark::State& state) {
+    ilp::buffer<std::uint32_t> raw(SMALL + 16, 1u);
+    std::span<const std::uint32_t> view(raw.data() + 1, SMALL);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(view));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * SMALL * sizeof(std::uint32_t)));
+}
+
+static void BM_Sum_Aligned(benchmark::State& state) {
+    ilp::buffer<std::uint32_t> buf(SMALL, 1u);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(buf));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * SMALL * sizeof(std::uint32_t)));
+}
+
+constexpr std::size_t ODD = 61; // 3 blocks of 16 and a 13-element remainder
+
+static void BM_Short_Elements(benchmark::State& state) {
+    ilp::buffer<std::uint32_t> buf(ODD, 1u);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(buf));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_Short_Padded(benchmark::State& state) {
+    ilp::buffer<std::uint32_t> buf(ODD, 1u);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sum(buf.padded()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_Gather_Vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Gather_Buffer<ilp::Pages::Default>)->Name("BM_Gather_Buffer<Default>")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Gather_Buffer<ilp::Pages::Huge>)->Name("BM_Gather_Buffer<Huge>")->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Scan_Vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Scan_Buffer<ilp::Pages::Default>)->Name("BM_Scan_Buffer<Default>")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Scan_Buffer<ilp::Pages::Huge>)->Name("BM_Scan_Buffer<Huge>")->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Sum_Misaligned);
+BENCHMARK(BM_Sum_Aligned);
+
+BENCHMARK(BM_Short_Elements);
+BENCHMARK(BM_Short_Padded);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,143 @@
+#include "ilp_for.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+static constexpr uint32_t BENCH_SEED = 42;
+
+// ==================== ILP_FOR_CORO POINTER CHASE BENCHMARKS ====================
+// Pattern: each key walks a chain of dependent loads (list / tree descent).
+// Within one key every load waits on the previous one, so the only way to hide
+// the miss latency is to overlap the chains of several keys.
+
+static constexpr size_t CHASE_HOPS = 8;
+
+struct ChaseNode {
+    const ChaseNode* next;
+    uint64_t value;
+};
+
+NOINLINE static uint64_t chase_simple(const ChaseNode* const* starts, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const ChaseNode* node = starts[i];
+        for (size_t h = 0; h < CHASE_HOPS; ++h)
+            node = node->next;
+        sum += node->value;
+    }
+    return sum;
+}
+
+// Hand-written group prefetch: every hop is one stage run across the whole
+// group, so G misses are in flight per stage.
+template<size_t G>
+NOINLINE static uint64_t chase_state_machine(const ChaseNode* const* starts, size_t n) {
+    uint64_t sum = 0;
+    size_t i = 0;
+    for (; i + G <= n; i += G) {
+        const ChaseNode* nodes[G];
+        for (size_t g = 0; g < G; ++g) {
+            nodes[g] = starts[i + g];
+            ilp::detail::prefetch_address(nodes[g]);
+        }
+        for (size_t h = 0; h < CHASE_HOPS; ++h) {
+            for (size_t g = 0; g < G; ++g) {
+                nodes[g] = nodes[g]->next;
+                ilp::detail::prefetch_address(nodes[g]);
+            }
+        }
+        for (size_t g = 0; g < G; ++g)
+            sum += nodes[g]->value;
+    }
+    for (; i < n; ++i) {
+        const ChaseNode* node = starts[i];
+        for (size_t h = 0; h < CHASE_HOPS; ++h)
+            node = node->next;
+        sum += node->value;
+    }
+    return sum;
+}
+
+template<size_t G>
+NOINLINE static uint64_t chase_coro(const ChaseNode* const* starts, size_t n) {
+    uint64_t sum = 0;
+    ILP_FOR_CORO(auto i, size_t{0}, n, G) {
+        const ChaseNode* node = starts[i];
+        ILP_CO_PREFETCH(node);
+        for (size_t h = 0; h < CHASE_HOPS; ++h) {
+            node = node->next;
+            ILP_CO_PREFETCH(node);
+        }
+        sum += node->value;
+    }
+    ILP_END;
+    return sum;
+}
+
+class ChaseFixture : public benchmark::Fixture {
+  public:
+    std::vector<ChaseNode> nodes;
+    std::vector<const ChaseNode*> starts;
+
+    void SetUp(const benchmark::State& state) override {
+        size_t count = size_t{1} << state.range(0);
+        nodes.resize(count);
+
+        // One random cycle through the pool so every hop is a fresh miss
+        std::mt19937_64 rng(BENCH_SEED);
+        std::vector<size_t> order(count);
+        for (size_t i = 0; i < count; ++i)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (size_t i = 0; i < count; ++i)
+            nodes[order[i]] = ChaseNode{&nodes[order[(i + 1) % count]], i};
+
+        starts.resize(size_t{1} << 14);
+        for (auto& s : starts)
+            s = &nodes[rng() % count];
+    }
+
+    void TearDown(const benchmark::State&) override {
+        nodes.clear();
+        nodes.shrink_to_fit();
+    }
+};
+
+BENCHMARK_DEFINE_F(ChaseFixture, Simple)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum = chase_simple(starts.data(), starts.size());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+
+BENCHMARK_DEFINE_F(ChaseFixture, StateMachine)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum = chase_state_machine<8>(starts.data(), starts.size());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+
+BENCHMARK_DEFINE_F(ChaseFixture, Coro)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto sum = chase_coro<8>(starts.data(), starts.size());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+
+// 2^12 nodes fits in L1/L2; 2^24 (256 MB) is well outside LLC
+BENCHMARK_REGISTER_F(ChaseFixture, Simple)->Arg(12)->Arg(18)->Arg(24)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ChaseFixture, StateMachine)->Arg(12)->Arg(18)->Arg(24)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ChaseFixture, Coro)->Arg(12)->Arg(18)->Arg(24)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
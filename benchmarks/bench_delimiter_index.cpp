@@ -0,0 +1,87 @@
+#include "ilp_for/kernels/delimiter_index.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== DELIMITER INDEX: SWAR blocks vs char-by-char ====================
+// Pattern: find every structural ',' and '\n' in a CSV buffer, honouring "..." quotes.
+// Baseline is the usual state machine: one byte, one branch on the quote state, one
+// compare per delimiter. The index does 64 bytes per step with word-wide compares.
+
+static std::string make_csv(size_t bytes) {
+    std::mt19937 rng(BENCH_SEED);
+    std::string s;
+    s.reserve(bytes + 256);
+    while (s.size() < bytes) {
+        for (int f = 0; f < 10; ++f) {
+            if (f)
+                s.push_back(',');
+            if (rng() % 8 == 0) {
+                s += "\"Smith, J said \"\"hi\"\"\"";
+            } else {
+                for (int k = 1 + static_cast<int>(rng() % 12); k > 0; --k)
+                    s.push_back(static_cast<char>('a' + rng() % 26));
+            }
+        }
+        s.push_back('\n');
+    }
+    return s;
+}
+
+NOINLINE static size_t index_scalar(std::string_view text, std::vector<uint32_t>& out) {
+    out.clear();
+    bool in_quote = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '"')
+            in_quote = !in_quote;
+        else if (!in_quote && (c == ',' || c == '\n'))
+            out.push_back(static_cast<uint32_t>(i));
+    }
+    return out.size();
+}
+
+NOINLINE static size_t index_swar(std::string_view text, ilp::delimiter_index& idx) {
+    return idx.build(text).size();
+}
+
+class DelimiterIndex : public benchmark::Fixture {
+  public:
+    std::string csv;
+
+    void SetUp(const benchmark::State& state) override { csv = make_csv(static_cast<size_t>(state.range(0))); }
+    void TearDown(const benchmark::State&) override { csv = {}; }
+};
+
+BENCHMARK_DEFINE_F(DelimiterIndex, Scalar)(benchmark::State& state) {
+    std::vector<uint32_t> out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index_scalar(csv, out));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * csv.size()));
+}
+
+BENCHMARK_DEFINE_F(DelimiterIndex, Swar)(benchmark::State& state) {
+    ilp::delimiter_index idx(",\n");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index_swar(csv, idx));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * csv.size()));
+}
+
+// Arg: buffer bytes (L2-resident and memory-sized)
+BENCHMARK_REGISTER_F(DelimiterIndex, Scalar)->Arg(256 << 10)->Arg(64 << 20);
+BENCHMARK_REGISTER_F(DelimiterIndex, Swar)->Arg(256 << 10)->Arg(64 << 20);
+
+BENCHMARK_MAIN();
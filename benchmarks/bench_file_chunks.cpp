@@ -0,0 +1,113 @@
+#include "ilp_for.hpp"
+#include "ilp_for/io/file_chunks.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+// ==================== FILE CHUNKS: io_uring vs pread ====================
+// Pattern: sum a 512 MB column file chunk by chunk with an unrolled loop.
+// The page cache is dropped for the file before every iteration (POSIX_FADV_DONTNEED),
+// so reads come from the device. Reports throughput and CPU seconds (user + sys,
+// including io_uring worker threads) per GB.
+
+static constexpr size_t FILE_BYTES = size_t{512} << 20;
+static constexpr size_t CHUNK_ELEMS = size_t{256} << 10; // 1 MB of uint32_t
+
+static const std::filesystem::path& bench_file() {
+    static const struct File {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "ilp_for_bench_chunks.bin";
+        File() {
+            std::vector<uint32_t> block(size_t{1} << 20);
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            for (size_t written = 0; written < FILE_BYTES; written += block.size() * sizeof(uint32_t)) {
+                for (size_t i = 0; i < block.size(); ++i)
+                    block[i] = static_cast<uint32_t>(written / sizeof(uint32_t) + i);
+                out.write(reinterpret_cast<const char*>(block.data()),
+                          static_cast<std::streamsize>(block.size() * sizeof(uint32_t)));
+            }
+        }
+        ~File() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    } file;
+    return file.path;
+}
+
+static void drop_cache() {
+    int fd = open(bench_file().c_str(), O_RDONLY);
+    if (fd >= 0) {
+#if defined(POSIX_FADV_DONTNEED)
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        close(fd);
+    }
+}
+
+static double cpu_seconds() {
+    rusage u{};
+    getrusage(RUSAGE_SELF, &u);
+    return static_cast<double>(u.ru_utime.tv_sec + u.ru_stime.tv_sec) +
+           static_cast<double>(u.ru_utime.tv_usec + u.ru_stime.tv_usec) * 1e-6;
+}
+
+NOINLINE static uint64_t sum_chunk(std::span<const uint32_t> chunk, uint64_t sum) {
+    ILP_FOR_RANGE(auto v, chunk, 8) {
+        sum += v;
+    }
+    ILP_END;
+    return sum;
+}
+
+static void run_scan(benchmark::State& state, ilp::io_backend backend, unsigned depth) {
+    bench_file();
+    double cpu = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        drop_cache();
+        state.ResumeTiming();
+
+        const double c0 = cpu_seconds();
+        ilp::file_chunks<uint32_t, 8> in(bench_file(), CHUNK_ELEMS, depth, backend);
+        if (backend == ilp::io_backend::uring && in.backend() != ilp::io_backend::uring) {
+            state.SkipWithError("io_uring unavailable");
+            return;
+        }
+        uint64_t sum = 0;
+        for (auto chunk : in)
+            sum = sum_chunk(chunk, sum);
+        benchmark::DoNotOptimize(sum);
+        cpu += cpu_seconds() - c0;
+    }
+    const double gb = static_cast<double>(state.iterations()) * FILE_BYTES / 1e9;
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * FILE_BYTES));
+    state.counters["cpu_s_per_GB"] = cpu / gb;
+}
+
+static void BM_Pread(benchmark::State& state) {
+    run_scan(state, ilp::io_backend::pread, 1);
+}
+
+static void BM_IoUring(benchmark::State& state) {
+    run_scan(state, ilp::io_backend::uring, static_cast<unsigned>(state.range(0)));
+}
+
+BENCHMARK(BM_Pread)->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(5);
+// Arg: queue depth (reads in flight)
+BENCHMARK(BM_IoUring)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(5);
+
+BENCHMARK_MAIN();
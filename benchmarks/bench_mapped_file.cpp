@@ -0,0 +1,146 @@
+#include "ilp_for.hpp"
+#include "ilp_for/io/mapped_file.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+// ==================== MAPPED FILE vs READ-THEN-SCAN ====================
+// Pattern: search a large column file for the first match.
+// read() has to pull the whole file into a vector before the scan starts; the mapping starts
+// scanning at once and stops touching pages at the match.
+// Each iteration runs in a forked child so ru_maxrss is the peak for that strategy alone.
+// Both strategies read from the page cache after the first iteration.
+
+static constexpr size_t FILE_ELEMS = size_t{64} << 20; // 256 MB of uint32_t
+static constexpr uint32_t NEEDLE = 0xFFFFFFFFu;
+
+static const std::filesystem::path& bench_file() {
+    static const struct File {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "ilp_for_bench_mapped.bin";
+        File() {
+            std::vector<uint32_t> chunk(size_t{1} << 20);
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            for (size_t base = 0; base < FILE_ELEMS; base += chunk.size()) {
+                for (size_t i = 0; i < chunk.size(); ++i)
+                    chunk[i] = static_cast<uint32_t>((base + i) & 0x7FFFFFFFu);
+                out.write(reinterpret_cast<const char*>(chunk.data()),
+                          static_cast<std::streamsize>(chunk.size() * sizeof(uint32_t)));
+            }
+        }
+        ~File() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    } file;
+    return file.path;
+}
+
+// Plant the needle at a fraction (per mille) of the file; 1000 = no match
+static void plant_needle(int64_t per_mille) {
+    std::fstream f(bench_file(), std::ios::binary | std::ios::in | std::ios::out);
+    static int64_t planted = -1;
+    const uint32_t restore = static_cast<uint32_t>(planted * (FILE_ELEMS / 1000));
+    if (planted >= 0 && planted < 1000) {
+        f.seekp(static_cast<std::streamoff>(planted * (FILE_ELEMS / 1000) * sizeof(uint32_t)));
+        f.write(reinterpret_cast<const char*>(&restore), sizeof(restore));
+    }
+    if (per_mille < 1000) {
+        f.seekp(static_cast<std::streamoff>(per_mille * (FILE_ELEMS / 1000) * sizeof(uint32_t)));
+        f.write(reinterpret_cast<const char*>(&NEEDLE), sizeof(NEEDLE));
+    }
+    planted = per_mille;
+}
+
+template<typename Range>
+NOINLINE static bool find_first(const Range& range) {
+    ILP_FOR_RANGE(auto v, range, 8) {
+        if (v == NEEDLE)
+            ILP_RETURN(true);
+    }
+    ILP_END_RETURN;
+    return false;
+}
+
+static bool scan_read() {
+    std::ifstream in(bench_file(), std::ios::binary);
+    std::vector<uint32_t> data(std::filesystem::file_size(bench_file()) / sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(uint32_t)));
+    return find_first(data);
+}
+
+static bool scan_mapped() {
+    ilp::mapped_file<uint32_t> file(bench_file());
+    return find_first(file);
+}
+
+// Run fn in a child; returns seconds to first match and the child's peak RSS in MB
+template<typename Fn>
+static void run_in_child(benchmark::State& state, Fn fn) {
+    double peak_mb = 0;
+    for (auto _ : state) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            state.SkipWithError("pipe failed");
+            return;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            auto t0 = std::chrono::steady_clock::now();
+            bool found = fn();
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            benchmark::DoNotOptimize(found);
+            ssize_t w = write(fds[1], &secs, sizeof(secs));
+            _exit(w == sizeof(secs) ? 0 : 1);
+        }
+        close(fds[1]);
+        double secs = 0;
+        ssize_t r = read(fds[0], &secs, sizeof(secs));
+        close(fds[0]);
+
+        int status = 0;
+        rusage usage{};
+        wait4(pid, &status, 0, &usage);
+        if (r != sizeof(secs) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            state.SkipWithError("child failed");
+            return;
+        }
+        state.SetIterationTime(secs);
+#if defined(__APPLE__)
+        peak_mb = static_cast<double>(usage.ru_maxrss) / (1 << 20); // bytes
+#else
+        peak_mb = static_cast<double>(usage.ru_maxrss) / (1 << 10); // KB
+#endif
+    }
+    state.counters["peak_rss_MB"] = peak_mb;
+}
+
+static void BM_ReadThenScan(benchmark::State& state) {
+    plant_needle(state.range(0));
+    run_in_child(state, scan_read);
+}
+
+static void BM_MappedFile(benchmark::State& state) {
+    plant_needle(state.range(0));
+    run_in_child(state, scan_mapped);
+}
+
+// Arg: position of the first match in per mille of the file (1000 = no match, full scan)
+BENCHMARK(BM_ReadThenScan)->Arg(10)->Arg(250)->Arg(1000)->UseManualTime()->Iterations(5)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MappedFile)->Arg(10)->Arg(250)->Arg(1000)->UseManualTime()->Iterations(5)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+#include "ilp_for.hpp"
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== MIXED BODIES: per-class N vs optimal_N_for ====================
+// Pattern: one loop body with two operation classes, each kept in N independent lanes.
+// Built without vectorization (see CMakeLists.txt) so a lane is one scalar chain, which is
+// what the profile's L x TPC figures describe. Compare the N each single LoopType picks, and
+// N/2 (what splitting shared FP ports between Sum and MinMax would give), to optimal_N_for.
+
+static const std::vector<float>& floats() {
+    static const std::vector<float> buf = [] {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> v(size_t{16} << 10);
+        for (auto& x : v)
+            x = dist(rng);
+        return v;
+    }();
+    return buf;
+}
+
+static const std::vector<uint32_t>& words() {
+    static const std::vector<uint32_t> buf = [] {
+        std::mt19937 rng(BENCH_SEED + 1);
+        std::vector<uint32_t> v(size_t{16} << 10);
+        for (auto& x : v)
+            x = rng() % 1000;
+        return v;
+    }();
+    return buf;
+}
+
+// Sum + MinMax (float): FP add and FP min share ports on most cores
+template<size_t N>
+NOINLINE static float sum_min(const float* p, size_t n) {
+    std::array<float, N> sum{};
+    std::array<float, N> lo;
+    lo.fill(p[0]);
+    size_t i = 0;
+    for (; i + N <= n; i += N) {
+        for (size_t l = 0; l < N; ++l) {
+            sum[l] += p[i + l];
+            lo[l] = std::min(lo[l], p[i + l]);
+        }
+    }
+    float s = 0.0f;
+    float m = p[0];
+    for (size_t l = 0; l < N; ++l) {
+        s += sum[l];
+        m = std::min(m, lo[l]);
+    }
+    for (; i < n; ++i) {
+        s += p[i];
+        m = std::min(m, p[i]);
+    }
+    return s + m;
+}
+
+// Search + Sum (int): running total with an early exit, the exit never taken
+template<size_t N>
+NOINLINE static uint32_t search_sum(const uint32_t* p, size_t n, uint32_t target) {
+    std::array<uint32_t, N> sum{};
+    size_t i = 0;
+    for (; i + N <= n; i += N) {
+        bool hit = false;
+        for (size_t l = 0; l < N; ++l) {
+            sum[l] += p[i + l];
+            hit |= p[i + l] == target;
+        }
+        if (hit)
+            break;
+    }
+    uint32_t s = 0;
+    for (size_t l = 0; l < N; ++l)
+        s += sum[l];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template<size_t N>
+static void BM_SumMin(benchmark::State& state) {
+    const auto& v = floats();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_min<N>(v.data(), v.size()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * v.size()));
+}
+
+template<size_t N>
+static void BM_SearchSum(benchmark::State& state) {
+    const auto& v = words();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(search_sum<N>(v.data(), v.size(), 5000u));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * v.size()));
+}
+
+using ilp::LoopType;
+
+BENCHMARK(BM_SumMin<1>);
+BENCHMARK(BM_SumMin<ilp::optimal_N<LoopType::Sum, float> / 2>)->Name("BM_SumMin<optimal_N<Sum> / 2>");
+BENCHMARK(BM_SumMin<ilp::optimal_N<LoopType::Sum, float>>)->Name("BM_SumMin<optimal_N<Sum>>");
+BENCHMARK(BM_SumMin<ilp::optimal_N<LoopType::MinMax, float>>)->Name("BM_SumMin<optimal_N<MinMax>>");
+BENCHMARK(BM_SumMin<ilp::optimal_N_for<float, LoopType::Sum, LoopType::MinMax>>)
+    ->Name("BM_SumMin<optimal_N_for<Sum, MinMax>>");
+BENCHMARK(BM_SumMin<16>);
+
+BENCHMARK(BM_SearchSum<1>);
+BENCHMARK(BM_SearchSum<ilp::optimal_N<LoopType::Search, uint32_t>>)->Name("BM_SearchSum<optimal_N<Search>>");
+BENCHMARK(BM_SearchSum<ilp::optimal_N<LoopType::Sum, uint32_t>>)->Name("BM_SearchSum<optimal_N<Sum>>");
+BENCHMARK(BM_SearchSum<ilp::optimal_N_for<uint32_t, LoopType::Search, LoopType::Sum>>)
+    ->Name("BM_SearchSum<optimal_N_for<Search, Sum>>");
+BENCHMARK(BM_SearchSum<16>);
+
+BENCHMARK_MAIN();
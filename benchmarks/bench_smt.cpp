@@ -0,0 +1,157 @@
+#include "ilp_for.hpp"
+#include "ilp_for/cpu_profiles/ilp_topology.hpp"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <pthread.h>
+#include <random>
+#include <sched.h>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== SMT: full-core vs shared-core N ====================
+// Pattern: port-bound reductions over L1-resident data, one thread on a core and then one on
+// each hyperthread of the same core. Built without vectorization (see CMakeLists.txt) so a
+// lane is one scalar chain. With a busy sibling each thread gets about half the ports, so the
+// shared-core N (cpu::shared_core) should match the full-core N's throughput per thread with
+// half the lanes; alone on the core the full-core N should win.
+
+static const std::vector<float>& floats() {
+    static const std::vector<float> buf = [] {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> v(size_t{4} << 10);
+        for (auto& x : v)
+            x = dist(rng);
+        return v;
+    }();
+    return buf;
+}
+
+static const std::vector<uint64_t>& words() {
+    static const std::vector<uint64_t> buf = [] {
+        std::mt19937_64 rng(BENCH_SEED + 1);
+        std::vector<uint64_t> v(size_t{2} << 10);
+        for (auto& x : v)
+            x = rng();
+        return v;
+    }();
+    return buf;
+}
+
+template<size_t N>
+NOINLINE static float sum(const float* p, size_t n) {
+    std::array<float, N> acc{};
+    size_t i = 0;
+    for (; i + N <= n; i += N)
+        for (size_t l = 0; l < N; ++l)
+            acc[l] += p[i + l];
+    float s = 0.0f;
+    for (size_t l = 0; l < N; ++l)
+        s += acc[l];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template<size_t N>
+NOINLINE static uint64_t bitwise(const uint64_t* p, size_t n) {
+    std::array<uint64_t, N> acc{};
+    size_t i = 0;
+    for (; i + N <= n; i += N)
+        for (size_t l = 0; l < N; ++l)
+            acc[l] ^= p[i + l];
+    uint64_t x = 0;
+    for (size_t l = 0; l < N; ++l)
+        x ^= acc[l];
+    for (; i < n; ++i)
+        x ^= p[i];
+    return x;
+}
+
+// A CPU with a sibling hyperthread, and that sibling; {-1, -1} without SMT
+static std::array<int, 2> sibling_pair() {
+    const auto& siblings = ilp::cpu::detail::smt_siblings();
+    for (size_t cpu = 0; cpu < siblings.size(); ++cpu)
+        if (!siblings[cpu].empty())
+            return {static_cast<int>(cpu), siblings[cpu].front()};
+    return {-1, -1};
+}
+
+// Pins the benchmark thread to its hyperthread of the pair for one run, then lets it go
+class PinToCore {
+  public:
+    explicit PinToCore(benchmark::State& state) {
+        const auto pair = sibling_pair();
+        if (pair[0] < 0) {
+            state.SkipWithError("no SMT siblings (SMT off or topology unreadable)");
+            return;
+        }
+        pthread_getaffinity_np(pthread_self(), sizeof(saved_), &saved_);
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(pair[static_cast<size_t>(state.thread_index()) % 2], &one);
+        pinned_ = pthread_setaffinity_np(pthread_self(), sizeof(one), &one) == 0;
+        if (!pinned_)
+            state.SkipWithError("pthread_setaffinity_np failed");
+    }
+    ~PinToCore() {
+        if (pinned_)
+            pthread_setaffinity_np(pthread_self(), sizeof(saved_), &saved_);
+    }
+    bool ok() const { return pinned_; }
+
+  private:
+    cpu_set_t saved_{};
+    bool pinned_ = false;
+};
+
+template<size_t N>
+static void BM_Sum(benchmark::State& state) {
+    PinToCore pin(state);
+    if (!pin.ok())
+        return;
+    const auto& v = floats();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum<N>(v.data(), v.size()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * v.size()));
+}
+
+template<size_t N>
+static void BM_Bitwise(benchmark::State& state) {
+    PinToCore pin(state);
+    if (!pin.ok())
+        return;
+    const auto& v = words();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bitwise<N>(v.data(), v.size()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * v.size()));
+}
+
+using ilp::LoopType;
+using ilp::detail::shared_core_N_for;
+
+BENCHMARK(BM_Sum<ilp::optimal_N_for<float, LoopType::Sum>>)->Name("BM_Sum<full-core N>")->Threads(1)->Threads(2);
+BENCHMARK(BM_Sum<shared_core_N_for<float, LoopType::Sum>>)->Name("BM_Sum<shared-core N>")->Threads(1)->Threads(2);
+BENCHMARK(BM_Sum<1>)->Threads(1)->Threads(2);
+
+BENCHMARK(BM_Bitwise<ilp::optimal_N_for<uint64_t, LoopType::Bitwise>>)
+    ->Name("BM_Bitwise<full-core N>")
+    ->Threads(1)
+    ->Threads(2);
+BENCHMARK(BM_Bitwise<shared_core_N_for<uint64_t, LoopType::Bitwise>>)
+    ->Name("BM_Bitwise<shared-core N>")
+    ->Threads(1)
+    ->Threads(2);
+BENCHMARK(BM_Bitwise<1>)->Threads(1)->Threads(2);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+#include "ilp_for.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== Streaming stores: regular vs non-temporal output ====================
+// Pattern: Copy and Transform through for_loop_range_store, swept from L1-sized to well past
+// the last-level cache. While the output fits in cache the regular stores win: the lines stay
+// resident for the next pass. Past the LLC each regular store first reads its line from DRAM
+// and later evicts it, so streaming moves about a third less traffic. The Auto rows switch at
+// ilp::detail::streaming_bytes() and should track the better one at every size. Built with
+// -DILP_DETECT_CACHES so the switch sits at the host's LLC. GB/s counts source plus destination.
+
+static const std::vector<float>& floats(std::size_t bytes) {
+    static std::vector<float> buf;
+    const std::size_t n = bytes / sizeof(float);
+    if (buf.size() != n) {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        buf.resize(n);
+        for (auto& x : buf)
+            x = dist(rng);
+    }
+    return buf;
+}
+
+constexpr std::size_t N = ilp::optimal_N_for<float, ilp::LoopType::Transform>;
+
+template<ilp::StoreMode Mode>
+static void BM_Copy(benchmark::State& state) {
+    const auto& src = floats(static_cast<std::size_t>(state.range(0)) / 2);
+    std::vector<float> dst(src.size());
+    for (auto _ : state) {
+        auto r = ilp::for_loop_range_store<N, Mode>(src, dst, [](float x, float& out, ilp::ForCtrl&) { out = x; });
+        benchmark::DoNotOptimize(r);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<ilp::StoreMode Mode>
+static void BM_Transform(benchmark::State& state) {
+    const auto& src = floats(static_cast<std::size_t>(state.range(0)) / 2);
+    std::vector<float> dst(src.size());
+    for (auto _ : state) {
+        auto r = ilp::for_loop_range_store<N, Mode>(src, dst,
+                                                    [](float x, float& out, ilp::ForCtrl&) { out = x * 2.0f + 1.0f; });
+        benchmark::DoNotOptimize(r);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+using ilp::StoreMode;
+
+// 16 KiB to 1 GiB of data touched per pass (source plus destination)
+#define ILP_BENCH_SIZES ->RangeMultiplier(8)->Range(16 << 10, 1 << 30)->Unit(benchmark::kMicrosecond)
+
+BENCHMARK(BM_Copy<StoreMode::Cached>)->Name("BM_Copy<Cached>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Copy<StoreMode::Streaming>)->Name("BM_Copy<Streaming>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Copy<StoreMode::Auto>)->Name("BM_Copy<Auto>") ILP_BENCH_SIZES;
+
+BENCHMARK(BM_Transform<StoreMode::Cached>)->Name("BM_Transform<Cached>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Transform<StoreMode::Streaming>)->Name("BM_Transform<Streaming>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Transform<StoreMode::Auto>)->Name("BM_Transform<Auto>") ILP_BENCH_SIZES;
+
+BENCHMARK_MAIN();
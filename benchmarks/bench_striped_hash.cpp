@@ -0,0 +1,80 @@
+#include "ilp_for/kernels/striped_hash.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== STRIPED HASH: one state chain vs N lanes ====================
+// Pattern: hash / checksum a buffer, by input size.
+// Lanes<1> is the usual single-state loop (a multiply or crc32 per word, each waiting for the
+// previous). Lanes<N> keeps N states in flight. CrcTable is the single-chain slicing-by-8 fallback.
+
+static const std::vector<uint8_t>& data() {
+    static const std::vector<uint8_t> buf = [] {
+        std::mt19937 rng(BENCH_SEED);
+        std::vector<uint8_t> v(size_t{1} << 20);
+        for (auto& b : v)
+            b = static_cast<uint8_t>(rng());
+        return v;
+    }();
+    return buf;
+}
+
+template<typename Algo, size_t N>
+NOINLINE static uint64_t hash_lanes(const uint8_t* p, size_t len) {
+    return ilp::striped_hash<Algo, N>::hash(p, len);
+}
+
+NOINLINE static uint32_t crc_table(const uint8_t* p, size_t len) {
+    uint32_t crc = ~0u;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        crc = ilp::detail::crc32c_word_table(crc, ilp::swar::load_le(p + i));
+    for (; i < len; ++i)
+        crc = (crc >> 8) ^ ilp::detail::crc32c_tables[0][(crc ^ p[i]) & 0xFF];
+    return ~crc;
+}
+
+template<typename Algo, size_t N>
+static void BM_Hash(benchmark::State& state) {
+    const size_t len = static_cast<size_t>(state.range(0));
+    const uint8_t* p = data().data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash_lanes<Algo, N>(p, len));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * len));
+}
+
+static void BM_CrcTable(benchmark::State& state) {
+    const size_t len = static_cast<size_t>(state.range(0));
+    const uint8_t* p = data().data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc_table(p, len));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * len));
+}
+
+// Arg: input bytes
+#define SIZES ->Arg(64)->Arg(1 << 10)->Arg(16 << 10)->Arg(1 << 20)
+
+BENCHMARK(BM_Hash<ilp::hash::fnv1a, 1>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::fnv1a, 4>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::fnv1a, 8>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::xxh64, 1>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::xxh64, 4>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::xxh64, 8>) SIZES;
+BENCHMARK(BM_CrcTable) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::crc32c, 1>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::crc32c, 3>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::crc32c, 4>) SIZES;
+BENCHMARK(BM_Hash<ilp::hash::crc32c, 8>) SIZES;
+
+BENCHMARK_MAIN();
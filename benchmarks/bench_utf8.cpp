@@ -0,0 +1,126 @@
+#include "ilp_for/kernels/utf8.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== UTF-8 VALIDATION: one DFA chain vs N interleaved segments ====================
+// Pattern: validate a 4 MB buffer.
+// Scalar: the same shift DFA, one byte per step, no ASCII skipping.
+// Lanes<N>: utf8_validate<N> - N segments stepped in lock-step plus the all-ASCII block skip.
+// Lanes<1> is the single chain with the 8-byte ASCII skip, to separate the two effects.
+
+// Arg: 0 = English-like (about 2% non-ASCII), 1 = mixed (about 50%), 2 = CJK (all 3-byte), 3 = pure ASCII
+static std::string make_text(int mix, size_t bytes) {
+    std::mt19937 rng(BENCH_SEED);
+    std::string s;
+    s.reserve(bytes + 4);
+    while (s.size() < bytes) {
+        const unsigned r = static_cast<unsigned>(rng() % 100);
+        const bool wide = mix == 2 || (mix == 1 ? r < 50 : mix == 0 && r < 2);
+        if (!wide) {
+            s += static_cast<char>(' ' + rng() % 95);
+        } else if (mix == 2 || r % 2) {
+            const uint32_t cp = 0x4E00 + static_cast<uint32_t>(rng() % 0x5000);
+            s += static_cast<char>(0xE0 | (cp >> 12));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            const uint32_t cp = 0xC0 + static_cast<uint32_t>(rng() % 0x100);
+            s += static_cast<char>(0xC0 | (cp >> 6));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    return s;
+}
+
+NOINLINE static size_t validate_scalar(std::string_view text) {
+    const auto* p = reinterpret_cast<const uint8_t*>(text.data());
+    unsigned state = ilp::detail::utf8_accept;
+    for (size_t i = 0; i < text.size(); ++i) {
+        state = ilp::detail::utf8_step(state, p[i]);
+        if (state == ilp::detail::utf8_reject)
+            return ilp::detail::utf8_first_error(p, 0, text.size());
+    }
+    return state == ilp::detail::utf8_accept ? text.size() : ilp::detail::utf8_first_error(p, 0, text.size());
+}
+
+template<size_t N>
+NOINLINE static size_t validate_lanes(std::string_view text) {
+    return ilp::utf8_validate<N>(text);
+}
+
+NOINLINE static size_t count_scalar(std::string_view text) {
+    size_t n = 0;
+    for (unsigned char c : text)
+        n += (c & 0xC0) != 0x80;
+    return n;
+}
+
+class Utf8 : public benchmark::Fixture {
+  public:
+    std::string text;
+
+    void SetUp(const benchmark::State& state) override { text = make_text(static_cast<int>(state.range(0)), 4 << 20); }
+    void TearDown(const benchmark::State&) override { text = {}; }
+};
+
+BENCHMARK_DEFINE_F(Utf8, Scalar)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate_scalar(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(Utf8, Lanes1)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate_lanes<1>(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(Utf8, Lanes4)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate_lanes<4>(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(Utf8, Lanes8)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate_lanes<8>(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(Utf8, CountScalar)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count_scalar(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(Utf8, Count)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ilp::utf8_count(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_REGISTER_F(Utf8, Scalar)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK_REGISTER_F(Utf8, Lanes1)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK_REGISTER_F(Utf8, Lanes4)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK_REGISTER_F(Utf8, Lanes8)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK_REGISTER_F(Utf8, CountScalar)->Arg(1);
+BENCHMARK_REGISTER_F(Utf8, Count)->Arg(1);
+
+BENCHMARK_MAIN();
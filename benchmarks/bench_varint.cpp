@@ -0,0 +1,127 @@
+#include "ilp_for.hpp"
+#include "ilp_for/kernels/varint.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== VARINT DECODE: byte chain vs speculative lanes ====================
+// Pattern: sum a protobuf-style stream of LEB128 varints.
+// Scalar: the classic byte loop; each varint's length gates the next varint's first load.
+// VarStep: the same decoder driven by ILP_FOR_VARSTEP (still one serial position chain).
+// Lanes: for_each_varint<N> finds all boundaries of a 64-byte block from the continuation
+// bits, then decodes N varints at a time with no dependency between them.
+
+// Arg: mix. 0 = field tags and small ints (mostly 1 byte), 1 = protobuf-like (1-5 bytes,
+// some 10-byte negatives), 2 = uniform 64-bit (mostly 9-10 bytes)
+static std::vector<uint8_t> make_stream(int mix, size_t count) {
+    std::mt19937_64 rng(BENCH_SEED);
+    std::vector<uint8_t> buf(count * ilp::varint::max_bytes);
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v;
+        if (mix == 0)
+            v = rng() % 8 == 0 ? rng() % 16384 : rng() % 128;
+        else if (mix == 1)
+            v = rng() % 32 == 0 ? static_cast<uint64_t>(-static_cast<int64_t>(rng() % 1000))
+                                : rng() >> (64 - (1 + rng() % 32));
+        else
+            v = rng();
+        n += ilp::varint::encode(v, buf.data() + n);
+    }
+    buf.resize(n);
+    return buf;
+}
+
+NOINLINE static uint64_t sum_scalar(const std::vector<uint8_t>& buf) {
+    uint64_t sum = 0;
+    const uint8_t* p = buf.data();
+    const uint8_t* end = p + buf.size();
+    while (p < end) {
+        uint64_t v = 0;
+        unsigned shift = 0;
+        uint8_t b;
+        do {
+            b = *p++;
+            v |= uint64_t{b & 0x7Fu} << shift;
+            shift += 7;
+        } while (b & 0x80);
+        sum += v;
+    }
+    return sum;
+}
+
+NOINLINE static uint64_t sum_varstep(const std::vector<uint8_t>& buf) {
+    uint64_t sum = 0;
+    ILP_FOR_VARSTEP(auto i, size_t{0}, buf.size(), 4) {
+        uint64_t v = 0;
+        ILP_STEP(ilp::varint::decode_scalar(buf.data() + i, buf.size() - i, v));
+        sum += v;
+    }
+    ILP_END;
+    return sum;
+}
+
+template<size_t N>
+NOINLINE static uint64_t sum_lanes(const std::vector<uint8_t>& buf) {
+    uint64_t sum = 0;
+    ilp::for_each_varint<N>(buf, [&](uint64_t v) { sum += v; });
+    return sum;
+}
+
+class Varint : public benchmark::Fixture {
+  public:
+    std::vector<uint8_t> buf;
+    size_t count = size_t{1} << 20;
+
+    void SetUp(const benchmark::State& state) override { buf = make_stream(static_cast<int>(state.range(0)), count); }
+    void TearDown(const benchmark::State&) override { buf = {}; }
+
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buf.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+};
+
+BENCHMARK_DEFINE_F(Varint, Scalar)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_scalar(buf));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(Varint, VarStep)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_varstep(buf));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(Varint, Lanes4)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_lanes<4>(buf));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(Varint, Lanes8)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_lanes<8>(buf));
+    }
+    report(state);
+}
+
+BENCHMARK_REGISTER_F(Varint, Scalar)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_REGISTER_F(Varint, VarStep)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_REGISTER_F(Varint, Lanes4)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_REGISTER_F(Varint, Lanes8)->Arg(0)->Arg(1)->Arg(2);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#include "ilp_for.hpp"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+constexpr unsigned BENCH_SEED = 42;
+
+// ==================== Working set: cache-resident vs streaming N ====================
+// Pattern: the same Sum and Transform loops swept from L1-sized to well past the last-level
+// cache. Built without vectorization (see CMakeLists.txt) so a lane is one scalar chain. While
+// the data fits in cache the profile's N wins; past the LLC every N waits on DRAM and the
+// streaming N (cpu::streaming) runs as fast with fewer chains. The _Auto rows make the
+// dispatch ILP_FOR_RANGE_AUTO makes, switching at ilp::detail::streaming_bytes(), and should
+// track the better one at every size. Built with -DILP_DETECT_CACHES so the switch sits at
+// the host's LLC.
+
+static const std::vector<float>& floats(std::size_t bytes) {
+    static std::vector<float> buf;
+    const std::size_t n = bytes / sizeof(float);
+    if (buf.size() != n) {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        buf.resize(n);
+        for (auto& x : buf)
+            x = dist(rng);
+    }
+    return buf;
+}
+
+template<size_t N>
+NOINLINE static float sum(const float* p, size_t n) {
+    std::array<float, N> acc{};
+    size_t i = 0;
+    for (; i + N <= n; i += N)
+        for (size_t l = 0; l < N; ++l)
+            acc[l] += p[i + l];
+    float s = 0.0f;
+    for (size_t l = 0; l < N; ++l)
+        s += acc[l];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template<size_t N>
+NOINLINE static void scale(float* dst, const float* src, size_t n) {
+    ILP_FOR(auto i, size_t{0}, n, N) {
+        dst[i] = src[i] * 2.0f;
+    }
+    ILP_END;
+}
+
+template<size_t N>
+static void BM_Sum(benchmark::State& state) {
+    const auto& v = floats(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum<N>(v.data(), v.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_Sum_Auto(benchmark::State& state) {
+    const auto& v = floats(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ilp::detail::with_range_auto_N<float, ilp::LoopType::Sum>(
+            v, [&](auto n) { return sum<decltype(n)::value>(v.data(), v.size()); }));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<size_t N>
+static void BM_Transform(benchmark::State& state) {
+    const auto& src = floats(static_cast<std::size_t>(state.range(0)) / 2);
+    std::vector<float> dst(src.size());
+    for (auto _ : state) {
+        scale<N>(dst.data(), src.data(), src.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_Transform_Auto(benchmark::State& state) {
+    const auto& src = floats(static_cast<std::size_t>(state.range(0)) / 2);
+    std::vector<float> dst(src.size());
+    for (auto _ : state) {
+        ilp::detail::with_range_auto_N<float, ilp::LoopType::Transform>(
+            src, [&](auto n) { scale<decltype(n)::value>(dst.data(), src.data(), src.size()); });
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+using ilp::LoopType;
+using ilp::detail::streaming_N_for;
+
+// 16 KiB to 1 GiB of data touched per pass (source plus destination for Transform)
+#define ILP_BENCH_SIZES ->RangeMultiplier(8)->Range(16 << 10, 1 << 30)->Unit(benchmark::kMicrosecond)
+
+BENCHMARK(BM_Sum<ilp::optimal_N_for<float, LoopType::Sum>>)->Name("BM_Sum<cache N>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Sum<streaming_N_for<float, LoopType::Sum>>)->Name("BM_Sum<streaming N>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Sum_Auto) ILP_BENCH_SIZES;
+BENCHMARK(BM_Sum<1>) ILP_BENCH_SIZES;
+
+BENCHMARK(BM_Transform<ilp::optimal_N_for<float, LoopType::Transform>>)
+    ->Name("BM_Transform<cache N>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Transform<streaming_N_for<float, LoopType::Transform>>)
+    ->Name("BM_Transform<streaming N>") ILP_BENCH_SIZES;
+BENCHMARK(BM_Transform_Auto) ILP_BENCH_SIZES;
+BENCHMARK(BM_Transform<1>) ILP_BENCH_SIZES;
+
+BENCHMARK_MAIN();
@@ -23,7 +23,52 @@ namespace ilp::detail {
 #include "ilp_for/cpu_profiles/ilp_cpu.hpp"
 
 #include "ilp_for/detail/iota.hpp"
+#include "ilp_for/detail/loops_async.hpp"
+#include "ilp_for/detail/loops_coro.hpp"
 #include "ilp_for/detail/loops_ilp.hpp"
+#include "ilp_for/detail/loops_store.hpp"
+#include "ilp_for/detail/loops_varstep.hpp"
+#include "ilp_for/detail/loops_yield.hpp"
+
+// Qualifies the loop type names of the _MIX_AUTO macros: (Search, Sum) -> ::ilp::loop_types::Search, ...
+// The extra ILP_DETAIL_EXPAND keeps MSVC's traditional preprocessor from passing __VA_ARGS__ as one argument.
+#define ILP_DETAIL_EXPAND(x) x
+#define ILP_DETAIL_LOOP_TYPES_1(a) ::ilp::loop_types::a
+#define ILP_DETAIL_LOOP_TYPES_2(a, b) ::ilp::loop_types::a, ::ilp::loop_types::b
+#define ILP_DETAIL_LOOP_TYPES_3(a, b, c) ::ilp::loop_types::a, ::ilp::loop_types::b, ::ilp::loop_types::c
+#define ILP_DETAIL_LOOP_TYPES_4(a, b, c, d)                                                                            \
+    ::ilp::loop_types::a, ::ilp::loop_types::b, ::ilp::loop_types::c, ::ilp::loop_types::d
+#define ILP_DETAIL_PICK_5(_1, _2, _3, _4, name, ...) name
+#define ILP_DETAIL_LOOP_TYPES(...)                                                                                     \
+    ILP_DETAIL_EXPAND(ILP_DETAIL_PICK_5(__VA_ARGS__, ILP_DETAIL_LOOP_TYPES_4, ILP_DETAIL_LOOP_TYPES_3,                 \
+                                        ILP_DETAIL_LOOP_TYPES_2, ILP_DETAIL_LOOP_TYPES_1, )(__VA_ARGS__))
+
+// ILP_FOR_SOA's declaration list, (auto price, auto qty), as lambda parameters and as the
+// simple mode's per-column initializers. Up to six columns.
+#define ILP_DETAIL_SOA_PARAMS_1(a) [[maybe_unused]] a
+#define ILP_DETAIL_SOA_PARAMS_2(a, b) ILP_DETAIL_SOA_PARAMS_1(a), [[maybe_unused]] b
+#define ILP_DETAIL_SOA_PARAMS_3(a, b, c) ILP_DETAIL_SOA_PARAMS_2(a, b), [[maybe_unused]] c
+#define ILP_DETAIL_SOA_PARAMS_4(a, b, c, d) ILP_DETAIL_SOA_PARAMS_3(a, b, c), [[maybe_unused]] d
+#define ILP_DETAIL_SOA_PARAMS_5(a, b, c, d, e) ILP_DETAIL_SOA_PARAMS_4(a, b, c, d), [[maybe_unused]] e
+#define ILP_DETAIL_SOA_PARAMS_6(a, b, c, d, e, f) ILP_DETAIL_SOA_PARAMS_5(a, b, c, d, e), [[maybe_unused]] f
+#define ILP_DETAIL_SOA_BIND_1(k, a)                                                                                    \
+    if ([[maybe_unused]] a = __ilp_cursor.template get<k>(); false) {                                                  \
+    } else
+#define ILP_DETAIL_SOA_BIND_2(a, b) ILP_DETAIL_SOA_BIND_1(0, a) ILP_DETAIL_SOA_BIND_1(1, b)
+#define ILP_DETAIL_SOA_BIND_3(a, b, c) ILP_DETAIL_SOA_BIND_2(a, b) ILP_DETAIL_SOA_BIND_1(2, c)
+#define ILP_DETAIL_SOA_BIND_4(a, b, c, d) ILP_DETAIL_SOA_BIND_3(a, b, c) ILP_DETAIL_SOA_BIND_1(3, d)
+#define ILP_DETAIL_SOA_BIND_5(a, b, c, d, e) ILP_DETAIL_SOA_BIND_4(a, b, c, d) ILP_DETAIL_SOA_BIND_1(4, e)
+#define ILP_DETAIL_SOA_BIND_6(a, b, c, d, e, f) ILP_DETAIL_SOA_BIND_5(a, b, c, d, e) ILP_DETAIL_SOA_BIND_1(5, f)
+#define ILP_DETAIL_PICK_7(_1, _2, _3, _4, _5, _6, name, ...) name
+#define ILP_DETAIL_SOA_PARAMS(...)                                                                                     \
+    ILP_DETAIL_EXPAND(ILP_DETAIL_PICK_7(__VA_ARGS__, ILP_DETAIL_SOA_PARAMS_6, ILP_DETAIL_SOA_PARAMS_5,                 \
+                                        ILP_DETAIL_SOA_PARAMS_4, ILP_DETAIL_SOA_PARAMS_3, ILP_DETAIL_SOA_PARAMS_2,     \
+                                        ILP_DETAIL_SOA_PARAMS_1, )(__VA_ARGS__))
+#define ILP_DETAIL_SOA_BIND(...)                                                                                       \
+    ILP_DETAIL_EXPAND(ILP_DETAIL_PICK_7(__VA_ARGS__, ILP_DETAIL_SOA_BIND_6, ILP_DETAIL_SOA_BIND_5,                     \
+                                        ILP_DETAIL_SOA_BIND_4, ILP_DETAIL_SOA_BIND_3, ILP_DETAIL_SOA_BIND_2,           \
+                                        ILP_DETAIL_SOA_BIND_1_0, )(__VA_ARGS__))
+#define ILP_DETAIL_SOA_BIND_1_0(a) ILP_DETAIL_SOA_BIND_1(0, a)
 
 #ifdef ILP_MODE_SIMPLE
 
@@ -61,13 +106,27 @@ namespace ilp::detail {
 #define ILP_FOR_AUTO(loop_var_decl, start, end, loop_type, element_type)                                               \
     if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
         [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
-        return ::ilp::for_loop_auto<element_type, ::ilp::LoopType::loop_type>(start, end, \
+        return ::ilp::for_loop_auto<element_type, ::ilp::loop_types::loop_type>(start, end, \
             [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
 
 #define ILP_FOR_RANGE_AUTO(loop_var_decl, range, loop_type, element_type)                                              \
     if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
         [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
-        return ::ilp::for_loop_range_auto<element_type, ::ilp::LoopType::loop_type>(range, \
+        return ::ilp::for_loop_range_auto<element_type, ::ilp::loop_types::loop_type>(range, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
+
+// Body mixing several operation classes: ILP_FOR_MIX_AUTO(auto i, 0, n, float, Search, Sum)
+// N comes from optimal_N_for<element_type, ...>; up to four LoopTypes.
+#define ILP_FOR_MIX_AUTO(loop_var_decl, start, end, element_type, ...)                                                 \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_auto<element_type, ILP_DETAIL_LOOP_TYPES(__VA_ARGS__)>(start, end, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
+
+#define ILP_FOR_RANGE_MIX_AUTO(loop_var_decl, range, element_type, ...)                                                \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_range_auto<element_type, ILP_DETAIL_LOOP_TYPES(__VA_ARGS__)>(range, \
             [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
 
 #define ILP_FOR_T(type, loop_var_decl, start, end, N)                                                                  \
@@ -85,15 +144,77 @@ namespace ilp::detail {
 #define ILP_FOR_T_AUTO(ret_type, loop_var_decl, start, end, loop_type, element_type)                                   \
     if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResultTyped<ret_type> { \
         [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
-        return ::ilp::for_loop_typed_auto<element_type, ret_type, ::ilp::LoopType::loop_type>(start, end, \
+        return ::ilp::for_loop_typed_auto<element_type, ret_type, ::ilp::loop_types::loop_type>(start, end, \
             [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrlTyped<ret_type>& __ilp_ctrl)
 
 #define ILP_FOR_RANGE_T_AUTO(ret_type, loop_var_decl, range, loop_type, element_type)                                  \
     if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResultTyped<ret_type> { \
         [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
-        return ::ilp::for_loop_range_typed_auto<element_type, ret_type, ::ilp::LoopType::loop_type>(range, \
+        return ::ilp::for_loop_range_typed_auto<element_type, ret_type, ::ilp::loop_types::loop_type>(range, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrlTyped<ret_type>& __ilp_ctrl)
+
+#define ILP_FOR_T_MIX_AUTO(ret_type, loop_var_decl, start, end, element_type, ...)                                     \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResultTyped<ret_type> { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_typed_auto<element_type, ret_type, ILP_DETAIL_LOOP_TYPES(__VA_ARGS__)>(start, end, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrlTyped<ret_type>& __ilp_ctrl)
+
+#define ILP_FOR_RANGE_T_MIX_AUTO(ret_type, loop_var_decl, range, element_type, ...)                                    \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResultTyped<ret_type> { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_range_typed_auto<element_type, ret_type, ILP_DETAIL_LOOP_TYPES(__VA_ARGS__)>(range, \
             [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrlTyped<ret_type>& __ilp_ctrl)
 
+// One output element per input: the body fills out_decl (a reference, e.g. auto& out) and the
+// driver stores it to dst, with non-temporal stores once the output outgrows the LLC.
+// ILP_FOR_RANGE_STORE(auto x, auto& out, src, dst, 8) { out = x * 2; } ILP_END;
+#define ILP_FOR_RANGE_STORE(in_decl, out_decl, src, dst, N)                                                            \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_range_store<N>(src, dst, \
+            [&]([[maybe_unused]] in_decl, [[maybe_unused]] out_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
+
+#define ILP_FOR_RANGE_STORE_AUTO(in_decl, out_decl, src, dst, loop_type, element_type)                                 \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_range_store_auto<element_type, ::ilp::loop_types::loop_type>(src, dst, \
+            [&]([[maybe_unused]] in_decl, [[maybe_unused]] out_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
+
+// Columns of an ilp::soa_vector (#include <ilp_for/memory/soa_vector.hpp>) picked by the names
+// declared: ILP_FOR_SOA((auto price, auto qty), orders, 8) { ... } ILP_END;
+#define ILP_FOR_SOA(decls, soa, N)                                                                                     \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_soa<N, ::ilp::detail::fixed_string{#decls}>(soa, \
+            [&](ILP_DETAIL_SOA_PARAMS decls, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl)
+
+// Data-dependent stride: the body sets how far to advance with ILP_STEP(n) (default 1).
+#define ILP_FOR_VARSTEP(loop_var_decl, start, end, N)                                                                  \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_varstep<N>(start, end, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::VarStepCtrl& __ilp_ctrl)
+
+// Coroutine body: suspends at each ILP_CO_PREFETCH so G iterations' loads overlap.
+// The body must use the ILP_CO_* control macros (plain return is not allowed in a coroutine).
+#define ILP_FOR_CORO(loop_var_decl, start, end, G)                                                                     \
+    if ([[maybe_unused]] auto __ilp_ret = [&]() -> ::ilp::ForResult { \
+        [[maybe_unused]] auto __ilp_ctx = ::ilp::detail::For_Context_USE_ILP_END{}; \
+        return ::ilp::for_loop_coro<G>(start, end, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl) -> ::ilp::CoroTask
+
+// Async body, used inside a coroutine: up to N bodies await concurrently, one block at a time.
+// Close with ILP_END_ASYNC / ILP_END_ASYNC_RETURN; the body uses the ILP_ASYNC_* control macros.
+#define ILP_FOR_ASYNC(loop_var_decl, start, end, N)                                                                    \
+    if ([[maybe_unused]] auto __ilp_ret = co_await ::ilp::for_loop_async<N>(start, end, \
+            [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::ForCtrl& __ilp_ctrl) -> ::ilp::AsyncBody
+
+// Lazy generator expression: auto gen = ILP_FOR_YIELD(int, auto i, 0, n, 4) { ... } ILP_END_YIELD;
+// The body captures by reference, so the generator must not outlive the enclosing scope.
+#define ILP_FOR_YIELD(value_type, loop_var_decl, start, end, N)                                                        \
+    ::ilp::generate<value_type, N>(start, end,                                                                         \
+                                   [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::YieldCtrl<value_type>& __ilp_ctrl)
+
 // IMPORTANT: if ILP_RETURN is used, you MUST use ILP_END_RETURN instead!
 #define ILP_END );                                                                                                     \
     }                                                                                                                  \
@@ -107,6 +228,14 @@ namespace ilp::detail {
     return *std::move(__ilp_ret);                                                                                      \
     else(void) 0
 
+#define ILP_END_ASYNC );                                                                                               \
+    __ilp_ret.has_return ? (::ilp::detail::ilp_end_with_return_error(), false) : false) {}                             \
+    else(void) 0
+
+#define ILP_END_ASYNC_RETURN ); __ilp_ret) \
+    co_return *std::move(__ilp_ret);                                                                                   \
+    else(void) 0
+
 // ILP_CONTINUE returns from the loop body lambda (skips to next iteration).
 // Note: In ILP_MODE_SIMPLE this maps to 'continue', but here it's 'return' from lambda.
 // The do-while(0) wrapper ensures proper statement semantics in all contexts.
@@ -129,4 +258,43 @@ namespace ilp::detail {
         return;                                                                                                        \
     } while (0)
 
+#define ILP_CO_PREFETCH(ptr) co_await ::ilp::prefetch(ptr)
+
+#define ILP_CO_CONTINUE                                                                                                \
+    do {                                                                                                               \
+        co_return;                                                                                                     \
+    } while (0)
+
+#define ILP_CO_BREAK                                                                                                   \
+    do {                                                                                                               \
+        __ilp_ctrl.ok = false;                                                                                         \
+        co_return;                                                                                                     \
+    } while (0)
+
+#define ILP_CO_RETURN(x)                                                                                               \
+    do {                                                                                                               \
+        __ilp_ctrl.storage.set(x);                                                                                     \
+        __ilp_ctrl.return_set = true;                                                                                  \
+        __ilp_ctrl.ok = false;                                                                                         \
+        co_return;                                                                                                     \
+    } while (0)
+
+#define ILP_ASYNC_CONTINUE ILP_CO_CONTINUE
+#define ILP_ASYNC_BREAK ILP_CO_BREAK
+#define ILP_ASYNC_RETURN(x) ILP_CO_RETURN(x)
+
 #endif // !ILP_MODE_SIMPLE
+
+// Variable stride (same in all modes - SIMPLE mode reads it from the loop cursor)
+#define ILP_STEP(n) (__ilp_ctrl.step = static_cast<std::size_t>(n))
+
+// Generator control (same in all modes - the body is always a lambda)
+#define ILP_END_YIELD )
+
+#define ILP_YIELD(x) __ilp_ctrl.yield(x)
+
+#define ILP_YIELD_BREAK                                                                                                \
+    do {                                                                                                               \
+        __ilp_ctrl.ok = false;                                                                                         \
+        return;                                                                                                        \
+    } while (0)
@@ -6,28 +6,84 @@
 #pragma once
 
 // Single header for CPU profile selection
-// Define ILP_CPU_SKYLAKE, ILP_CPU_ALDERLAKE, ILP_CPU_ZEN5, ILP_CPU_APPLE_M1
-// before including this header. Default is conservative cross-platform values.
+// Define ILP_CPU_SKYLAKE, ILP_CPU_ALDERLAKE, ILP_CPU_GRACEMONT, ILP_CPU_ICELAKE, ILP_CPU_SAPPHIRERAPIDS,
+// ILP_CPU_ZEN4, ILP_CPU_ZEN5, ILP_CPU_APPLE_M1, ILP_CPU_NEOVERSE_V1, ILP_CPU_NEOVERSE_V2 or
+// ILP_CPU_NEOVERSE_N2 before including this header. Without one, the CPU named by -march is used if
+// there is a profile for it, otherwise conservative cross-platform values (force those with
+// ILP_CPU_DEFAULT).
 
 #include "ilp_cpu_profiles.hpp"
 
 // Select profile based on preprocessor define
 // Supports both uppercase (ILP_CPU_SKYLAKE) and lowercase (ILP_CPU_skylake)
 #if defined(ILP_CPU_SKYLAKE) || defined(ILP_CPU_skylake)
-#define ILP_CPU_PROFILE ilp::cpu::skylake
+#define ILP_CPU_BASE_PROFILE ilp::cpu::skylake
 #elif defined(ILP_CPU_ALDERLAKE) || defined(ILP_CPU_alderlake)
-#define ILP_CPU_PROFILE ilp::cpu::alderlake
-#elif defined(ILP_CPU_ZEN5) || defined(ILP_CPU_zen5) || defined(ILP_CPU_ZEN4) || defined(ILP_CPU_zen4) ||              \
-    defined(ILP_CPU_ZEN) || defined(ILP_CPU_zen)
-#define ILP_CPU_PROFILE ilp::cpu::zen5
+#define ILP_CPU_BASE_PROFILE ilp::cpu::alderlake
+#elif defined(ILP_CPU_GRACEMONT) || defined(ILP_CPU_gracemont)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::gracemont
+#elif defined(ILP_CPU_ICELAKE) || defined(ILP_CPU_icelake)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::icelake
+#elif defined(ILP_CPU_SAPPHIRERAPIDS) || defined(ILP_CPU_sapphirerapids) || defined(ILP_CPU_SPR) || defined(ILP_CPU_spr)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::sapphirerapids
+#elif defined(ILP_CPU_ZEN4) || defined(ILP_CPU_zen4)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::zen4
+#elif defined(ILP_CPU_ZEN5) || defined(ILP_CPU_zen5) || defined(ILP_CPU_ZEN) || defined(ILP_CPU_zen)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::zen5
 #elif defined(ILP_CPU_APPLE_M1) || defined(ILP_CPU_apple_m1) || defined(ILP_CPU_M1) || defined(ILP_CPU_m1)
-#define ILP_CPU_PROFILE ilp::cpu::apple_m1
+#define ILP_CPU_BASE_PROFILE ilp::cpu::apple_m1
+#elif defined(ILP_CPU_NEOVERSE_V1) || defined(ILP_CPU_neoverse_v1) || defined(ILP_CPU_GRAVITON3) ||                    \
+    defined(ILP_CPU_graviton3)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::neoverse_v1
+#elif defined(ILP_CPU_NEOVERSE_V2) || defined(ILP_CPU_neoverse_v2) || defined(ILP_CPU_GRAVITON4) ||                    \
+    defined(ILP_CPU_graviton4)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::neoverse_v2
+#elif defined(ILP_CPU_NEOVERSE_N2) || defined(ILP_CPU_neoverse_n2)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::neoverse_n2
 #elif defined(ILP_CPU_DEFAULT) || defined(ILP_CPU_default)
-#define ILP_CPU_PROFILE ilp::cpu::default_profile
+#define ILP_CPU_BASE_PROFILE ilp::cpu::default_profile
+// No CPU named: follow -march where the compiler says which part it targets
+#elif defined(__sapphirerapids__) || defined(__emeraldrapids__) || defined(__graniterapids__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::sapphirerapids
+#elif defined(__icelake_server__) || defined(__icelake_client__) || defined(__tigerlake__) || defined(__rocketlake__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::icelake
+#elif defined(__alderlake__) || defined(__raptorlake__) || defined(__meteorlake__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::alderlake
+#elif defined(__skylake__) || defined(__skylake_avx512__) || defined(__cascadelake__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::skylake
+#elif defined(__znver4__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::zen4
+#elif defined(__znver5__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::zen5
+#elif defined(__APPLE__) && defined(__aarch64__)
+#define ILP_CPU_BASE_PROFILE ilp::cpu::apple_m1
 #else
-#define ILP_CPU_PROFILE ilp::cpu::default_profile
+#define ILP_CPU_BASE_PROFILE ilp::cpu::default_profile
 #endif
 
+// Vector ISA the code is compiled for; override with e.g. -DILP_VECTOR_ISA=AVX2
+#ifndef ILP_VECTOR_ISA
+#if defined(__AVX512F__)
+#define ILP_VECTOR_ISA AVX512
+#elif defined(__AVX2__)
+#define ILP_VECTOR_ISA AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#define ILP_VECTOR_ISA SSE
+#elif defined(__ARM_FEATURE_SVE)
+#define ILP_VECTOR_ISA SVE
+#elif defined(__ARM_NEON)
+#define ILP_VECTOR_ISA NEON
+#else
+#define ILP_VECTOR_ISA Scalar
+#endif
+#endif
+
+// The profile optimal_N reads: the CPU's variant for the vector width in use, if it has one
+#define ILP_CPU_PROFILE ilp::cpu::for_isa(ILP_CPU_BASE_PROFILE, ilp::cpu::VectorISA::ILP_VECTOR_ISA)
+
+// The active profile's fields by name; optimal_N reads the profile itself so that it can also
+// be computed for another one (optimal_N_on)
+
 // Sum
 #define ILP_N_SUM_1 ILP_CPU_PROFILE.sum_1
 #define ILP_N_SUM_2 ILP_CPU_PROFILE.sum_2
@@ -92,5 +148,46 @@
 #define ILP_N_SHIFT_4 ILP_CPU_PROFILE.shift_4
 #define ILP_N_SHIFT_8 ILP_CPU_PROFILE.shift_8
 
+// Gather
+#define ILP_N_GATHER_4 ILP_CPU_PROFILE.gather_4
+#define ILP_N_GATHER_8 ILP_CPU_PROFILE.gather_8
+
+// Popcount
+#define ILP_N_POPCOUNT_4 ILP_CPU_PROFILE.popcount_4
+#define ILP_N_POPCOUNT_8 ILP_CPU_PROFILE.popcount_8
+
+// CompareExchange
+#define ILP_N_CMPXCHG_4 ILP_CPU_PROFILE.cmpxchg_4
+#define ILP_N_CMPXCHG_8 ILP_CPU_PROFILE.cmpxchg_8
+
+// Convert
+#define ILP_N_CONVERT_4 ILP_CPU_PROFILE.convert_4
+#define ILP_N_CONVERT_8 ILP_CPU_PROFILE.convert_8
+
+// Hash
+#define ILP_N_HASH_4 ILP_CPU_PROFILE.hash_4
+#define ILP_N_HASH_8 ILP_CPU_PROFILE.hash_8
+
+// Scan
+#define ILP_N_SCAN_4I ILP_CPU_PROFILE.scan_4i
+#define ILP_N_SCAN_8I ILP_CPU_PROFILE.scan_8i
+#define ILP_N_SCAN_4F ILP_CPU_PROFILE.scan_4f
+#define ILP_N_SCAN_8F ILP_CPU_PROFILE.scan_8f
+
+// Hybrid parts: with -DILP_HYBRID_CORES the _AUTO loops also instantiate the E-core N and
+// pick per call from the core the thread is on. With -DILP_SMT_AWARE they do the same for the
+// shared-core N when a sibling hyperthread competes for the ports (see ilp_topology.hpp).
+// -DILP_DETECT_CACHES sizes the working-set switch of the _AUTO range loops from the host's
+// caches instead of the profile's.
+#if defined(ILP_HYBRID_CORES) || defined(ILP_SMT_AWARE) || defined(ILP_DETECT_CACHES)
+#include "ilp_topology.hpp"
+#endif
+
+// Working set: the _AUTO range loops switch to the streaming profile (see cpu::streaming) for
+// a contiguous range larger than the last-level cache. -DILP_WORKING_SET_AWARE=0 turns it off.
+#ifndef ILP_WORKING_SET_AWARE
+#define ILP_WORKING_SET_AWARE 1
+#endif
+
 // Include the shared computation logic
 #include "ilp_optimal_n.hpp"
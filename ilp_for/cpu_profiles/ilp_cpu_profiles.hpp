@@ -7,12 +7,19 @@
 
 // Shared CPU profile data for both library and clang-tidy tool.
 // This is the single source of truth for N values.
+// The per-CPU blocks are generated from scripts/profiles/ by scripts/generate_profile.py:
+// edit the timing data there and run it with --write rather than editing the blocks by hand.
 
+#include <cstddef>
 #include <string_view>
 
 namespace ilp::cpu {
 
     struct Profile {
+        // The profile's get() name. for_isa and is_hybrid match on it: the addresses of
+        // two profiles don't compare in a constant expression under GCC's -fsanitize=undefined
+        std::string_view id;
+
         // Sum - Integer (VPADD*) and Floating Point (VADDPS/PD)
         int sum_1, sum_2, sum_4i, sum_8i, sum_4f, sum_8f;
 
@@ -45,37 +52,78 @@ namespace ilp::cpu {
 
         // Shift - VPSLL*/VPSRL*
         int shift_1, shift_2, shift_4, shift_8;
+
+        // Gather - indexed loads (VPGATHER*, one LDR per element on NEON)
+        int gather_4, gather_8;
+
+        // Popcount - VPOPCNT*/POPCNT/CNT
+        int popcount_4, popcount_8;
+
+        // CompareExchange - min + max pair of a sorting network
+        int cmpxchg_4, cmpxchg_8;
+
+        // Convert - integer to floating point (VCVTDQ2PS/PD, SCVTF)
+        int convert_4, convert_8;
+
+        // Hash - multiply + xorshift rounds (IMUL/MADD)
+        int hash_4, hash_8;
+
+        // Scan - prefix sum: add chain with a store per element
+        int scan_4i, scan_8i, scan_4f, scan_8f;
+
+        // Registers - architectural general-purpose and vector register counts
+        int gpr_registers, vector_registers;
+
+        // Caches - L1 data and L2 of one core and the last level, in KiB, of the part named in
+        // the block's comment; other SKUs of the family differ (see cpu::detect_cache_sizes)
+        int l1d_kib, l2_kib, llc_kib;
     };
 
     // Intel Skylake - Source: https://uops.info
     //
-    // +----------------+----------+---------+------+-------+
-    // | Instruction    | Use Case | Latency | RThr | L×TPC |
-    // +----------------+----------+---------+------+-------+
-    // | VFMADD231PS/PD | FMA      |    4    | 0.50 |   8   |
-    // | VADDPS/VADDPD  | FP Add   |    4    | 0.50 |   8   |
-    // | VPADDB/W/D/Q   | Int Add  |    1    | 0.33 |   3   |
-    // | VMULPS/VMULPD  | FP Mul   |    4    | 0.50 |   8   |
-    // | VPMULLD        | Int Mul  |   10    | 1.00 |  10   |
-    // | VDIVPS         | FP Div   |   11    | 3.00 |   4   |
-    // | VSQRTPS        | FP Sqrt  |   12    | 3.00 |   4   |
-    // | VMINPS/VMAXPS  | FP MinMax|    4    | 0.50 |   8   |
-    // | VPMINS*/VPMAXS*| Int MinMax|   1    | 0.33 |   3   |
-    // | VPAND/POR/PXOR | Bitwise  |    1    | 0.33 |   3   |
-    // | VPSLLW/VPSRLW  | Shift    |    1    | 0.50 |   2   |
-    // +----------------+----------+---------+------+-------+
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.33 |   3   |
+    // | VADDPS/PD      | FP Add     |    4    |  0.50 |   8   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  5.00 |   3   |
+    // | VDIVPD         | FP Div     |   13    |  8.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   12    |  6.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   15    |  9.00 |   2   |
+    // | VPMAXSB/W/D    | Int MinMax |    1    |  0.50 |   2   |
+    // | VPCMPGTQ       | Int MinMax |    3    |  1.00 |   3   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPAND          | Bitwise    |    1    |  0.33 |   3   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  0.50 |   2   |
+    // | VPGATHERDD     | Gather     |   22    |  5.00 |   5   |
+    // | VPGATHERQQ     | Gather     |   20    |  4.00 |   5   |
+    // | POPCNT         | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD        | Min+Max    |    1    |  1.00 |   2   |
+    // | VPCMPGTQ       | Min+Max    |    3    |  2.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  0.50 |   8   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  1.00 |   2   |
+    // | VADDPS/PD      | Add+Store  |    4    |  1.00 |   4   |
+    // +----------------+------------+---------+-------+-------+
     inline constexpr Profile skylake = {
-        // Sum - Integer: L=1, TPC=3 → 3; FP: L=4, TPC=2 → 8
+        .id = "skylake",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=3 → 3; VADDPS/PD: L=4, TPC=2 → 8
         .sum_1 = 3,
         .sum_2 = 3,
         .sum_4i = 3,
         .sum_8i = 3,
         .sum_4f = 8,
         .sum_8f = 8,
-        // DotProduct - FMA: L=4, TPC=2 → 8
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
         .dotproduct_4 = 8,
         .dotproduct_8 = 8,
-        // Search - compare + branch
+        // Search - CMP: L=1, TPC=4 → 4
         .search_1 = 4,
         .search_2 = 4,
         .search_4 = 4,
@@ -90,127 +138,214 @@ namespace ilp::cpu {
         .transform_2 = 4,
         .transform_4 = 4,
         .transform_8 = 4,
-        // Multiply - FP: L=4, TPC=2 → 8; Int32: L=10, TPC=1 → 10
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; IMUL: L=3, TPC=1 → 3
         .multiply_4f = 8,
         .multiply_8f = 8,
         .multiply_4i = 10,
-        .multiply_8i = 4,
-        // Divide - high latency: L=11, TPC=0.2 → 2
-        .divide_4f = 2,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.2 → 3; VDIVPD: L=13, TPC=0.12 → 2
+        .divide_4f = 3,
         .divide_8f = 2,
-        // Sqrt - high latency: L=12, TPC=0.17 → 2
+        // Sqrt - VSQRTPS: L=12, TPC=0.17 → 2; VSQRTPD: L=15, TPC=0.11 → 2
         .sqrt_4f = 2,
         .sqrt_8f = 2,
-        // MinMax - Int: L=1, TPC=2 → 2; FP: L=4, TPC=2 → 8
+        // MinMax - VPMAXSB/W/D: L=1, TPC=2 → 2; VPCMPGTQ: L=3, TPC=1 → 3; VMAXPS/PD: L=4, TPC=2 → 8
         .minmax_1 = 2,
         .minmax_2 = 2,
         .minmax_4i = 2,
-        .minmax_8i = 2,
+        .minmax_8i = 3,
         .minmax_4f = 8,
         .minmax_8f = 8,
-        // Bitwise - L=1, TPC=3 → 3
+        // Bitwise - VPAND: L=1, TPC=3 → 3
         .bitwise_1 = 3,
         .bitwise_2 = 3,
         .bitwise_4 = 3,
         .bitwise_8 = 3,
-        // Shift - L=1, TPC=2 → 2
+        // Shift - VPSLLW/D/Q: L=1, TPC=2 → 2
         .shift_1 = 2,
         .shift_2 = 2,
         .shift_4 = 2,
         .shift_8 = 2,
+        // Gather - VPGATHERDD: L=22, TPC=0.2 → 5; VPGATHERQQ: L=20, TPC=0.25 → 5
+        .gather_4 = 5,
+        .gather_8 = 5,
+        // Popcount - POPCNT: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD: L=1, TPC=1 → 2; VPCMPGTQ: L=3, TPC=0.5 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=2 → 8; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 8,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=1 → 2; VADDPS/PD: L=4, TPC=1 → 4
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 32 KiB, L2 256 KiB, LLC 8 MiB (Core i7-6700K)
+        .l1d_kib = 32,
+        .l2_kib = 256,
+        .llc_kib = 8192,
     };
 
     // Apple M1 (Firestorm P-cores) - Source: https://dougallj.github.io/applecpu/firestorm.html
     //
-    // +----------------+----------+---------+------+-------+
-    // | Instruction    | Use Case | Latency | RThr | L×TPC |
-    // +----------------+----------+---------+------+-------+
-    // | FMLA           | FMA      |    4    | 0.25 |  16   |
-    // | FADD           | FP Add   |    3    | 0.25 |  12   |
-    // | ADD (vec)      | Int Add  |    2    | 0.25 |   8   |
-    // | FCMP           | FP Cmp   |    2    | 0.33 |   6   |
-    // | CMP (vec)      | Int Cmp  |    1    | 0.25 |   4   |
-    // +----------------+----------+---------+------+-------+
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | ADD            | Int Add    |    2    |  0.25 |   8   |
+    // | FADD           | FP Add     |    3    |  0.25 |  12   |
+    // | FMLA           | FMA        |    4    |  0.25 |  16   |
+    // | FCMP           | Cmp+Branch |    2    |  0.33 |   6   |
+    // | FMUL           | FP Mul     |    3    |  0.25 |  12   |
+    // | SMAX/CMGT      | Int MinMax |    2    |  0.25 |   8   |
+    // | FMAX           | FP MinMax  |    3    |  0.25 |  12   |
+    // | AND            | Bitwise    |    2    |  0.25 |   8   |
+    // | SHL            | Shift      |    2    |  0.25 |   8   |
+    // | LDR            | Gather     |    4    |  0.33 |  13   |
+    // | CNT            | Popcount   |    2    |  0.25 |   8   |
+    // | SMAX/CMGT      | Min+Max    |    2    |  0.50 |   4   |
+    // | SCVTF          | Int→FP     |    3    |  0.25 |  12   |
+    // | MADD           | Mul+Xor    |    5    |  0.50 |  10   |
+    // | ADD            | Add+Store  |    2    |  0.50 |   4   |
+    // | FADD           | Add+Store  |    3    |  0.50 |   6   |
+    // +----------------+------------+---------+-------+-------+
     inline constexpr Profile apple_m1 = {
-        // Sum - Integer: L=2, TPC=4 → 8; FP: L=3, TPC=4 → 12
+        .id = "apple_m1",
+        // Sum - ADD: L=2, TPC=4 → 8; FADD: L=3, TPC=4 → 12
         .sum_1 = 8,
         .sum_2 = 8,
         .sum_4i = 8,
         .sum_8i = 8,
         .sum_4f = 12,
         .sum_8f = 12,
-        // DotProduct - FMA: L=4, TPC=4 → 16
+        // DotProduct - FMLA: L=4, TPC=4 → 16
         .dotproduct_4 = 16,
         .dotproduct_8 = 16,
-        // Search - FCMP: L=2, TPC=3 → 6; M1's excellent branch predictor allows higher N
+        // Search - FCMP: L=2, TPC=3 → 6
         .search_1 = 6,
         .search_2 = 6,
         .search_4 = 6,
         .search_8 = 6,
-        // Copy - 4 load/store units
+        // Copy - memory bandwidth limited; copy_2: 4 load/store units → 8
         .copy_1 = 8,
         .copy_2 = 8,
         .copy_4 = 4,
         .copy_8 = 4,
-        // Transform - excellent ILP with 4 FP pipes
+        // Transform - memory + compute balanced; transform_1: 4 FP pipes → 8
         .transform_1 = 8,
         .transform_2 = 4,
         .transform_4 = 4,
         .transform_8 = 4,
-        // Multiply - FMUL: L=3, TPC=4 → 12
+        // Multiply - FMUL: L=3, TPC=4 → 12; multiply_4i/8i: MUL: not in source table → 8
         .multiply_4f = 12,
         .multiply_8f = 12,
         .multiply_4i = 8,
         .multiply_8i = 8,
-        // Divide - FDIV: L≈10-14, limited throughput → 4
+        // Divide - FDIV: L≈10-14, limited throughput
         .divide_4f = 4,
         .divide_8f = 4,
         // Sqrt - FSQRT: similar to FDIV
         .sqrt_4f = 4,
         .sqrt_8f = 4,
-        // MinMax - same execution path as FADD: L=3, TPC=4 → 12; Int: 8
+        // MinMax - SMAX/CMGT: L=2, TPC=4 → 8; FMAX: L=3, TPC=4 → 12
         .minmax_1 = 8,
         .minmax_2 = 8,
         .minmax_4i = 8,
         .minmax_8i = 8,
         .minmax_4f = 12,
         .minmax_8f = 12,
-        // Bitwise - AND/ORR/EOR: L=2, TPC=4 → 8
+        // Bitwise - AND: L=2, TPC=4 → 8
         .bitwise_1 = 8,
         .bitwise_2 = 8,
         .bitwise_4 = 8,
         .bitwise_8 = 8,
-        // Shift - SHL/USHR: L=2, TPC=4 → 8
+        // Shift - SHL: L=2, TPC=4 → 8
         .shift_1 = 8,
         .shift_2 = 8,
         .shift_4 = 8,
         .shift_8 = 8,
+        // Gather - LDR: L=4, TPC=3 → 13
+        .gather_4 = 13,
+        .gather_8 = 13,
+        // Popcount - CNT: L=2, TPC=4 → 8
+        .popcount_4 = 8,
+        .popcount_8 = 8,
+        // CompareExchange - SMAX/CMGT: L=2, TPC=2 → 4
+        .cmpxchg_4 = 4,
+        .cmpxchg_8 = 4,
+        // Convert - SCVTF: L=3, TPC=4 → 12
+        .convert_4 = 12,
+        .convert_8 = 12,
+        // Hash - MADD: L=5, TPC=2 → 10
+        .hash_4 = 10,
+        .hash_8 = 10,
+        // Scan - ADD: L=2, TPC=2 → 4; FADD: L=3, TPC=2 → 6
+        .scan_4i = 4,
+        .scan_8i = 4,
+        .scan_4f = 6,
+        .scan_8f = 6,
+        // Registers - X0-X30, V0-V31
+        .gpr_registers = 31,
+        .vector_registers = 32,
+        // Caches - L1D 128 KiB, L2 12 MiB, LLC 12 MiB (M1; the P-cluster L2 is the last CPU-side level)
+        .l1d_kib = 128,
+        .l2_kib = 12288,
+        .llc_kib = 12288,
     };
 
     // Intel Alder Lake (Golden Cove P-cores) - Source: https://uops.info
     //
-    // +----------------+----------+---------+------+-------+
-    // | Instruction    | Use Case | Latency | RThr | L×TPC |
-    // +----------------+----------+---------+------+-------+
-    // | VFMADD231PS/PD | FMA      |    4    | 0.50 |   8   |
-    // | VADDPS/VADDPD  | FP Add   |    3    | 0.50 |   6   |
-    // | VPADDB/W/D/Q   | Int Add  |    1    | 0.33 |   3   |
-    // | VUCOMISS/SD    | FP Cmp   |    3    | 1.00 |   3   |
-    // | VPCMPEQD       | Int Cmp  |    1    | 0.50 |   2   |
-    // | CMP r,r        | Cmp+Flag |    1    | 0.25 |   4   |
-    // +----------------+----------+---------+------+-------+
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.33 |   3   |
+    // | VADDPS/PD      | FP Add     |    3    |  0.50 |   6   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  5.00 |   3   |
+    // | VDIVPD         | FP Div     |   13    |  8.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   12    |  6.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   15    |  9.00 |   2   |
+    // | VPMAXSB/W/D    | Int MinMax |    1    |  0.50 |   2   |
+    // | VPCMPGTQ       | Int MinMax |    3    |  1.00 |   3   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPAND          | Bitwise    |    1    |  0.33 |   3   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  0.50 |   2   |
+    // | VPGATHERDD     | Gather     |   20    |  3.00 |   7   |
+    // | VPGATHERQQ     | Gather     |   20    |  2.00 |  10   |
+    // | POPCNT         | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD        | Min+Max    |    1    |  1.00 |   2   |
+    // | VPCMPGTQ       | Min+Max    |    3    |  2.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  0.50 |   8   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    3    |  0.50 |   6   |
+    // +----------------+------------+---------+-------+-------+
     inline constexpr Profile alderlake = {
-        // Sum - Integer: L=1, TPC=3 → 3; FP: L=3, TPC=2 → 6
+        .id = "alderlake",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=3 → 3; VADDPS/PD: L=3, TPC=2 → 6
         .sum_1 = 3,
         .sum_2 = 3,
         .sum_4i = 3,
         .sum_8i = 3,
         .sum_4f = 6,
         .sum_8f = 6,
-        // DotProduct - FMA: L=4, TPC=2 → 8
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
         .dotproduct_4 = 8,
         .dotproduct_8 = 8,
-        // Search - compare + branch
+        // Search - CMP: L=1, TPC=4 → 4
         .search_1 = 4,
         .search_2 = 4,
         .search_4 = 4,
@@ -225,117 +360,793 @@ namespace ilp::cpu {
         .transform_2 = 4,
         .transform_4 = 4,
         .transform_8 = 4,
-        // Multiply - FP: L=4, TPC=2 → 8; Int32: L=10, TPC=1 → 10
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; IMUL: L=3, TPC=1 → 3
         .multiply_4f = 8,
         .multiply_8f = 8,
         .multiply_4i = 10,
-        .multiply_8i = 4,
-        // Divide - VDIVPS: L=11, RThr=5.0, TPC=0.2 → 2
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.2 → 3; VDIVPD: L=13, TPC=0.12 → 2
+        .divide_4f = 3,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=12, TPC=0.17 → 2; VSQRTPD: L=15, TPC=0.11 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D: L=1, TPC=2 → 2; VPCMPGTQ: L=3, TPC=1 → 3; VMAXPS/PD: L=4, TPC=2 → 8
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 3,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - VPAND: L=1, TPC=3 → 3
+        .bitwise_1 = 3,
+        .bitwise_2 = 3,
+        .bitwise_4 = 3,
+        .bitwise_8 = 3,
+        // Shift - VPSLLW/D/Q: L=1, TPC=2 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=20, TPC=0.33 → 7; VPGATHERQQ: L=20, TPC=0.5 → 10
+        .gather_4 = 7,
+        .gather_8 = 10,
+        // Popcount - POPCNT: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD: L=1, TPC=1 → 2; VPCMPGTQ: L=3, TPC=0.5 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=2 → 8; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 8,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=3, TPC=2 → 6
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 6,
+        .scan_8f = 6,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 48 KiB, L2 1280 KiB, LLC 30 MiB (Core i9-12900K)
+        .l1d_kib = 48,
+        .l2_kib = 1280,
+        .llc_kib = 30720,
+    };
+
+    // Intel Ice Lake (Sunny Cove, client and Ice Lake-SP) - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.33 |   3   |
+    // | VADDPS/PD      | FP Add     |    4    |  0.50 |   8   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  5.00 |   3   |
+    // | VDIVPD         | FP Div     |   13    |  8.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   12    |  6.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   15    |  9.00 |   2   |
+    // | VPMAXSB/W/D    | Int MinMax |    1    |  0.50 |   2   |
+    // | VPCMPGTQ       | Int MinMax |    3    |  1.00 |   3   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPAND          | Bitwise    |    1    |  0.33 |   3   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  0.50 |   2   |
+    // | VPGATHERDD     | Gather     |   22    |  5.00 |   5   |
+    // | VPGATHERQQ     | Gather     |   20    |  3.00 |   7   |
+    // | VPOPCNTD/Q     | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD        | Min+Max    |    1    |  1.00 |   2   |
+    // | VPCMPGTQ       | Min+Max    |    3    |  2.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  0.50 |   8   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    4    |  0.50 |   8   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile icelake = {
+        .id = "icelake",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=3 → 3; VADDPS/PD: L=4, TPC=2 → 8
+        .sum_1 = 3,
+        .sum_2 = 3,
+        .sum_4i = 3,
+        .sum_8i = 3,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; IMUL: L=3, TPC=1 → 3
+        .multiply_4f = 8,
+        .multiply_8f = 8,
+        .multiply_4i = 10,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.2 → 3; VDIVPD: L=13, TPC=0.12 → 2
+        .divide_4f = 3,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=12, TPC=0.17 → 2; VSQRTPD: L=15, TPC=0.11 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D: L=1, TPC=2 → 2; VPCMPGTQ: L=3, TPC=1 → 3; VMAXPS/PD: L=4, TPC=2 → 8
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 3,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - VPAND: L=1, TPC=3 → 3
+        .bitwise_1 = 3,
+        .bitwise_2 = 3,
+        .bitwise_4 = 3,
+        .bitwise_8 = 3,
+        // Shift - VPSLLW/D/Q: L=1, TPC=2 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=22, TPC=0.2 → 5; VPGATHERQQ: L=20, TPC=0.33 → 7
+        .gather_4 = 5,
+        .gather_8 = 7,
+        // Popcount - VPOPCNTD/Q: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD: L=1, TPC=1 → 2; VPCMPGTQ: L=3, TPC=0.5 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=2 → 8; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 8,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=4, TPC=2 → 8
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 8,
+        .scan_8f = 8,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 48 KiB, L2 512 KiB, LLC 8 MiB (Core i7-1065G7)
+        .l1d_kib = 48,
+        .l2_kib = 512,
+        .llc_kib = 8192,
+    };
+
+    // Intel Ice Lake-SP (Sunny Cove), 512-bit vectors - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | FP Add     |    4    |  0.50 |   8   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | VPMULLQ        | Int Mul    |   15    |  1.50 |  10   |
+    // | VDIVPS         | FP Div     |   18    | 10.00 |   2   |
+    // | VDIVPD         | FP Div     |   23    | 16.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   19    | 12.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   23    | 16.00 |   2   |
+    // | VPMAXSB/W/D/Q  | Int MinMax |    1    |  0.50 |   2   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPANDD         | Bitwise    |    1    |  0.50 |   2   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  1.00 |   2   |
+    // | VPGATHERDD     | Gather     |   24    |  8.00 |   3   |
+    // | VPGATHERQQ     | Gather     |   22    |  5.00 |   5   |
+    // | VPOPCNTD/Q     | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD/Q      | Min+Max    |    1    |  1.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  1.00 |   4   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    4    |  0.50 |   8   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile icelake_avx512 = {
+        .id = "icelake_avx512",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=2 → 2; VADDPS/PD: L=4, TPC=2 → 8
+        .sum_1 = 2,
+        .sum_2 = 2,
+        .sum_4i = 2,
+        .sum_8i = 2,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; VPMULLQ: L=15, TPC=0.67 → 10
+        .multiply_4f = 8,
+        .multiply_8f = 8,
+        .multiply_4i = 10,
+        .multiply_8i = 10,
+        // Divide - VDIVPS: L=18, TPC=0.1 → 2; VDIVPD: L=23, TPC=0.06 → 2
         .divide_4f = 2,
         .divide_8f = 2,
-        // Sqrt - VSQRTPS: L=12, RThr=6.0, TPC=0.167 → 2
+        // Sqrt - VSQRTPS: L=19, TPC=0.08 → 2; VSQRTPD: L=23, TPC=0.06 → 2
         .sqrt_4f = 2,
         .sqrt_8f = 2,
-        // MinMax - Int: L=1, TPC=2 → 2; FP: L=4, TPC=2 → 8
+        // MinMax - VPMAXSB/W/D/Q: L=1, TPC=2 → 2; VMAXPS/PD: L=4, TPC=2 → 8
         .minmax_1 = 2,
         .minmax_2 = 2,
         .minmax_4i = 2,
         .minmax_8i = 2,
         .minmax_4f = 8,
         .minmax_8f = 8,
-        // Bitwise - L=1, TPC=3 → 3
+        // Bitwise - VPANDD: L=1, TPC=2 → 2
+        .bitwise_1 = 2,
+        .bitwise_2 = 2,
+        .bitwise_4 = 2,
+        .bitwise_8 = 2,
+        // Shift - VPSLLW/D/Q: L=1, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=24, TPC=0.12 → 3; VPGATHERQQ: L=22, TPC=0.2 → 5
+        .gather_4 = 3,
+        .gather_8 = 5,
+        // Popcount - VPOPCNTD/Q: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD/Q: L=1, TPC=1 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=1 → 4; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 4,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=4, TPC=2 → 8
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 8,
+        .scan_8f = 8,
+        // Registers - RAX-R15, ZMM0-31
+        .gpr_registers = 16,
+        .vector_registers = 32,
+        // Caches - L1D 48 KiB, L2 1280 KiB, LLC 60 MiB (Xeon Platinum 8380)
+        .l1d_kib = 48,
+        .l2_kib = 1280,
+        .llc_kib = 61440,
+    };
+
+    // Intel Sapphire Rapids (Golden Cove server cores) - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.33 |   3   |
+    // | VADDPS/PD      | FP Add     |    3    |  0.50 |   6   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.20 |   5   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  5.00 |   3   |
+    // | VDIVPD         | FP Div     |   13    |  8.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   12    |  6.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   15    |  9.00 |   2   |
+    // | VPMAXSB/W/D    | Int MinMax |    1    |  0.50 |   2   |
+    // | VPCMPGTQ       | Int MinMax |    3    |  1.00 |   3   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPAND          | Bitwise    |    1    |  0.33 |   3   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  0.50 |   2   |
+    // | VPGATHERDD     | Gather     |   20    |  3.00 |   7   |
+    // | VPGATHERQQ     | Gather     |   20    |  2.00 |  10   |
+    // | VPOPCNTD/Q     | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD        | Min+Max    |    1    |  1.00 |   2   |
+    // | VPCMPGTQ       | Min+Max    |    3    |  2.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  0.50 |   8   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    3    |  0.50 |   6   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile sapphirerapids = {
+        .id = "sapphirerapids",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=3 → 3; VADDPS/PD: L=3, TPC=2 → 6
+        .sum_1 = 3,
+        .sum_2 = 3,
+        .sum_4i = 3,
+        .sum_8i = 3,
+        .sum_4f = 6,
+        .sum_8f = 6,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - CMP: L=1, TPC=5 → 5
+        .search_1 = 5,
+        .search_2 = 5,
+        .search_4 = 5,
+        .search_8 = 5,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; IMUL: L=3, TPC=1 → 3
+        .multiply_4f = 8,
+        .multiply_8f = 8,
+        .multiply_4i = 10,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.2 → 3; VDIVPD: L=13, TPC=0.12 → 2
+        .divide_4f = 3,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=12, TPC=0.17 → 2; VSQRTPD: L=15, TPC=0.11 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D: L=1, TPC=2 → 2; VPCMPGTQ: L=3, TPC=1 → 3; VMAXPS/PD: L=4, TPC=2 → 8
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 3,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - VPAND: L=1, TPC=3 → 3
         .bitwise_1 = 3,
         .bitwise_2 = 3,
         .bitwise_4 = 3,
         .bitwise_8 = 3,
-        // Shift - L=1, TPC=1 → 2 (min for ILP)
+        // Shift - VPSLLW/D/Q: L=1, TPC=2 → 2
         .shift_1 = 2,
         .shift_2 = 2,
         .shift_4 = 2,
         .shift_8 = 2,
+        // Gather - VPGATHERDD: L=20, TPC=0.33 → 7; VPGATHERQQ: L=20, TPC=0.5 → 10
+        .gather_4 = 7,
+        .gather_8 = 10,
+        // Popcount - VPOPCNTD/Q: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD: L=1, TPC=1 → 2; VPCMPGTQ: L=3, TPC=0.5 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=2 → 8; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 8,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=3, TPC=2 → 6
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 6,
+        .scan_8f = 6,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 48 KiB, L2 2 MiB, LLC 105 MiB (Xeon Platinum 8480+)
+        .l1d_kib = 48,
+        .l2_kib = 2048,
+        .llc_kib = 107520,
     };
 
-    // AMD Zen 4/5 (Ryzen 7000/9000 series) - Source: https://uops.info
+    // Intel Sapphire Rapids (Golden Cove server cores), 512-bit vectors - Source: https://uops.info
     //
-    // +----------------+----------+---------+------+-------+
-    // | Instruction    | Use Case | Latency | RThr | L×TPC |
-    // +----------------+----------+---------+------+-------+
-    // | VFMADD231PS/PD | FMA      |    4    | 0.50 |   8   |
-    // | VADDPS/VADDPD  | FP Add   |    3    | 0.50 |   6   |
-    // | VPADDB/W/D/Q   | Int Add  |    1    | 0.25 |   4   |
-    // | VUCOMISS/SD    | FP Cmp   |    6    | 1.00 |   6   |
-    // | VPCMPEQD       | Int Cmp  |    1    | 0.50 |   2   |
-    // | CMP r,r        | Cmp+Flag |    1    | 0.25 |   4   |
-    // +----------------+----------+---------+------+-------+
-    inline constexpr Profile zen5 = {
-        // Sum - Integer: L=1, TPC=4 → 4; FP: L=3, TPC=2 → 6
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | FP Add     |    4    |  0.50 |   8   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  0.50 |   8   |
+    // | VPMULLD        | Int Mul    |   10    |  1.00 |  10   |
+    // | VPMULLQ        | Int Mul    |   15    |  1.50 |  10   |
+    // | VDIVPS         | FP Div     |   18    | 10.00 |   2   |
+    // | VDIVPD         | FP Div     |   23    | 16.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   19    | 12.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   23    | 16.00 |   2   |
+    // | VPMAXSB/W/D/Q  | Int MinMax |    1    |  0.50 |   2   |
+    // | VMAXPS/PD      | FP MinMax  |    4    |  0.50 |   8   |
+    // | VPANDD         | Bitwise    |    1    |  0.50 |   2   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  1.00 |   2   |
+    // | VPGATHERDD     | Gather     |   24    |  5.33 |   5   |
+    // | VPGATHERQQ     | Gather     |   22    |  2.67 |   9   |
+    // | VPOPCNTD/Q     | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD/Q      | Min+Max    |    1    |  1.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  1.00 |   4   |
+    // | VCVTDQ2PD      | Int→FP     |    7    |  1.00 |   7   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    4    |  0.50 |   8   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile sapphirerapids_avx512 = {
+        .id = "sapphirerapids_avx512",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=2 → 2; VADDPS/PD: L=4, TPC=2 → 8
+        .sum_1 = 2,
+        .sum_2 = 2,
+        .sum_4i = 2,
+        .sum_8i = 2,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD: L=4, TPC=2 → 8; VPMULLD: L=10, TPC=1 → 10; VPMULLQ: L=15, TPC=0.67 → 10
+        .multiply_4f = 8,
+        .multiply_8f = 8,
+        .multiply_4i = 10,
+        .multiply_8i = 10,
+        // Divide - VDIVPS: L=18, TPC=0.1 → 2; VDIVPD: L=23, TPC=0.06 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=19, TPC=0.08 → 2; VSQRTPD: L=23, TPC=0.06 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D/Q: L=1, TPC=2 → 2; VMAXPS/PD: L=4, TPC=2 → 8
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 2,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - VPANDD: L=1, TPC=2 → 2
+        .bitwise_1 = 2,
+        .bitwise_2 = 2,
+        .bitwise_4 = 2,
+        .bitwise_8 = 2,
+        // Shift - VPSLLW/D/Q: L=1, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=24, TPC=0.19 → 5; VPGATHERQQ: L=22, TPC=0.37 → 9
+        .gather_4 = 5,
+        .gather_8 = 9,
+        // Popcount - VPOPCNTD/Q: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD/Q: L=1, TPC=1 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=1 → 4; VCVTDQ2PD: L=7, TPC=1 → 7
+        .convert_4 = 4,
+        .convert_8 = 7,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=4, TPC=2 → 8
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 8,
+        .scan_8f = 8,
+        // Registers - RAX-R15, ZMM0-31
+        .gpr_registers = 16,
+        .vector_registers = 32,
+        // Caches - L1D 48 KiB, L2 2 MiB, LLC 105 MiB (Xeon Platinum 8480+)
+        .l1d_kib = 48,
+        .l2_kib = 2048,
+        .llc_kib = 107520,
+    };
+
+    // AMD Zen 4 (Ryzen 7000 / EPYC 9004 series) - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.25 |   4   |
+    // | VADDPS/PD      | FP Add     |    3    |  0.50 |   6   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    3    |  0.50 |   6   |
+    // | VPMULLD        | Int Mul    |    3    |  0.50 |   6   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  3.00 |   4   |
+    // | VDIVPD         | FP Div     |   13    |  5.00 |   3   |
+    // | VSQRTPS        | FP Sqrt    |   15    |  5.00 |   3   |
+    // | VSQRTPD        | FP Sqrt    |   21    |  8.00 |   3   |
+    // | VPMAXSB/W/D/VPCMPGTQ | Int MinMax |    1    |  0.25 |   4   |
+    // | VMAXPS/PD      | FP MinMax  |    2    |  0.50 |   4   |
+    // | VPAND          | Bitwise    |    1    |  0.25 |   4   |
+    // | VPSLLW/D/Q     | Shift      |    2    |  0.50 |   4   |
+    // | VPGATHERDD     | Gather     |   13    |  8.00 |   2   |
+    // | VPGATHERQQ     | Gather     |   13    |  4.00 |   4   |
+    // | VPOPCNTD/Q     | Popcount   |    2    |  0.50 |   4   |
+    // | VPMAXSD/VPCMPGTQ | Min+Max    |    1    |  0.50 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    3    |  0.50 |   6   |
+    // | VCVTDQ2PD      | Int→FP     |    4    |  1.00 |   4   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    3    |  0.50 |   6   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile zen4 = {
+        .id = "zen4",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=4 → 4; VADDPS/PD: L=3, TPC=2 → 6
         .sum_1 = 4,
         .sum_2 = 4,
         .sum_4i = 4,
         .sum_8i = 4,
         .sum_4f = 6,
         .sum_8f = 6,
-        // DotProduct - FMA: L=4, TPC=2 → 8
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
         .dotproduct_4 = 8,
         .dotproduct_8 = 8,
-        // Search - compare + branch
+        // Search - CMP: L=1, TPC=4 → 4
         .search_1 = 4,
         .search_2 = 4,
         .search_4 = 4,
         .search_8 = 4,
-        // Copy - improved memory subsystem
+        // Copy - memory bandwidth limited
         .copy_1 = 8,
         .copy_2 = 4,
         .copy_4 = 4,
         .copy_8 = 4,
-        // Transform - wide dispatch benefits ILP
+        // Transform - memory + compute balanced
         .transform_1 = 4,
         .transform_2 = 4,
         .transform_4 = 4,
         .transform_8 = 4,
-        // Multiply - VMULPS: L=3, TPC=2 → 6; VPMULLD: L=3, TPC=2 → 6 (much faster than Intel!)
+        // Multiply - VMULPS/PD/VPMULLD: L=3, TPC=2 → 6; IMUL: L=3, TPC=1 → 3
         .multiply_4f = 6,
         .multiply_8f = 6,
         .multiply_4i = 6,
-        .multiply_8i = 6,
+        .multiply_8i = 3,
         // Divide - VDIVPS: L=11, TPC=0.33 → 4; VDIVPD: L=13, TPC=0.2 → 3
         .divide_4f = 4,
         .divide_8f = 3,
         // Sqrt - VSQRTPS: L=15, TPC=0.2 → 3; VSQRTPD: L=21, TPC=0.12 → 3
         .sqrt_4f = 3,
         .sqrt_8f = 3,
-        // MinMax - VMINPS: L=2, TPC=2 → 4; VPMINSW: L=1, TPC=4 → 4
+        // MinMax - VPMAXSB/W/D/VPCMPGTQ: L=1, TPC=4 → 4; VMAXPS/PD: L=2, TPC=2 → 4
         .minmax_1 = 4,
         .minmax_2 = 4,
         .minmax_4i = 4,
         .minmax_8i = 4,
         .minmax_4f = 4,
         .minmax_8f = 4,
-        // Bitwise - L=1, TPC=4 → 4
+        // Bitwise - VPAND: L=1, TPC=4 → 4
         .bitwise_1 = 4,
         .bitwise_2 = 4,
         .bitwise_4 = 4,
         .bitwise_8 = 4,
-        // Shift - L=2, TPC=2 → 4
+        // Shift - VPSLLW/D/Q: L=2, TPC=2 → 4
         .shift_1 = 4,
         .shift_2 = 4,
         .shift_4 = 4,
         .shift_8 = 4,
+        // Gather - VPGATHERDD: L=13, TPC=0.12 → 2; VPGATHERQQ: L=13, TPC=0.25 → 4
+        .gather_4 = 2,
+        .gather_8 = 4,
+        // Popcount - VPOPCNTD/Q: L=2, TPC=2 → 4
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - VPMAXSD/VPCMPGTQ: L=1, TPC=2 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=3, TPC=2 → 6; VCVTDQ2PD: L=4, TPC=1 → 4
+        .convert_4 = 6,
+        .convert_8 = 4,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=3, TPC=2 → 6
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 6,
+        .scan_8f = 6,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 32 KiB, L2 1 MiB, LLC 32 MiB (Ryzen 9 7950X; L3 per CCD)
+        .l1d_kib = 32,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
     };
 
-    // Default - conservative cross-platform values
-    inline constexpr Profile default_profile = {
-        // Sum - Integer: conservative L=1, TPC=4 → 4; FP: L=4, TPC=2 → 8
+    // AMD Zen 4 (Ryzen 7000 / EPYC 9004 series), 512-bit vectors - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | FP Add     |    3    |  1.00 |   3   |
+    // | VFMADD231PS/PD | FMA        |    4    |  1.00 |   4   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    3    |  1.00 |   3   |
+    // | VPMULLD/Q      | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  6.00 |   2   |
+    // | VDIVPD         | FP Div     |   13    | 10.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   15    | 10.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   21    | 16.00 |   2   |
+    // | VPMAXSB/W/D/Q  | Int MinMax |    1    |  0.50 |   2   |
+    // | VMAXPS/PD      | FP MinMax  |    2    |  1.00 |   2   |
+    // | VPANDD         | Bitwise    |    1    |  0.50 |   2   |
+    // | VPSLLW/D/Q     | Shift      |    2    |  1.00 |   2   |
+    // | VPGATHERDD     | Gather     |   13    | 16.00 |   2   |
+    // | VPGATHERQQ     | Gather     |   13    |  8.00 |   2   |
+    // | VPOPCNTD/Q     | Popcount   |    2    |  1.00 |   2   |
+    // | VPMAXSD/Q      | Min+Max    |    1    |  1.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    3    |  1.00 |   3   |
+    // | VCVTDQ2PD      | Int→FP     |    4    |  2.00 |   2   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    3    |  1.00 |   3   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile zen4_avx512 = {
+        .id = "zen4_avx512",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=2 → 2; VADDPS/PD: L=3, TPC=1 → 3
+        .sum_1 = 2,
+        .sum_2 = 2,
+        .sum_4i = 2,
+        .sum_8i = 2,
+        .sum_4f = 3,
+        .sum_8f = 3,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=1 → 4
+        .dotproduct_4 = 4,
+        .dotproduct_8 = 4,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD/VPMULLD/Q: L=3, TPC=1 → 3
+        .multiply_4f = 3,
+        .multiply_8f = 3,
+        .multiply_4i = 3,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.17 → 2; VDIVPD: L=13, TPC=0.1 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=15, TPC=0.1 → 2; VSQRTPD: L=21, TPC=0.06 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D/Q: L=1, TPC=2 → 2; VMAXPS/PD: L=2, TPC=1 → 2
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 2,
+        .minmax_4f = 2,
+        .minmax_8f = 2,
+        // Bitwise - VPANDD: L=1, TPC=2 → 2
+        .bitwise_1 = 2,
+        .bitwise_2 = 2,
+        .bitwise_4 = 2,
+        .bitwise_8 = 2,
+        // Shift - VPSLLW/D/Q: L=2, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=13, TPC=0.06 → 2; VPGATHERQQ: L=13, TPC=0.12 → 2
+        .gather_4 = 2,
+        .gather_8 = 2,
+        // Popcount - VPOPCNTD/Q: L=2, TPC=1 → 2
+        .popcount_4 = 2,
+        .popcount_8 = 2,
+        // CompareExchange - VPMAXSD/Q: L=1, TPC=1 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=3, TPC=1 → 3; VCVTDQ2PD: L=4, TPC=0.5 → 2
+        .convert_4 = 3,
+        .convert_8 = 2,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=3, TPC=1 → 3
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 3,
+        .scan_8f = 3,
+        // Registers - RAX-R15, ZMM0-31
+        .gpr_registers = 16,
+        .vector_registers = 32,
+        // Caches - L1D 32 KiB, L2 1 MiB, LLC 32 MiB (Ryzen 9 7950X; L3 per CCD)
+        .l1d_kib = 32,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
+    };
+
+    // AMD Zen 5 (Ryzen 9000 / EPYC 9005 series) - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.25 |   4   |
+    // | VADDPS/PD      | FP Add     |    2    |  0.50 |   4   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    3    |  0.50 |   6   |
+    // | VPMULLD        | Int Mul    |    3    |  0.50 |   6   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    |  3.00 |   4   |
+    // | VDIVPD         | FP Div     |   13    |  5.00 |   3   |
+    // | VSQRTPS        | FP Sqrt    |   15    |  5.00 |   3   |
+    // | VSQRTPD        | FP Sqrt    |   21    |  8.00 |   3   |
+    // | VPMAXSB/W/D/VPCMPGTQ | Int MinMax |    1    |  0.25 |   4   |
+    // | VMAXPS/PD      | FP MinMax  |    2    |  0.50 |   4   |
+    // | VPAND          | Bitwise    |    1    |  0.25 |   4   |
+    // | VPSLLW/D/Q     | Shift      |    2    |  0.50 |   4   |
+    // | VPGATHERDD     | Gather     |   13    |  8.00 |   2   |
+    // | VPGATHERQQ     | Gather     |   13    |  4.00 |   4   |
+    // | VPOPCNTD/Q     | Popcount   |    2    |  0.50 |   4   |
+    // | VPMAXSD/VPCMPGTQ | Min+Max    |    1    |  0.50 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    3    |  0.50 |   6   |
+    // | VCVTDQ2PD      | Int→FP     |    4    |  1.00 |   4   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile zen5 = {
+        .id = "zen5",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=4 → 4; VADDPS/PD: L=2, TPC=2 → 4
         .sum_1 = 4,
         .sum_2 = 4,
         .sum_4i = 4,
         .sum_8i = 4,
-        .sum_4f = 8,
-        .sum_8f = 8,
-        // DotProduct - FMA: conservative L=4, TPC=2 → 8
+        .sum_4f = 4,
+        .sum_8f = 4,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
         .dotproduct_4 = 8,
         .dotproduct_8 = 8,
-        // Search - conservative N=4 balances ILP benefit vs misprediction cost
+        // Search - CMP: L=1, TPC=4 → 4
         .search_1 = 4,
         .search_2 = 4,
         .search_4 = 4,
@@ -345,52 +1156,952 @@ namespace ilp::cpu {
         .copy_2 = 4,
         .copy_4 = 4,
         .copy_8 = 4,
-        // Transform - memory + compute
+        // Transform - memory + compute balanced
         .transform_1 = 4,
         .transform_2 = 4,
         .transform_4 = 4,
         .transform_8 = 4,
-        // Multiply - FP: L=4, TPC=2 → 8; Int: conservative 8
-        .multiply_4f = 8,
-        .multiply_8f = 8,
-        .multiply_4i = 8,
-        .multiply_8i = 8,
-        // Divide - conservative
+        // Multiply - VMULPS/PD/VPMULLD: L=3, TPC=2 → 6; IMUL: L=3, TPC=1 → 3
+        .multiply_4f = 6,
+        .multiply_8f = 6,
+        .multiply_4i = 6,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.33 → 4; VDIVPD: L=13, TPC=0.2 → 3
         .divide_4f = 4,
-        .divide_8f = 4,
-        // Sqrt - conservative
-        .sqrt_4f = 4,
-        .sqrt_8f = 4,
-        // MinMax - Int: 4; FP: 8
+        .divide_8f = 3,
+        // Sqrt - VSQRTPS: L=15, TPC=0.2 → 3; VSQRTPD: L=21, TPC=0.12 → 3
+        .sqrt_4f = 3,
+        .sqrt_8f = 3,
+        // MinMax - VPMAXSB/W/D/VPCMPGTQ: L=1, TPC=4 → 4; VMAXPS/PD: L=2, TPC=2 → 4
         .minmax_1 = 4,
         .minmax_2 = 4,
         .minmax_4i = 4,
         .minmax_8i = 4,
-        .minmax_4f = 8,
-        .minmax_8f = 8,
-        // Bitwise - L=1, TPC=3 → 4 (conservative)
+        .minmax_4f = 4,
+        .minmax_8f = 4,
+        // Bitwise - VPAND: L=1, TPC=4 → 4
         .bitwise_1 = 4,
         .bitwise_2 = 4,
         .bitwise_4 = 4,
         .bitwise_8 = 4,
-        // Shift - L=1, TPC=2 → 2
-        .shift_1 = 2,
-        .shift_2 = 2,
-        .shift_4 = 2,
-        .shift_8 = 2,
+        // Shift - VPSLLW/D/Q: L=2, TPC=2 → 4
+        .shift_1 = 4,
+        .shift_2 = 4,
+        .shift_4 = 4,
+        .shift_8 = 4,
+        // Gather - VPGATHERDD: L=13, TPC=0.12 → 2; VPGATHERQQ: L=13, TPC=0.25 → 4
+        .gather_4 = 2,
+        .gather_8 = 4,
+        // Popcount - VPOPCNTD/Q: L=2, TPC=2 → 4
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - VPMAXSD/VPCMPGTQ: L=1, TPC=2 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=3, TPC=2 → 6; VCVTDQ2PD: L=4, TPC=1 → 4
+        .convert_4 = 6,
+        .convert_8 = 4,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=2, TPC=2 → 4
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 48 KiB, L2 1 MiB, LLC 32 MiB (Ryzen 9 9950X; L3 per CCD)
+        .l1d_kib = 48,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
     };
 
-    // Runtime profile lookup by name
-    inline const Profile& get(std::string_view name) {
-        if (name == "apple_m1" || name == "m1")
-            return apple_m1;
-        if (name == "alderlake" || name == "alder_lake")
-            return alderlake;
-        if (name == "zen5" || name == "zen4" || name == "zen")
-            return zen5;
+    // AMD Zen 5 (Ryzen 9000 / EPYC 9005 series), 512-bit vectors - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.25 |   4   |
+    // | VADDPS/PD      | FP Add     |    2    |  0.50 |   4   |
+    // | VFMADD231PS/PD | FMA        |    4    |  0.50 |   8   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    3    |  0.50 |   6   |
+    // | VPMULLD/Q      | Int Mul    |    3    |  0.50 |   6   |
+    // | VDIVPS         | FP Div     |   11    |  3.00 |   4   |
+    // | VDIVPD         | FP Div     |   13    |  5.00 |   3   |
+    // | VSQRTPS        | FP Sqrt    |   15    |  5.00 |   3   |
+    // | VSQRTPD        | FP Sqrt    |   21    |  8.00 |   3   |
+    // | VPMAXSB/W/D/Q  | Int MinMax |    1    |  0.25 |   4   |
+    // | VMAXPS/PD      | FP MinMax  |    2    |  0.50 |   4   |
+    // | VPAND          | Bitwise    |    1    |  0.25 |   4   |
+    // | VPSLLW/D/Q     | Shift      |    2    |  0.50 |   4   |
+    // | VPGATHERDD     | Gather     |   13    |  8.00 |   2   |
+    // | VPGATHERQQ     | Gather     |   13    |  4.00 |   4   |
+    // | VPOPCNTD/Q     | Popcount   |    2    |  0.50 |   4   |
+    // | VPMAXSD/Q      | Min+Max    |    1    |  0.50 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    3    |  0.50 |   6   |
+    // | VCVTDQ2PD      | Int→FP     |    4    |  1.00 |   4   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.50 |   2   |
+    // | VADDPS/PD      | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile zen5_avx512 = {
+        .id = "zen5_avx512",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=4 → 4; VADDPS/PD: L=2, TPC=2 → 4
+        .sum_1 = 4,
+        .sum_2 = 4,
+        .sum_4i = 4,
+        .sum_8i = 4,
+        .sum_4f = 4,
+        .sum_8f = 4,
+        // DotProduct - VFMADD231PS/PD: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD/VPMULLD/Q: L=3, TPC=2 → 6
+        .multiply_4f = 6,
+        .multiply_8f = 6,
+        .multiply_4i = 6,
+        .multiply_8i = 6,
+        // Divide - VDIVPS: L=11, TPC=0.33 → 4; VDIVPD: L=13, TPC=0.2 → 3
+        .divide_4f = 4,
+        .divide_8f = 3,
+        // Sqrt - VSQRTPS: L=15, TPC=0.2 → 3; VSQRTPD: L=21, TPC=0.12 → 3
+        .sqrt_4f = 3,
+        .sqrt_8f = 3,
+        // MinMax - VPMAXSB/W/D/Q: L=1, TPC=4 → 4; VMAXPS/PD: L=2, TPC=2 → 4
+        .minmax_1 = 4,
+        .minmax_2 = 4,
+        .minmax_4i = 4,
+        .minmax_8i = 4,
+        .minmax_4f = 4,
+        .minmax_8f = 4,
+        // Bitwise - VPAND: L=1, TPC=4 → 4
+        .bitwise_1 = 4,
+        .bitwise_2 = 4,
+        .bitwise_4 = 4,
+        .bitwise_8 = 4,
+        // Shift - VPSLLW/D/Q: L=2, TPC=2 → 4
+        .shift_1 = 4,
+        .shift_2 = 4,
+        .shift_4 = 4,
+        .shift_8 = 4,
+        // Gather - VPGATHERDD: L=13, TPC=0.12 → 2; VPGATHERQQ: L=13, TPC=0.25 → 4
+        .gather_4 = 2,
+        .gather_8 = 4,
+        // Popcount - VPOPCNTD/Q: L=2, TPC=2 → 4
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - VPMAXSD/Q: L=1, TPC=2 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=3, TPC=2 → 6; VCVTDQ2PD: L=4, TPC=1 → 4
+        .convert_4 = 6,
+        .convert_8 = 4,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=2 → 2; VADDPS/PD: L=2, TPC=2 → 4
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - RAX-R15, ZMM0-31
+        .gpr_registers = 16,
+        .vector_registers = 32,
+        // Caches - L1D 48 KiB, L2 1 MiB, LLC 32 MiB (Ryzen 9 9950X; L3 per CCD)
+        .l1d_kib = 48,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
+    };
+
+    // Arm Neoverse V1 (AWS Graviton 3) - Source: Arm Neoverse V1 Software Optimization Guide
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | ADD            | Int Add    |    2    |  0.25 |   8   |
+    // | FADD           | FP Add     |    2    |  0.25 |   8   |
+    // | FMLA           | FMA        |    4    |  0.25 |  16   |
+    // | FCMP           | Cmp+Branch |    2    |  0.50 |   4   |
+    // | FMUL           | FP Mul     |    3    |  0.25 |  12   |
+    // | MUL            | Int Mul    |    4    |  0.50 |   8   |
+    // | FDIV           | FP Div     |   10    |  5.00 |   2   |
+    // | FSQRT          | FP Sqrt    |   10    |  6.00 |   2   |
+    // | SMAX/CMGT      | Int MinMax |    2    |  0.25 |   8   |
+    // | FMAX           | FP MinMax  |    2    |  0.25 |   8   |
+    // | AND            | Bitwise    |    2    |  0.25 |   8   |
+    // | SHL            | Shift      |    2    |  0.50 |   4   |
+    // | LDR            | Gather     |    4    |  0.33 |  13   |
+    // | CNT            | Popcount   |    2    |  0.25 |   8   |
+    // | SMAX/CMGT      | Min+Max    |    2    |  0.50 |   4   |
+    // | SCVTF          | Int→FP     |    3    |  0.50 |   6   |
+    // | MADD           | Mul+Xor    |    4    |  0.50 |   8   |
+    // | ADD/FADD       | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile neoverse_v1 = {
+        .id = "neoverse_v1",
+        // Sum - ADD/FADD: L=2, TPC=4 → 8
+        .sum_1 = 8,
+        .sum_2 = 8,
+        .sum_4i = 8,
+        .sum_8i = 8,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - FMLA: L=4, TPC=4 → 16
+        .dotproduct_4 = 16,
+        .dotproduct_8 = 16,
+        // Search - FCMP: L=2, TPC=2 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - FMUL: L=3, TPC=4 → 12; MUL: L=4, TPC=2 → 8
+        .multiply_4f = 12,
+        .multiply_8f = 12,
+        .multiply_4i = 8,
+        .multiply_8i = 8,
+        // Divide - FDIV: L=10, TPC=0.2 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - FSQRT: L=10, TPC=0.17 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - SMAX/CMGT/FMAX: L=2, TPC=4 → 8
+        .minmax_1 = 8,
+        .minmax_2 = 8,
+        .minmax_4i = 8,
+        .minmax_8i = 8,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - AND: L=2, TPC=4 → 8
+        .bitwise_1 = 8,
+        .bitwise_2 = 8,
+        .bitwise_4 = 8,
+        .bitwise_8 = 8,
+        // Shift - SHL: L=2, TPC=2 → 4
+        .shift_1 = 4,
+        .shift_2 = 4,
+        .shift_4 = 4,
+        .shift_8 = 4,
+        // Gather - LDR: L=4, TPC=3 → 13
+        .gather_4 = 13,
+        .gather_8 = 13,
+        // Popcount - CNT: L=2, TPC=4 → 8
+        .popcount_4 = 8,
+        .popcount_8 = 8,
+        // CompareExchange - SMAX/CMGT: L=2, TPC=2 → 4
+        .cmpxchg_4 = 4,
+        .cmpxchg_8 = 4,
+        // Convert - SCVTF: L=3, TPC=2 → 6
+        .convert_4 = 6,
+        .convert_8 = 6,
+        // Hash - MADD: L=4, TPC=2 → 8
+        .hash_4 = 8,
+        .hash_8 = 8,
+        // Scan - ADD/FADD: L=2, TPC=2 → 4
+        .scan_4i = 4,
+        .scan_8i = 4,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - X0-X30, V0-V31
+        .gpr_registers = 31,
+        .vector_registers = 32,
+        // Caches - L1D 64 KiB, L2 1 MiB, LLC 32 MiB (Graviton 3)
+        .l1d_kib = 64,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
+    };
+
+    // Arm Neoverse V1 (AWS Graviton 3), 256-bit SVE - Source: Arm Neoverse V1 Software Optimization Guide
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | ADD            | Int Add    |    2    |  0.50 |   4   |
+    // | FADD           | FP Add     |    2    |  0.50 |   4   |
+    // | FMLA           | FMA        |    4    |  0.50 |   8   |
+    // | FCMP           | Cmp+Branch |    2    |  0.50 |   4   |
+    // | FMUL           | FP Mul     |    3    |  0.50 |   6   |
+    // | MUL            | Int Mul    |    4    |  1.00 |   4   |
+    // | FDIV           | FP Div     |   10    | 10.00 |   2   |
+    // | FSQRT          | FP Sqrt    |   10    | 12.00 |   2   |
+    // | SMAX/CMGT      | Int MinMax |    2    |  0.50 |   4   |
+    // | FMAX           | FP MinMax  |    2    |  0.50 |   4   |
+    // | AND            | Bitwise    |    2    |  0.50 |   4   |
+    // | SHL            | Shift      |    2    |  1.00 |   2   |
+    // | LD1W           | Gather     |    9    |  2.00 |   5   |
+    // | LD1D           | Gather     |    9    |  1.00 |   9   |
+    // | CNT            | Popcount   |    2    |  0.50 |   4   |
+    // | SMAX/CMGT      | Min+Max    |    2    |  1.00 |   2   |
+    // | SCVTF          | Int→FP     |    3    |  1.00 |   3   |
+    // | MADD           | Mul+Xor    |    4    |  0.50 |   8   |
+    // | ADD/FADD       | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile neoverse_v1_sve = {
+        .id = "neoverse_v1_sve",
+        // Sum - ADD/FADD: L=2, TPC=2 → 4
+        .sum_1 = 4,
+        .sum_2 = 4,
+        .sum_4i = 4,
+        .sum_8i = 4,
+        .sum_4f = 4,
+        .sum_8f = 4,
+        // DotProduct - FMLA: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - FCMP: L=2, TPC=2 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - FMUL: L=3, TPC=2 → 6; MUL: L=4, TPC=1 → 4
+        .multiply_4f = 6,
+        .multiply_8f = 6,
+        .multiply_4i = 4,
+        .multiply_8i = 4,
+        // Divide - FDIV: L=10, TPC=0.1 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - FSQRT: L=10, TPC=0.08 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - SMAX/CMGT/FMAX: L=2, TPC=2 → 4
+        .minmax_1 = 4,
+        .minmax_2 = 4,
+        .minmax_4i = 4,
+        .minmax_8i = 4,
+        .minmax_4f = 4,
+        .minmax_8f = 4,
+        // Bitwise - AND: L=2, TPC=2 → 4
+        .bitwise_1 = 4,
+        .bitwise_2 = 4,
+        .bitwise_4 = 4,
+        .bitwise_8 = 4,
+        // Shift - SHL: L=2, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - LD1W: L=9, TPC=0.5 → 5; LD1D: L=9, TPC=1 → 9
+        .gather_4 = 5,
+        .gather_8 = 9,
+        // Popcount - CNT: L=2, TPC=2 → 4
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - SMAX/CMGT: L=2, TPC=1 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - SCVTF: L=3, TPC=1 → 3
+        .convert_4 = 3,
+        .convert_8 = 3,
+        // Hash - MADD: L=4, TPC=2 → 8
+        .hash_4 = 8,
+        .hash_8 = 8,
+        // Scan - ADD/FADD: L=2, TPC=2 → 4
+        .scan_4i = 4,
+        .scan_8i = 4,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - X0-X30, Z0-Z31
+        .gpr_registers = 31,
+        .vector_registers = 32,
+        // Caches - L1D 64 KiB, L2 1 MiB, LLC 32 MiB (Graviton 3)
+        .l1d_kib = 64,
+        .l2_kib = 1024,
+        .llc_kib = 32768,
+    };
+
+    // Arm Neoverse V2 (AWS Graviton 4, NVIDIA Grace) - Source: Arm Neoverse V2 Software Optimization Guide
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | ADD            | Int Add    |    2    |  0.25 |   8   |
+    // | FADD           | FP Add     |    2    |  0.25 |   8   |
+    // | FMLA           | FMA        |    4    |  0.25 |  16   |
+    // | FCMP           | Cmp+Branch |    2    |  0.50 |   4   |
+    // | FMUL           | FP Mul     |    3    |  0.25 |  12   |
+    // | MUL            | Int Mul    |    4    |  0.50 |   8   |
+    // | FDIV           | FP Div     |   10    |  5.00 |   2   |
+    // | FSQRT          | FP Sqrt    |    9    |  5.00 |   2   |
+    // | SMAX/CMGT      | Int MinMax |    2    |  0.25 |   8   |
+    // | FMAX           | FP MinMax  |    2    |  0.25 |   8   |
+    // | AND            | Bitwise    |    2    |  0.25 |   8   |
+    // | SHL            | Shift      |    2    |  0.50 |   4   |
+    // | LDR            | Gather     |    4    |  0.33 |  13   |
+    // | CNT            | Popcount   |    2    |  0.25 |   8   |
+    // | SMAX/CMGT      | Min+Max    |    2    |  0.50 |   4   |
+    // | SCVTF          | Int→FP     |    3    |  0.50 |   6   |
+    // | MADD           | Mul+Xor    |    4    |  0.50 |   8   |
+    // | ADD/FADD       | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile neoverse_v2 = {
+        .id = "neoverse_v2",
+        // Sum - ADD/FADD: L=2, TPC=4 → 8
+        .sum_1 = 8,
+        .sum_2 = 8,
+        .sum_4i = 8,
+        .sum_8i = 8,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - FMLA: L=4, TPC=4 → 16
+        .dotproduct_4 = 16,
+        .dotproduct_8 = 16,
+        // Search - FCMP: L=2, TPC=2 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - FMUL: L=3, TPC=4 → 12; MUL: L=4, TPC=2 → 8
+        .multiply_4f = 12,
+        .multiply_8f = 12,
+        .multiply_4i = 8,
+        .multiply_8i = 8,
+        // Divide - FDIV: L=10, TPC=0.2 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - FSQRT: L=9, TPC=0.2 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - SMAX/CMGT/FMAX: L=2, TPC=4 → 8
+        .minmax_1 = 8,
+        .minmax_2 = 8,
+        .minmax_4i = 8,
+        .minmax_8i = 8,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - AND: L=2, TPC=4 → 8
+        .bitwise_1 = 8,
+        .bitwise_2 = 8,
+        .bitwise_4 = 8,
+        .bitwise_8 = 8,
+        // Shift - SHL: L=2, TPC=2 → 4
+        .shift_1 = 4,
+        .shift_2 = 4,
+        .shift_4 = 4,
+        .shift_8 = 4,
+        // Gather - LDR: L=4, TPC=3 → 13
+        .gather_4 = 13,
+        .gather_8 = 13,
+        // Popcount - CNT: L=2, TPC=4 → 8
+        .popcount_4 = 8,
+        .popcount_8 = 8,
+        // CompareExchange - SMAX/CMGT: L=2, TPC=2 → 4
+        .cmpxchg_4 = 4,
+        .cmpxchg_8 = 4,
+        // Convert - SCVTF: L=3, TPC=2 → 6
+        .convert_4 = 6,
+        .convert_8 = 6,
+        // Hash - MADD: L=4, TPC=2 → 8
+        .hash_4 = 8,
+        .hash_8 = 8,
+        // Scan - ADD/FADD: L=2, TPC=2 → 4
+        .scan_4i = 4,
+        .scan_8i = 4,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - X0-X30, V0-V31
+        .gpr_registers = 31,
+        .vector_registers = 32,
+        // Caches - L1D 64 KiB, L2 2 MiB, LLC 36 MiB (Graviton 4)
+        .l1d_kib = 64,
+        .l2_kib = 2048,
+        .llc_kib = 36864,
+    };
+
+    // Arm Neoverse N2 - Source: Arm Neoverse N2 Software Optimization Guide
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | ADD            | Int Add    |    2    |  0.50 |   4   |
+    // | FADD           | FP Add     |    2    |  0.50 |   4   |
+    // | FMLA           | FMA        |    4    |  0.50 |   8   |
+    // | FCMP           | Cmp+Branch |    2    |  0.50 |   4   |
+    // | FMUL           | FP Mul     |    3    |  0.50 |   6   |
+    // | MUL            | Int Mul    |    4    |  1.00 |   4   |
+    // | FDIV           | FP Div     |   10    |  5.00 |   2   |
+    // | FSQRT          | FP Sqrt    |   10    |  6.00 |   2   |
+    // | SMAX/CMGT      | Int MinMax |    2    |  0.50 |   4   |
+    // | FMAX           | FP MinMax  |    2    |  0.50 |   4   |
+    // | AND            | Bitwise    |    2    |  0.50 |   4   |
+    // | SHL            | Shift      |    2    |  1.00 |   2   |
+    // | LDR            | Gather     |    4    |  0.50 |   8   |
+    // | CNT            | Popcount   |    2    |  0.50 |   4   |
+    // | SMAX/CMGT      | Min+Max    |    2    |  1.00 |   2   |
+    // | SCVTF          | Int→FP     |    3    |  1.00 |   3   |
+    // | MADD           | Mul+Xor    |    4    |  1.00 |   4   |
+    // | ADD/FADD       | Add+Store  |    2    |  0.50 |   4   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile neoverse_n2 = {
+        .id = "neoverse_n2",
+        // Sum - ADD/FADD: L=2, TPC=2 → 4
+        .sum_1 = 4,
+        .sum_2 = 4,
+        .sum_4i = 4,
+        .sum_8i = 4,
+        .sum_4f = 4,
+        .sum_8f = 4,
+        // DotProduct - FMLA: L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - FCMP: L=2, TPC=2 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - FMUL: L=3, TPC=2 → 6; MUL: L=4, TPC=1 → 4
+        .multiply_4f = 6,
+        .multiply_8f = 6,
+        .multiply_4i = 4,
+        .multiply_8i = 4,
+        // Divide - FDIV: L=10, TPC=0.2 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - FSQRT: L=10, TPC=0.17 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - SMAX/CMGT/FMAX: L=2, TPC=2 → 4
+        .minmax_1 = 4,
+        .minmax_2 = 4,
+        .minmax_4i = 4,
+        .minmax_8i = 4,
+        .minmax_4f = 4,
+        .minmax_8f = 4,
+        // Bitwise - AND: L=2, TPC=2 → 4
+        .bitwise_1 = 4,
+        .bitwise_2 = 4,
+        .bitwise_4 = 4,
+        .bitwise_8 = 4,
+        // Shift - SHL: L=2, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - LDR: L=4, TPC=2 → 8
+        .gather_4 = 8,
+        .gather_8 = 8,
+        // Popcount - CNT: L=2, TPC=2 → 4
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - SMAX/CMGT: L=2, TPC=1 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - SCVTF: L=3, TPC=1 → 3
+        .convert_4 = 3,
+        .convert_8 = 3,
+        // Hash - MADD: L=4, TPC=1 → 4
+        .hash_4 = 4,
+        .hash_8 = 4,
+        // Scan - ADD/FADD: L=2, TPC=2 → 4
+        .scan_4i = 4,
+        .scan_8i = 4,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - X0-X30, V0-V31
+        .gpr_registers = 31,
+        .vector_registers = 32,
+        // Caches - L1D 64 KiB, L2 1 MiB, LLC 128 MiB (Yitian 710)
+        .l1d_kib = 64,
+        .l2_kib = 1024,
+        .llc_kib = 131072,
+    };
+
+    // Intel Alder Lake (Gracemont E-cores) - Source: https://uops.info
+    //
+    // +----------------+------------+---------+-------+-------+
+    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |
+    // +----------------+------------+---------+-------+-------+
+    // | VPADDB/W/D/Q   | Int Add    |    1    |  0.67 |   2   |
+    // | VADDPS/PD      | FP Add     |    3    |  1.00 |   3   |
+    // | VFMADD231PS/PD | FMA        |    5    |  1.00 |   5   |
+    // | CMP            | Cmp+Branch |    1    |  0.25 |   4   |
+    // | VMULPS/PD      | FP Mul     |    4    |  1.00 |   4   |
+    // | VPMULLD        | Int Mul    |   10    |  2.00 |   5   |
+    // | IMUL           | Int Mul    |    3    |  1.00 |   3   |
+    // | VDIVPS         | FP Div     |   11    | 10.00 |   2   |
+    // | VDIVPD         | FP Div     |   14    | 14.00 |   2   |
+    // | VSQRTPS        | FP Sqrt    |   12    | 12.00 |   2   |
+    // | VSQRTPD        | FP Sqrt    |   18    | 18.00 |   2   |
+    // | VPMAXSB/W/D    | Int MinMax |    1    |  0.67 |   2   |
+    // | VPCMPGTQ       | Int MinMax |    3    |  2.00 |   2   |
+    // | VMAXPS/PD      | FP MinMax  |    3    |  1.00 |   3   |
+    // | VPAND          | Bitwise    |    1    |  0.67 |   2   |
+    // | VPSLLW/D/Q     | Shift      |    1    |  1.00 |   2   |
+    // | VPGATHERDD     | Gather     |   30    |  8.00 |   4   |
+    // | VPGATHERQQ     | Gather     |   25    |  4.00 |   7   |
+    // | POPCNT         | Popcount   |    3    |  1.00 |   3   |
+    // | VPMAXSD        | Min+Max    |    1    |  1.34 |   2   |
+    // | VPCMPGTQ       | Min+Max    |    3    |  4.00 |   2   |
+    // | VCVTDQ2PS      | Int→FP     |    4    |  1.00 |   4   |
+    // | VCVTDQ2PD      | Int→FP     |    6    |  2.00 |   3   |
+    // | IMUL           | Mul+Xor    |    5    |  1.00 |   5   |
+    // | VPADDD/Q       | Add+Store  |    1    |  0.67 |   2   |
+    // | VADDPS/PD      | Add+Store  |    3    |  1.00 |   3   |
+    // +----------------+------------+---------+-------+-------+
+    inline constexpr Profile gracemont = {
+        .id = "gracemont",
+        // Sum - VPADDB/W/D/Q: L=1, TPC=1.5 → 2; VADDPS/PD: L=3, TPC=1 → 3
+        .sum_1 = 2,
+        .sum_2 = 2,
+        .sum_4i = 2,
+        .sum_8i = 2,
+        .sum_4f = 3,
+        .sum_8f = 3,
+        // DotProduct - VFMADD231PS/PD: L=5, TPC=1 → 5
+        .dotproduct_4 = 5,
+        .dotproduct_8 = 5,
+        // Search - CMP: L=1, TPC=4 → 4
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute balanced
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - VMULPS/PD: L=4, TPC=1 → 4; VPMULLD: L=10, TPC=0.5 → 5; IMUL: L=3, TPC=1 → 3
+        .multiply_4f = 4,
+        .multiply_8f = 4,
+        .multiply_4i = 5,
+        .multiply_8i = 3,
+        // Divide - VDIVPS: L=11, TPC=0.1 → 2; VDIVPD: L=14, TPC=0.07 → 2
+        .divide_4f = 2,
+        .divide_8f = 2,
+        // Sqrt - VSQRTPS: L=12, TPC=0.08 → 2; VSQRTPD: L=18, TPC=0.06 → 2
+        .sqrt_4f = 2,
+        .sqrt_8f = 2,
+        // MinMax - VPMAXSB/W/D: L=1, TPC=1.5 → 2; VPCMPGTQ: L=3, TPC=0.5 → 2; VMAXPS/PD: L=3, TPC=1 → 3
+        .minmax_1 = 2,
+        .minmax_2 = 2,
+        .minmax_4i = 2,
+        .minmax_8i = 2,
+        .minmax_4f = 3,
+        .minmax_8f = 3,
+        // Bitwise - VPAND: L=1, TPC=1.5 → 2
+        .bitwise_1 = 2,
+        .bitwise_2 = 2,
+        .bitwise_4 = 2,
+        .bitwise_8 = 2,
+        // Shift - VPSLLW/D/Q: L=1, TPC=1 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - VPGATHERDD: L=30, TPC=0.12 → 4; VPGATHERQQ: L=25, TPC=0.25 → 7
+        .gather_4 = 4,
+        .gather_8 = 7,
+        // Popcount - POPCNT: L=3, TPC=1 → 3
+        .popcount_4 = 3,
+        .popcount_8 = 3,
+        // CompareExchange - VPMAXSD: L=1, TPC=0.75 → 2; VPCMPGTQ: L=3, TPC=0.25 → 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - VCVTDQ2PS: L=4, TPC=1 → 4; VCVTDQ2PD: L=6, TPC=0.5 → 3
+        .convert_4 = 4,
+        .convert_8 = 3,
+        // Hash - IMUL: L=5, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - VPADDD/Q: L=1, TPC=1.5 → 2; VADDPS/PD: L=3, TPC=1 → 3
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 3,
+        .scan_8f = 3,
+        // Registers - RAX-R15, YMM0-15
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - L1D 32 KiB, L2 2 MiB, LLC 30 MiB (Core i9-12900K; L2 per four-core module)
+        .l1d_kib = 32,
+        .l2_kib = 2048,
+        .llc_kib = 30720,
+    };
+
+
+    // Default - conservative cross-platform values
+    inline constexpr Profile default_profile = {
+        .id = "default",
+        // Sum - Integer: conservative L=1, TPC=4 → 4; FP: L=4, TPC=2 → 8
+        .sum_1 = 4,
+        .sum_2 = 4,
+        .sum_4i = 4,
+        .sum_8i = 4,
+        .sum_4f = 8,
+        .sum_8f = 8,
+        // DotProduct - FMA: conservative L=4, TPC=2 → 8
+        .dotproduct_4 = 8,
+        .dotproduct_8 = 8,
+        // Search - conservative N=4 balances ILP benefit vs misprediction cost
+        .search_1 = 4,
+        .search_2 = 4,
+        .search_4 = 4,
+        .search_8 = 4,
+        // Copy - memory bandwidth limited
+        .copy_1 = 8,
+        .copy_2 = 4,
+        .copy_4 = 4,
+        .copy_8 = 4,
+        // Transform - memory + compute
+        .transform_1 = 4,
+        .transform_2 = 4,
+        .transform_4 = 4,
+        .transform_8 = 4,
+        // Multiply - FP: L=4, TPC=2 → 8; Int: conservative 8
+        .multiply_4f = 8,
+        .multiply_8f = 8,
+        .multiply_4i = 8,
+        .multiply_8i = 8,
+        // Divide - conservative
+        .divide_4f = 4,
+        .divide_8f = 4,
+        // Sqrt - conservative
+        .sqrt_4f = 4,
+        .sqrt_8f = 4,
+        // MinMax - Int: 4; FP: 8
+        .minmax_1 = 4,
+        .minmax_2 = 4,
+        .minmax_4i = 4,
+        .minmax_8i = 4,
+        .minmax_4f = 8,
+        .minmax_8f = 8,
+        // Bitwise - L=1, TPC=3 → 4 (conservative)
+        .bitwise_1 = 4,
+        .bitwise_2 = 4,
+        .bitwise_4 = 4,
+        .bitwise_8 = 4,
+        // Shift - L=1, TPC=2 → 2
+        .shift_1 = 2,
+        .shift_2 = 2,
+        .shift_4 = 2,
+        .shift_8 = 2,
+        // Gather - conservative: scalar-load fallbacks and slow microcoded gathers both fit
+        .gather_4 = 4,
+        .gather_8 = 4,
+        // Popcount - L=3, TPC=1 → 3 (conservative 4)
+        .popcount_4 = 4,
+        .popcount_8 = 4,
+        // CompareExchange - min + max on one ALU pair: 2
+        .cmpxchg_4 = 2,
+        .cmpxchg_8 = 2,
+        // Convert - L=4, TPC=1 → 4
+        .convert_4 = 4,
+        .convert_8 = 4,
+        // Hash - Mul L=3 + xor + shift, TPC=1 → 5
+        .hash_4 = 5,
+        .hash_8 = 5,
+        // Scan - store-bound: Int 2; FP 4
+        .scan_4i = 2,
+        .scan_8i = 2,
+        .scan_4f = 4,
+        .scan_8f = 4,
+        // Registers - x86-64 with AVX2 (the smallest common file)
+        .gpr_registers = 16,
+        .vector_registers = 16,
+        // Caches - conservative: L1D 32 KiB, L2 256 KiB, LLC 8 MiB
+        .l1d_kib = 32,
+        .l2_kib = 256,
+        .llc_kib = 8192,
+    };
+
+    // Runtime profile lookup by name
+    inline const Profile& get(std::string_view name) {
+        if (name == "apple_m1" || name == "m1")
+            return apple_m1;
+        if (name == "alderlake" || name == "alder_lake")
+            return alderlake;
+        if (name == "gracemont" || name == "alderlake_e")
+            return gracemont;
+        if (name == "icelake" || name == "ice_lake")
+            return icelake;
+        if (name == "icelake_avx512")
+            return icelake_avx512;
+        if (name == "sapphirerapids" || name == "sapphire_rapids" || name == "spr")
+            return sapphirerapids;
+        if (name == "sapphirerapids_avx512" || name == "spr_avx512")
+            return sapphirerapids_avx512;
+        if (name == "zen4")
+            return zen4;
+        if (name == "zen4_avx512")
+            return zen4_avx512;
+        if (name == "zen5" || name == "zen")
+            return zen5;
+        if (name == "zen5_avx512")
+            return zen5_avx512;
+        if (name == "neoverse_v1" || name == "graviton3")
+            return neoverse_v1;
+        if (name == "neoverse_v1_sve" || name == "graviton3_sve")
+            return neoverse_v1_sve;
+        if (name == "neoverse_v2" || name == "graviton4")
+            return neoverse_v2;
+        if (name == "neoverse_n2")
+            return neoverse_n2;
         if (name == "default")
             return default_profile;
         return skylake; // default fallback
     }
 
+    // GPRs the loop itself keeps busy: stack pointer, index, bound and a data pointer
+    inline constexpr int reserved_gpr_registers = 4;
+
+    // Caps n so that n lanes of live_per_lane values each fit in the register file; past
+    // that the unrolled body spills and runs slower than a smaller N. live_per_lane counts
+    // the values one lane keeps in registers per iteration (accumulators and loaded
+    // operands); 0 means unknown and leaves n alone. Floating point lives in vector
+    // registers, integers in whichever file is smaller since they may be vectorized or not.
+    constexpr int register_capped_N(const Profile& p, int n, int live_per_lane, bool floating_point) {
+        if (live_per_lane <= 0)
+            return n;
+        const int gpr = p.gpr_registers - reserved_gpr_registers;
+        const int regs = floating_point ? p.vector_registers
+                                        : (gpr < p.vector_registers ? gpr : p.vector_registers);
+        const int cap = regs / live_per_lane;
+        if (cap < 1)
+            return 1;
+        return n < cap ? n : cap;
+    }
+
+    // Sibling hyperthreads issue to the same ports, so with both busy each sees about half the
+    // throughput and hides its latencies with half the chains. This is the profile for a
+    // thread sharing its core. Copy and Transform are bounded by memory rather than ports and
+    // keep their N; each hyperthread has its own architectural registers.
+    constexpr Profile shared_core(const Profile& p) {
+        int Profile::* const port_bound[] = {
+            &Profile::sum_1,        &Profile::sum_2,        &Profile::sum_4i,       &Profile::sum_8i,
+            &Profile::sum_4f,       &Profile::sum_8f,       &Profile::dotproduct_4, &Profile::dotproduct_8,
+            &Profile::search_1,     &Profile::search_2,     &Profile::search_4,     &Profile::search_8,
+            &Profile::multiply_4f,  &Profile::multiply_8f,  &Profile::multiply_4i,  &Profile::multiply_8i,
+            &Profile::divide_4f,    &Profile::divide_8f,    &Profile::sqrt_4f,      &Profile::sqrt_8f,
+            &Profile::minmax_1,     &Profile::minmax_2,     &Profile::minmax_4i,    &Profile::minmax_8i,
+            &Profile::minmax_4f,    &Profile::minmax_8f,    &Profile::bitwise_1,    &Profile::bitwise_2,
+            &Profile::bitwise_4,    &Profile::bitwise_8,    &Profile::shift_1,      &Profile::shift_2,
+            &Profile::shift_4,      &Profile::shift_8,      &Profile::gather_4,     &Profile::gather_8,
+            &Profile::popcount_4,   &Profile::popcount_8,   &Profile::cmpxchg_4,    &Profile::cmpxchg_8,
+            &Profile::convert_4,    &Profile::convert_8,    &Profile::hash_4,       &Profile::hash_8,
+            &Profile::scan_4i,      &Profile::scan_8i,      &Profile::scan_4f,      &Profile::scan_8f,
+        };
+        Profile shared = p;
+        for (int Profile::* field : port_bound)
+            shared.*field = (shared.*field + 1) / 2;
+        return shared;
+    }
+
+    // Past the last-level cache every loop waits on DRAM, whose bandwidth per core is a fraction
+    // of what L1 feeds the ports: the shared-core halving already keeps a port-bound loop at
+    // memory speed, and Copy and Transform gain nothing from more than two chains. This is the
+    // profile the _AUTO range loops use for a range larger than the LLC.
+    constexpr Profile streaming(const Profile& p) {
+        int Profile::* const memory_bound[] = {
+            &Profile::copy_1,      &Profile::copy_2,      &Profile::copy_4,      &Profile::copy_8,
+            &Profile::transform_1, &Profile::transform_2, &Profile::transform_4, &Profile::transform_8,
+        };
+        Profile s = shared_core(p);
+        for (int Profile::* field : memory_bound)
+            s.*field = s.*field < 2 ? s.*field : 2;
+        return s;
+    }
+
+    // Data cache sizes in bytes
+    struct CacheSizes {
+        std::size_t l1d, l2, llc;
+    };
+
+    // A profile's cache sizes; cpu::detect_cache_sizes (ilp_topology.hpp) reads the host's
+    constexpr CacheSizes cache_sizes(const Profile& p) {
+        return {std::size_t(p.l1d_kib) * 1024, std::size_t(p.l2_kib) * 1024, std::size_t(p.llc_kib) * 1024};
+    }
+
+    // Vector instruction set the code is compiled for (see ILP_VECTOR_ISA in ilp_cpu.hpp)
+    enum class VectorISA { Scalar, SSE, AVX2, AVX512, NEON, SVE };
+
+    // The CPU profiles above are timed on 256-bit x86 and 128-bit NEON forms, and the x86 base
+    // profiles use only instructions a build without AVX-512 has (IMUL, VPCMPGTQ). Where a part
+    // executes other widths differently (AVX-512 on two ports or double-pumped, SVE on fewer,
+    // wider pipes) or gains instructions (VPMULLQ, VPMAXSQ) it has a variant, and this picks it
+    // for the active ISA.
+    constexpr const Profile& for_isa(const Profile& cpu, VectorISA isa) {
+        if (isa == VectorISA::AVX512) {
+            if (cpu.id == icelake.id)
+                return icelake_avx512;
+            if (cpu.id == sapphirerapids.id)
+                return sapphirerapids_avx512;
+            if (cpu.id == zen4.id)
+                return zen4_avx512;
+            if (cpu.id == zen5.id)
+                return zen5_avx512;
+        }
+        if (isa == VectorISA::SVE && cpu.id == neoverse_v1.id)
+            return neoverse_v1_sve;
+        return cpu;
+    }
+
+    // Whether cpu is a hybrid part (Alder Lake and its Raptor Lake successors pair Golden Cove
+    // P-cores with Gracemont E-cores)
+    constexpr bool is_hybrid(const Profile& cpu) { return cpu.id == alderlake.id; }
+
+    // The E-core profile of a hybrid part, or nullptr where every core is alike
+    constexpr const Profile* efficiency_cores(const Profile& cpu) { return is_hybrid(cpu) ? &gracemont : nullptr; }
+
 } // namespace ilp::cpu
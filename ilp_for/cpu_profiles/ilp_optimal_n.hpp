@@ -5,8 +5,9 @@
 
 #pragma once
 
-// optimal_N computation from CPU profile macros
+// optimal_N computation from a CPU profile
 
+#include <concepts>
 #include <cstddef>
 #include <type_traits>
 
@@ -20,148 +21,206 @@
 namespace ilp {
 
     enum class LoopType {
-        Sum,        // acc += val (VADD)
-        DotProduct, // acc += a * b (VFMA)
-        Search,     // find with early exit
-        Copy,       // dst = src (Load/Store)
-        Transform,  // dst = f(src)
-        Multiply,   // acc *= val (VMUL)
-        Divide,     // val / const (VDIV)
-        Sqrt,       // sqrt(val) (VSQRT)
-        MinMax,     // acc = min/max(acc, val)
-        Bitwise,    // acc &= val, |=, ^=
-        Shift,      // val << n, val >> n
+        Sum,             // acc += val (VADD)
+        DotProduct,      // acc += a * b (VFMA)
+        Search,          // find with early exit
+        Copy,            // dst = src (Load/Store)
+        Transform,       // dst = f(src)
+        Multiply,        // acc *= val (VMUL)
+        Divide,          // val / const (VDIV)
+        Sqrt,            // sqrt(val) (VSQRT)
+        MinMax,          // acc = min/max(acc, val)
+        Bitwise,         // acc &= val, |=, ^=
+        Shift,           // val << n, val >> n
+        Gather,          // acc += src[idx[i]] (VPGATHER*)
+        Popcount,        // acc += popcount(val) (VPOPCNT*/POPCNT)
+        CompareExchange, // lo = min(a, b), hi = max(a, b) (sorting networks)
+        Convert,         // dst = static_cast<float>(val) (VCVT*)
+        Hash,            // h = (h ^ (h >> s)) * k (IMUL + xorshift)
+        Scan,            // dst[i] = acc += val (prefix sum)
     };
 
     namespace detail {
 
-        template<LoopType L, typename T>
+        template<LoopType L, typename T, const ::ilp::cpu::Profile* P>
         constexpr std::size_t compute_optimal_N() {
             constexpr std::size_t size = sizeof(T);
             constexpr bool is_fp = std::is_floating_point_v<T>;
 
             if constexpr (L == LoopType::Sum) {
                 if constexpr (size == 1)
-                    return ILP_N_SUM_1;
+                    return P->sum_1;
                 else if constexpr (size == 2)
-                    return ILP_N_SUM_2;
+                    return P->sum_2;
                 else if constexpr (size == 4 && is_fp)
-                    return ILP_N_SUM_4F;
+                    return P->sum_4f;
                 else if constexpr (size == 4)
-                    return ILP_N_SUM_4I;
+                    return P->sum_4i;
                 else if constexpr (size == 8 && is_fp)
-                    return ILP_N_SUM_8F;
+                    return P->sum_8f;
                 else if constexpr (size == 8)
-                    return ILP_N_SUM_8I;
+                    return P->sum_8i;
                 else
                     return 4;
             } else if constexpr (L == LoopType::DotProduct) {
                 if constexpr (size == 4)
-                    return ILP_N_DOTPRODUCT_4;
+                    return P->dotproduct_4;
                 else if constexpr (size == 8)
-                    return ILP_N_DOTPRODUCT_8;
+                    return P->dotproduct_8;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Search) {
                 if constexpr (size == 1)
-                    return ILP_N_SEARCH_1;
+                    return P->search_1;
                 else if constexpr (size == 2)
-                    return ILP_N_SEARCH_2;
+                    return P->search_2;
                 else if constexpr (size == 4)
-                    return ILP_N_SEARCH_4;
+                    return P->search_4;
                 else if constexpr (size == 8)
-                    return ILP_N_SEARCH_8;
+                    return P->search_8;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Copy) {
                 if constexpr (size == 1)
-                    return ILP_N_COPY_1;
+                    return P->copy_1;
                 else if constexpr (size == 2)
-                    return ILP_N_COPY_2;
+                    return P->copy_2;
                 else if constexpr (size == 4)
-                    return ILP_N_COPY_4;
+                    return P->copy_4;
                 else if constexpr (size == 8)
-                    return ILP_N_COPY_8;
+                    return P->copy_8;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Transform) {
                 if constexpr (size == 1)
-                    return ILP_N_TRANSFORM_1;
+                    return P->transform_1;
                 else if constexpr (size == 2)
-                    return ILP_N_TRANSFORM_2;
+                    return P->transform_2;
                 else if constexpr (size == 4)
-                    return ILP_N_TRANSFORM_4;
+                    return P->transform_4;
                 else if constexpr (size == 8)
-                    return ILP_N_TRANSFORM_8;
+                    return P->transform_8;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Multiply) {
                 // Product reduction: acc *= val
                 // FP: VMULPS/PD, Int: VPMULLD/Q (int multiply has high latency!)
                 if constexpr (size == 4 && is_fp)
-                    return ILP_N_MULTIPLY_4F;
+                    return P->multiply_4f;
                 else if constexpr (size == 4)
-                    return ILP_N_MULTIPLY_4I;
+                    return P->multiply_4i;
                 else if constexpr (size == 8 && is_fp)
-                    return ILP_N_MULTIPLY_8F;
+                    return P->multiply_8f;
                 else if constexpr (size == 8)
-                    return ILP_N_MULTIPLY_8I;
+                    return P->multiply_8i;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Divide) {
                 // Division: VDIVPS/PD - very high latency, low throughput
                 if constexpr (size == 4)
-                    return ILP_N_DIVIDE_4F;
+                    return P->divide_4f;
                 else if constexpr (size == 8)
-                    return ILP_N_DIVIDE_8F;
+                    return P->divide_8f;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Sqrt) {
                 // Square root: VSQRTPS/PD - very high latency, low throughput
                 if constexpr (size == 4)
-                    return ILP_N_SQRT_4F;
+                    return P->sqrt_4f;
                 else if constexpr (size == 8)
-                    return ILP_N_SQRT_8F;
+                    return P->sqrt_8f;
                 else
                     return 4;
             } else if constexpr (L == LoopType::MinMax) {
                 // Min/Max reduction: VMINPS/PD, VPMINS*
                 if constexpr (size == 1)
-                    return ILP_N_MINMAX_1;
+                    return P->minmax_1;
                 else if constexpr (size == 2)
-                    return ILP_N_MINMAX_2;
+                    return P->minmax_2;
                 else if constexpr (size == 4 && is_fp)
-                    return ILP_N_MINMAX_4F;
+                    return P->minmax_4f;
                 else if constexpr (size == 4)
-                    return ILP_N_MINMAX_4I;
+                    return P->minmax_4i;
                 else if constexpr (size == 8 && is_fp)
-                    return ILP_N_MINMAX_8F;
+                    return P->minmax_8f;
                 else if constexpr (size == 8)
-                    return ILP_N_MINMAX_8I;
+                    return P->minmax_8i;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Bitwise) {
                 // Bitwise ops: VPAND/POR/PXOR - very fast, 3 ports
                 if constexpr (size == 1)
-                    return ILP_N_BITWISE_1;
+                    return P->bitwise_1;
                 else if constexpr (size == 2)
-                    return ILP_N_BITWISE_2;
+                    return P->bitwise_2;
                 else if constexpr (size == 4)
-                    return ILP_N_BITWISE_4;
+                    return P->bitwise_4;
                 else if constexpr (size == 8)
-                    return ILP_N_BITWISE_8;
+                    return P->bitwise_8;
                 else
                     return 4;
             } else if constexpr (L == LoopType::Shift) {
                 // Shift ops: VPSLL/SRL - 2 ports
                 if constexpr (size == 1)
-                    return ILP_N_SHIFT_1;
+                    return P->shift_1;
                 else if constexpr (size == 2)
-                    return ILP_N_SHIFT_2;
+                    return P->shift_2;
                 else if constexpr (size == 4)
-                    return ILP_N_SHIFT_4;
+                    return P->shift_4;
                 else if constexpr (size == 8)
-                    return ILP_N_SHIFT_8;
+                    return P->shift_8;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::Gather) {
+                // Indexed loads: VPGATHERDD/QQ - long latency, microcoded on some cores
+                if constexpr (size == 4)
+                    return P->gather_4;
+                else if constexpr (size == 8)
+                    return P->gather_8;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::Popcount) {
+                // Bit count: VPOPCNTD/Q, or scalar POPCNT without AVX-512 VPOPCNTDQ
+                if constexpr (size == 8)
+                    return P->popcount_8;
+                else if constexpr (size <= 4)
+                    return P->popcount_4;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::CompareExchange) {
+                // Min + max pair: two issues on the MinMax ports per element
+                if constexpr (size == 8)
+                    return P->cmpxchg_8;
+                else if constexpr (size <= 4)
+                    return P->cmpxchg_4;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::Convert) {
+                // Int to FP conversion: VCVTDQ2PS/PD - T is the converted-to type
+                if constexpr (size == 4)
+                    return P->convert_4;
+                else if constexpr (size == 8)
+                    return P->convert_8;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::Hash) {
+                // Multiply-xorshift round: IMUL latency plus the xor and shift on the chain
+                if constexpr (size == 8)
+                    return P->hash_8;
+                else if constexpr (size <= 4)
+                    return P->hash_4;
+                else
+                    return 4;
+            } else if constexpr (L == LoopType::Scan) {
+                // Prefix sum: the add chain, capped by one store per element
+                if constexpr (size == 4 && is_fp)
+                    return P->scan_4f;
+                else if constexpr (size <= 4 && !is_fp)
+                    return P->scan_4i;
+                else if constexpr (size == 8 && is_fp)
+                    return P->scan_8f;
+                else if constexpr (size == 8)
+                    return P->scan_8i;
                 else
                     return 4;
             } else {
@@ -171,8 +230,189 @@ namespace ilp {
 
     } // namespace detail
 
+    // Cost of one link of a custom loop type's dependency chain, as a profile would give it
+    struct LoopCost {
+        double latency;        // cycles from input ready to output ready
+        double per_cycle;      // independent links started per cycle (1 / reciprocal throughput)
+        int live_per_lane = 0; // registers one lane keeps live; 0 if unknown
+        bool vector = true;    // lives in vector registers; false for general-purpose ones
+    };
+
+    // A user-defined loop type: an empty tag with static constexpr LoopCost cost(const cpu::Profile&).
+    // Pass it wherever a LoopType goes (optimal_N<QuatMul{}, Quat>), or register it by name for
+    // the _AUTO macros with ILP_REGISTER_LOOP_TYPE.
+    template<typename Tag>
+    concept CustomLoopType = std::is_empty_v<Tag> && requires(const ::ilp::cpu::Profile& p) {
+        { Tag::cost(p) } -> std::convertible_to<LoopCost>;
+    };
+
+    // What optimal_N and the _auto loops accept: a built-in LoopType or a custom tag
+    template<typename K>
+    concept LoopKind = std::same_as<K, LoopType> || CustomLoopType<K>;
+
+    namespace detail {
+
+        // N = L x TPC, rounded up and clamped to 1..16 like the generated profiles
+        constexpr std::size_t cost_N(const LoopCost& c) {
+            const double lanes = c.latency * c.per_cycle;
+            const auto n = static_cast<std::size_t>(lanes);
+            const std::size_t up = static_cast<double>(n) < lanes ? n + 1 : n;
+            return up < 1 ? 1 : (up > 16 ? 16 : up);
+        }
+
+        // Uncapped N for one loop kind
+        template<auto L, typename T, const ::ilp::cpu::Profile* P>
+        constexpr std::size_t kind_N() {
+            if constexpr (CustomLoopType<decltype(L)>)
+                return cost_N(decltype(L)::cost(*P));
+            else
+                return compute_optimal_N<L, T, P>();
+        }
+
+        // optimal_N on profile P
+        template<auto L, typename T, std::size_t LivePerLane, const ::ilp::cpu::Profile* P>
+        constexpr std::size_t capped_N() {
+            int live = static_cast<int>(LivePerLane);
+            bool vector = std::is_floating_point_v<T>;
+            if constexpr (CustomLoopType<decltype(L)>) {
+                constexpr LoopCost c = decltype(L)::cost(*P);
+                live = live ? live : c.live_per_lane;
+                vector = c.vector;
+            }
+            return static_cast<std::size_t>(
+                ::ilp::cpu::register_capped_N(*P, static_cast<int>(kind_N<L, T, P>()), live, vector));
+        }
+
+    } // namespace detail
+
     // Primary template: type-aware optimal_N
-    template<LoopType L, typename T>
-    inline constexpr std::size_t optimal_N = detail::compute_optimal_N<L, T>();
+    // LivePerLane is an optional register cost hint: the values one lane keeps live per
+    // iteration (accumulators plus loaded operands). Given one, N is capped so the unrolled
+    // block fits the profile's register file without spilling. A custom loop type's own
+    // live_per_lane is used when no hint is given.
+    template<auto L, typename T, std::size_t LivePerLane = 0>
+        requires LoopKind<decltype(L)>
+    inline constexpr std::size_t optimal_N = detail::capped_N<L, T, LivePerLane, &ILP_CPU_PROFILE>();
+
+    namespace detail {
+
+        // Registers one lane of a loop kind keeps live: built-in classes that carry a value from
+        // one iteration to the next cost one, custom types what their cost says
+        template<auto L, const ::ilp::cpu::Profile* P>
+        constexpr int kind_live() {
+            if constexpr (CustomLoopType<decltype(L)>) {
+                return decltype(L)::cost(*P).live_per_lane;
+            } else {
+                return L == LoopType::Sum || L == LoopType::DotProduct || L == LoopType::Multiply ||
+                               L == LoopType::MinMax || L == LoopType::Bitwise || L == LoopType::Popcount ||
+                               L == LoopType::Hash || L == LoopType::Scan
+                           ? 1
+                           : 0;
+            }
+        }
+
+        template<auto L, typename T, const ::ilp::cpu::Profile* P>
+        constexpr bool kind_vector() {
+            if constexpr (CustomLoopType<decltype(L)>)
+                return decltype(L)::cost(*P).vector;
+            else
+                return std::is_floating_point_v<T>;
+        }
+
+        // The longest chain sets N: every class's chain must be hidden, and classes on separate
+        // ports run side by side. Splitting N by the classes sharing a port group looks right on
+        // paper but measured slower (bench_mixed), so ports only matter through the register
+        // file: the classes' live values share it, capped as for optimal_N's LivePerLane.
+        template<const ::ilp::cpu::Profile* P, typename T, auto L, auto... More>
+        constexpr std::size_t compute_optimal_N_for() {
+            if constexpr (sizeof...(More) == 0) {
+                return capped_N<L, T, 0, P>();
+            } else {
+                std::size_t longest = kind_N<L, T, P>();
+                ((longest = kind_N<More, T, P>() > longest ? kind_N<More, T, P>() : longest), ...);
+                constexpr int live = kind_live<L, P>() + (0 + ... + kind_live<More, P>());
+                constexpr bool vector = kind_vector<L, T, P>() || (false || ... || kind_vector<More, T, P>());
+                return static_cast<std::size_t>(
+                    ::ilp::cpu::register_capped_N(*P, static_cast<int>(longest), live, vector));
+            }
+        }
+
+    } // namespace detail
+
+    // optimal_N for a body mixing several operation classes, e.g. a search that also sums.
+    // With a single loop kind this is optimal_N<L, T>.
+    template<typename T, auto L, auto... More>
+        requires LoopKind<decltype(L)> && (LoopKind<decltype(More)> && ...)
+    inline constexpr std::size_t optimal_N_for = detail::compute_optimal_N_for<&ILP_CPU_PROFILE, T, L, More...>();
+
+    // optimal_N_for on a profile other than the one selected at compile time, e.g. the E-core
+    // profile of a hybrid part: optimal_N_on<cpu::gracemont, float, LoopType::Sum>
+    template<const cpu::Profile& P, typename T, auto L, auto... More>
+        requires LoopKind<decltype(L)> && (LoopKind<decltype(More)> && ...)
+    inline constexpr std::size_t optimal_N_on = detail::compute_optimal_N_for<&P, T, L, More...>();
+
+    namespace detail {
+
+        // optimal_N_for on the E-cores of a hybrid part, or 0 if the selected CPU has none
+        template<typename T, auto L, auto... More>
+        constexpr std::size_t compute_efficiency_N_for() {
+            // Tested through is_hybrid: comparing the constant pointer itself trips -Waddress
+            if constexpr (!::ilp::cpu::is_hybrid(ILP_CPU_PROFILE)) {
+                return 0;
+            } else {
+                constexpr const ::ilp::cpu::Profile* e = ::ilp::cpu::efficiency_cores(ILP_CPU_PROFILE);
+                return compute_optimal_N_for<e, T, L, More...>();
+            }
+        }
+
+        template<typename T, auto L, auto... More>
+        inline constexpr std::size_t efficiency_N_for = compute_efficiency_N_for<T, L, More...>();
+
+        template<const ::ilp::cpu::Profile* P>
+        inline constexpr ::ilp::cpu::Profile shared_core_profile = ::ilp::cpu::shared_core(*P);
+
+        // optimal_N_for when a busy sibling hyperthread shares the core's ports
+        template<typename T, auto L, auto... More>
+        inline constexpr std::size_t shared_core_N_for =
+            compute_optimal_N_for<&shared_core_profile<&ILP_CPU_PROFILE>, T, L, More...>();
+
+        template<const ::ilp::cpu::Profile* P>
+        inline constexpr ::ilp::cpu::Profile streaming_profile = ::ilp::cpu::streaming(*P);
+
+        // optimal_N_for over data larger than the last-level cache
+        template<typename T, auto L, auto... More>
+        inline constexpr std::size_t streaming_N_for =
+            compute_optimal_N_for<&streaming_profile<&ILP_CPU_PROFILE>, T, L, More...>();
+
+    } // namespace detail
+
+    // Names the _AUTO macros resolve a loop type through; ILP_REGISTER_LOOP_TYPE adds custom ones
+    namespace loop_types {
+        inline constexpr LoopType Sum = LoopType::Sum;
+        inline constexpr LoopType DotProduct = LoopType::DotProduct;
+        inline constexpr LoopType Search = LoopType::Search;
+        inline constexpr LoopType Copy = LoopType::Copy;
+        inline constexpr LoopType Transform = LoopType::Transform;
+        inline constexpr LoopType Multiply = LoopType::Multiply;
+        inline constexpr LoopType Divide = LoopType::Divide;
+        inline constexpr LoopType Sqrt = LoopType::Sqrt;
+        inline constexpr LoopType MinMax = LoopType::MinMax;
+        inline constexpr LoopType Bitwise = LoopType::Bitwise;
+        inline constexpr LoopType Shift = LoopType::Shift;
+        inline constexpr LoopType Gather = LoopType::Gather;
+        inline constexpr LoopType Popcount = LoopType::Popcount;
+        inline constexpr LoopType CompareExchange = LoopType::CompareExchange;
+        inline constexpr LoopType Convert = LoopType::Convert;
+        inline constexpr LoopType Hash = LoopType::Hash;
+        inline constexpr LoopType Scan = LoopType::Scan;
+    } // namespace loop_types
 
 } // namespace ilp
+
+// Makes a custom loop type usable by name in the _AUTO macros: ILP_REGISTER_LOOP_TYPE(QuatMul, mylib::QuatMul)
+// then ILP_FOR_AUTO(auto i, std::size_t{0}, n, QuatMul, Quat). Use at global scope.
+#define ILP_REGISTER_LOOP_TYPE(name, tag)                                                                              \
+    namespace ilp::loop_types {                                                                                        \
+        static_assert(::ilp::CustomLoopType<tag>, #tag " needs static constexpr ilp::LoopCost cost(const Profile&)"); \
+        inline constexpr tag name{};                                                                                   \
+    }
@@ -0,0 +1,461 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+// Runtime view of the core a thread is running on, for the profiles that differ by core.
+// Included by ilp_cpu.hpp when -DILP_HYBRID_CORES or -DILP_SMT_AWARE is set; the _AUTO loops
+// then carry one instantiation per core type, or per full and shared core, and pick one per
+// call (see ilp::detail::with_auto_N). With -DILP_DETECT_CACHES the _AUTO range loops compare
+// against the host's last-level cache rather than the profile's (see detect_cache_sizes).
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ilp_cpu_profiles.hpp"
+
+#if defined(__linux__)
+#define ILP_HAS_SCHED_GETCPU 1
+#include <sched.h>
+#else
+#define ILP_HAS_SCHED_GETCPU 0
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ILP_HAS_CPUID 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define ILP_HAS_CPUID 0
+#endif
+
+// How often SmtPolicy::SiblingLoad samples /proc/stat, in milliseconds. Override with
+// -DILP_SMT_LOAD_INTERVAL_MS=N.
+#ifndef ILP_SMT_LOAD_INTERVAL_MS
+#define ILP_SMT_LOAD_INTERVAL_MS 100
+#endif
+
+namespace ilp::cpu {
+
+    // P-cores and E-cores of a hybrid part; every core of a uniform part is a Performance core
+    enum class CoreType { Performance, Efficiency };
+
+    namespace detail {
+
+        // CPU numbers in a sysfs list such as "0-7,16,18-19", as a membership mask
+        inline std::vector<bool> parse_cpu_list(std::string_view list) {
+            std::vector<bool> cpus;
+            while (!list.empty()) {
+                const std::size_t comma = list.find(',');
+                const std::string_view item = list.substr(0, comma);
+                list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+                std::size_t lo = 0, hi = 0;
+                bool range = false, digits = false;
+                for (char c : item) {
+                    if (c >= '0' && c <= '9') {
+                        (range ? hi : lo) = (range ? hi : lo) * 10 + static_cast<std::size_t>(c - '0');
+                        digits = true;
+                    } else if (c == '-' && !range) {
+                        range = true;
+                    } else if (c != ' ' && c != '\n') {
+                        return {}; // not a CPU list
+                    }
+                }
+                if (!digits)
+                    continue;
+                if (!range)
+                    hi = lo;
+                if (hi < lo || hi > 4095)
+                    return {};
+                if (cpus.size() <= hi)
+                    cpus.resize(hi + 1);
+                for (std::size_t cpu = lo; cpu <= hi; ++cpu)
+                    cpus[cpu] = true;
+            }
+            return cpus;
+        }
+
+        // First line of a sysfs file, or "" if it can't be read
+        inline std::string read_sysfs_line(const char* path) {
+            std::ifstream in(path);
+            std::string line;
+            if (in)
+                std::getline(in, line);
+            return line;
+        }
+
+        // E-cores as the kernel lists them: Linux exposes each core type of an Intel hybrid
+        // part as its own PMU, with the CPUs it covers in /sys/devices/cpu_atom/cpus. Empty on
+        // uniform parts and off Linux.
+        inline const std::vector<bool>& sysfs_atom_cpus() {
+            static const std::vector<bool> cpus = parse_cpu_list(read_sysfs_line("/sys/devices/cpu_atom/cpus"));
+            return cpus;
+        }
+
+#if ILP_HAS_CPUID
+        // EAX, EBX, ECX and EDX of CPUID leaf/subleaf on the core that executes it
+        inline void cpuid(unsigned leaf, unsigned subleaf, unsigned (&r)[4]) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int regs[4];
+            __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int i = 0; i < 4; ++i)
+                r[i] = static_cast<unsigned>(regs[i]);
+#else
+            __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+        }
+
+        // Highest leaf of the basic (0) or extended (0x80000000) range
+        inline unsigned cpuid_max(unsigned range) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned r[4] = {};
+            cpuid(range, 0, r);
+            return r[0];
+#else
+            return __get_cpuid_max(range, nullptr);
+#endif
+        }
+#endif
+
+        // CPUID leaf 0x1A on whichever core executes it: EAX[31:24] is 0x20 on an Atom (E) core
+        // and 0x40 on a Core (P) one. The leaf is only defined when CPUID.07H:EDX[15] flags a
+        // hybrid part. False if the answer isn't available.
+        inline bool cpuid_core_type(CoreType& out) noexcept {
+#if ILP_HAS_CPUID
+            unsigned r[4] = {};
+            if (cpuid_max(0) < 0x1A)
+                return false;
+            cpuid(7, 0, r);
+            if (!(r[3] & (1u << 15)))
+                return false;
+            cpuid(0x1A, 0, r);
+            const unsigned type = r[0] >> 24;
+            if (type != 0x20 && type != 0x40)
+                return false;
+            out = type == 0x20 ? CoreType::Efficiency : CoreType::Performance;
+            return true;
+#else
+            (void)out;
+            return false;
+#endif
+        }
+
+        // Core type of `cpu` (-1 if unknown, meaning the one running this thread): the sysfs
+        // list where there is one, else CPUID on the current core
+        inline CoreType detect_core_type(int cpu) {
+            const std::vector<bool>& atom = sysfs_atom_cpus();
+            if (!atom.empty() && cpu >= 0)
+                return static_cast<std::size_t>(cpu) < atom.size() && atom[static_cast<std::size_t>(cpu)]
+                           ? CoreType::Efficiency
+                           : CoreType::Performance;
+            CoreType type = CoreType::Performance;
+            cpuid_core_type(type);
+            return type;
+        }
+
+        // The last detection on this thread and the CPU it was made on
+        struct core_type_cache {
+            int cpu = -2; // -2: not detected yet; -1: detected where the CPU can't be read
+            CoreType type = CoreType::Performance;
+        };
+
+        inline core_type_cache& thread_core_type() noexcept {
+            thread_local core_type_cache cache;
+            return cache;
+        }
+
+        // CPU the calling thread is on, or -1 where that can't be read cheaply
+        inline int current_cpu() noexcept {
+#if ILP_HAS_SCHED_GETCPU
+            return ::sched_getcpu();
+#else
+            return -1;
+#endif
+        }
+
+    } // namespace detail
+
+    // Type of the core the calling thread is running on. Cached per thread and keyed on the
+    // CPU number, so a migration to another core detects again; sched_getcpu() is a vDSO read
+    // on Linux. Elsewhere the CPU can't be read cheaply and a thread keeps its first answer.
+    inline CoreType current_core_type() {
+        detail::core_type_cache& cache = detail::thread_core_type();
+        const int cpu = detail::current_cpu();
+        if (cpu != cache.cpu) {
+            cache.type = detail::detect_core_type(cpu);
+            cache.cpu = cpu;
+        }
+        return cache.type;
+    }
+
+    // When the _AUTO loops take the shared-core N (see shared_core) on a core with SMT:
+    // FullCore never, SharedCore whenever the core has a sibling hyperthread (the default, for
+    // hosts that keep every hardware thread busy), SiblingLoad when a sibling was busy over
+    // the last ILP_SMT_LOAD_INTERVAL_MS
+    enum class SmtPolicy { FullCore, SharedCore, SiblingLoad };
+
+    // Busy fraction above which SiblingLoad counts a sibling as competing for the ports
+    inline constexpr double sibling_busy_load = 0.5;
+
+    namespace detail {
+
+        // Sibling hyperthreads of each CPU from /sys/devices/system/cpu/cpuN/topology, the CPU
+        // itself left out. Every list is empty with SMT off, and the table is empty off Linux.
+        inline const std::vector<std::vector<int>>& smt_siblings() {
+            static const std::vector<std::vector<int>> table = [] {
+                std::vector<std::vector<int>> siblings;
+                if (read_sysfs_line("/sys/devices/system/cpu/smt/active") == "0")
+                    return siblings;
+                const std::vector<bool> cpus = parse_cpu_list(read_sysfs_line("/sys/devices/system/cpu/possible"));
+                siblings.resize(cpus.size());
+                for (std::size_t cpu = 0; cpu < cpus.size(); ++cpu) {
+                    if (!cpus[cpu])
+                        continue;
+                    const std::string path =
+                        "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list";
+                    const std::vector<bool> mask = parse_cpu_list(read_sysfs_line(path.c_str()));
+                    for (std::size_t other = 0; other < mask.size(); ++other)
+                        if (mask[other] && other != cpu)
+                            siblings[cpu].push_back(static_cast<int>(other));
+                }
+                return siblings;
+            }();
+            return table;
+        }
+
+        // One "cpuN user nice system idle iowait irq softirq steal ..." line of /proc/stat as
+        // jiffies busy and in total. False for the aggregate "cpu" line and anything else.
+        inline bool parse_proc_stat_line(std::string_view line, int& cpu, unsigned long long& busy,
+                                         unsigned long long& total) {
+            if (line.size() < 4 || line.substr(0, 3) != "cpu" || line[3] < '0' || line[3] > '9')
+                return false;
+            std::size_t i = 3;
+            cpu = 0;
+            while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                cpu = cpu * 10 + (line[i++] - '0');
+            unsigned long long fields[8] = {};
+            for (auto& field : fields) {
+                while (i < line.size() && line[i] == ' ')
+                    ++i;
+                if (i == line.size() || line[i] < '0' || line[i] > '9')
+                    return false;
+                while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                    field = field * 10 + static_cast<unsigned long long>(line[i++] - '0');
+            }
+            total = 0;
+            for (unsigned long long field : fields)
+                total += field;
+            busy = total - fields[3] - fields[4]; // less idle and iowait
+            return true;
+        }
+
+        // Per-CPU load over the last sampling interval, shared by every thread. Whichever thread
+        // finds the sample stale re-reads /proc/stat; the others keep using the last one.
+        struct cpu_load_sampler {
+            std::mutex refresh_lock;
+            std::atomic<std::chrono::steady_clock::rep> next{0};
+            std::vector<unsigned long long> busy, total; // jiffies at the last sample
+            std::vector<std::atomic<float>> load;        // busy fraction, 1 until measured
+
+            explicit cpu_load_sampler(std::size_t cpus) : busy(cpus), total(cpus), load(cpus) {
+                for (auto& l : load)
+                    l.store(1.0f, std::memory_order_relaxed);
+            }
+
+            void refresh() {
+                const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+                if (now < next.load(std::memory_order_relaxed))
+                    return;
+                std::unique_lock lock(refresh_lock, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return;
+                const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::milliseconds(ILP_SMT_LOAD_INTERVAL_MS));
+                next.store(now + interval.count(), std::memory_order_relaxed);
+
+                std::ifstream in("/proc/stat");
+                std::string line;
+                while (std::getline(in, line)) {
+                    int cpu = 0;
+                    unsigned long long b = 0, t = 0;
+                    if (!parse_proc_stat_line(line, cpu, b, t) || static_cast<std::size_t>(cpu) >= load.size())
+                        continue;
+                    const auto c = static_cast<std::size_t>(cpu);
+                    if (total[c] != 0 && t > total[c])
+                        load[c].store(static_cast<float>(b - busy[c]) / static_cast<float>(t - total[c]),
+                                      std::memory_order_relaxed);
+                    busy[c] = b;
+                    total[c] = t;
+                }
+            }
+
+            bool any_busy(const std::vector<int>& cpus) const {
+                for (int cpu : cpus)
+                    if (load[static_cast<std::size_t>(cpu)].load(std::memory_order_relaxed) > sibling_busy_load)
+                        return true;
+                return false;
+            }
+        };
+
+        inline cpu_load_sampler& cpu_loads() {
+            static cpu_load_sampler sampler(smt_siblings().size());
+            return sampler;
+        }
+
+        inline std::atomic<SmtPolicy>& smt_policy_setting() noexcept {
+            static std::atomic<SmtPolicy> policy{SmtPolicy::SharedCore};
+            return policy;
+        }
+
+    } // namespace detail
+
+    // Process-wide; takes effect on each thread's next _AUTO loop
+    inline void set_smt_policy(SmtPolicy policy) noexcept {
+        detail::smt_policy_setting().store(policy, std::memory_order_relaxed);
+    }
+
+    inline SmtPolicy smt_policy() noexcept { return detail::smt_policy_setting().load(std::memory_order_relaxed); }
+
+    // Whether the calling thread should use the shared-core N: its core has a sibling
+    // hyperthread and the SMT policy counts that sibling as competing. False where the
+    // topology can't be read (off Linux).
+    inline bool core_is_shared() {
+        const SmtPolicy policy = smt_policy();
+        if (policy == SmtPolicy::FullCore)
+            return false;
+        const int cpu = detail::current_cpu();
+        const auto& siblings = detail::smt_siblings();
+        if (cpu < 0 || static_cast<std::size_t>(cpu) >= siblings.size())
+            return false;
+        const std::vector<int>& mine = siblings[static_cast<std::size_t>(cpu)];
+        if (mine.empty())
+            return false;
+        if (policy == SmtPolicy::SharedCore)
+            return true;
+        detail::cpu_load_sampler& loads = detail::cpu_loads();
+        loads.refresh();
+        return loads.any_busy(mine);
+    }
+
+    namespace detail {
+
+        // A sysfs cache size such as "48K", "2048K" or "300M" in bytes, or 0 if malformed
+        inline std::size_t parse_cache_size(std::string_view text) {
+            std::size_t size = 0;
+            std::size_t i = 0;
+            for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+                size = size * 10 + static_cast<std::size_t>(text[i] - '0');
+            if (i == 0)
+                return 0;
+            switch (i < text.size() ? text[i] : '\n') {
+            case 'K':
+                return size << 10;
+            case 'M':
+                return size << 20;
+            case 'G':
+                return size << 30;
+            case '\n':
+                return size;
+            default:
+                return 0;
+            }
+        }
+
+        // Data and unified caches of CPU 0 from /sys/devices/system/cpu/cpu0/cache; the LLC is
+        // the highest level listed. False if Linux doesn't expose them.
+        inline bool sysfs_cache_sizes(CacheSizes& out) {
+            CacheSizes found{};
+            int top = 0;
+            for (int index = 0;; ++index) {
+                const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+                const std::string type = read_sysfs_line((dir + "type").c_str());
+                if (type.empty())
+                    break;
+                if (type == "Instruction")
+                    continue;
+                const int level = std::atoi(read_sysfs_line((dir + "level").c_str()).c_str());
+                const std::size_t size = parse_cache_size(read_sysfs_line((dir + "size").c_str()));
+                if (level == 1)
+                    found.l1d = size;
+                else if (level == 2)
+                    found.l2 = size;
+                if (level >= top) {
+                    top = level;
+                    found.llc = size;
+                }
+            }
+            if (found.l1d == 0 || found.llc == 0)
+                return false;
+            out = found;
+            return true;
+        }
+
+        // Deterministic cache parameters: CPUID leaf 4 on Intel, 0x8000001D on AMD. Each subleaf
+        // is one cache, (ways x partitions x line size x sets) bytes. False if neither leaf is
+        // there.
+        inline bool cpuid_cache_sizes(CacheSizes& out) noexcept {
+#if ILP_HAS_CPUID
+            for (unsigned leaf : {4u, 0x8000001Du}) {
+                if (cpuid_max(leaf & 0x80000000u) < leaf)
+                    continue;
+                CacheSizes found{};
+                unsigned top = 0;
+                for (unsigned sub = 0; sub < 16; ++sub) {
+                    unsigned r[4] = {};
+                    cpuid(leaf, sub, r);
+                    const unsigned type = r[0] & 0x1F; // 1 data, 2 instruction, 3 unified
+                    const unsigned level = (r[0] >> 5) & 0x7;
+                    if (type == 0)
+                        break;
+                    if (type == 2)
+                        continue;
+                    const std::size_t size = std::size_t((r[1] >> 22) + 1) * (((r[1] >> 12) & 0x3FF) + 1) *
+                                             ((r[1] & 0xFFF) + 1) * (std::size_t(r[2]) + 1);
+                    if (level == 1)
+                        found.l1d = size;
+                    else if (level == 2)
+                        found.l2 = size;
+                    if (level >= top) {
+                        top = level;
+                        found.llc = size;
+                    }
+                }
+                if (found.l1d != 0 && found.llc != 0) {
+                    out = found;
+                    return true;
+                }
+            }
+#else
+            (void)out;
+#endif
+            return false;
+        }
+
+    } // namespace detail
+
+    // The host's data caches: sysfs where Linux lists them, else CPUID. Sizes that can't be
+    // read are 0. Detected once per process.
+    inline const CacheSizes& detect_cache_sizes() {
+        static const CacheSizes sizes = [] {
+            CacheSizes s{};
+            if (!detail::sysfs_cache_sizes(s))
+                detail::cpuid_cache_sizes(s);
+            return s;
+        }();
+        return sizes;
+    }
+
+} // namespace ilp::cpu
@@ -22,4 +22,14 @@ namespace ilp::arch {
     inline constexpr std::size_t sbo_size = max_integral_size;
 #endif
 
+/// Cache line size in bytes: 128 on Apple silicon, 64 elsewhere.
+/// Override with -DILP_CACHE_LINE=N if needed.
+#ifdef ILP_CACHE_LINE
+    inline constexpr std::size_t cache_line = ILP_CACHE_LINE;
+#elif defined(__APPLE__) && defined(__aarch64__)
+    inline constexpr std::size_t cache_line = 128;
+#else
+    inline constexpr std::size_t cache_line = 64;
+#endif
+
 } // namespace ilp::arch
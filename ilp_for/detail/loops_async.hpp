@@ -0,0 +1,336 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "ctrl.hpp"
+#include "loops_common.hpp"
+#include "loops_coro.hpp"
+
+namespace ilp {
+
+    // Anything that can queue a coroutine for later resumption and run queued work.
+    // sync_wait() drives one of these until the awaited task finishes.
+    template<typename E>
+    concept Executor = requires(E& e, std::coroutine_handle<> h) {
+        e.post(h);
+        { e.run_one() } -> std::convertible_to<bool>;
+    };
+
+    // Single-threaded FIFO executor
+    class RunQueue {
+      public:
+        void post(std::coroutine_handle<> h) { ready_.push_back(h); }
+
+        // Resume the oldest queued coroutine; false if there was nothing to run
+        bool run_one() {
+            if (ready_.empty())
+                return false;
+            auto h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+            return true;
+        }
+
+        bool empty() const noexcept { return ready_.empty(); }
+
+      private:
+        std::deque<std::coroutine_handle<>> ready_;
+    };
+
+    // co_await ilp::schedule(ex) - suspend and continue from the executor's queue
+    template<Executor E>
+    struct ScheduleAwaiter {
+        E& executor;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { executor.post(h); }
+        void await_resume() const noexcept {}
+    };
+
+    template<Executor E>
+    ScheduleAwaiter<E> schedule(E& ex) noexcept {
+        return ScheduleAwaiter<E>{ex};
+    }
+
+    namespace detail {
+
+        // Resumes whoever awaited the task (symmetric transfer, no stack growth)
+        struct task_final_awaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) const noexcept {
+                if (auto next = h.promise().continuation)
+                    return next;
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        struct task_promise_base {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr error;
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            task_final_awaiter final_suspend() noexcept { return {}; }
+            void unhandled_exception() noexcept { error = std::current_exception(); }
+
+            void rethrow_if_error() {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        };
+
+        template<typename T>
+        struct task_promise_result : task_promise_base {
+            std::optional<T> value;
+
+            template<typename U = T>
+            void return_value(U&& v) {
+                value.emplace(std::forward<U>(v));
+            }
+
+            T result() {
+                rethrow_if_error();
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct task_promise_result<void> : task_promise_base {
+            void return_void() noexcept {}
+            void result() { rethrow_if_error(); }
+        };
+
+        [[noreturn]] inline void sync_wait_deadlock_error() {
+            std::fprintf(stderr, "\n*** ILP_FOR ERROR ***\n"
+                                 "sync_wait: the executor ran out of work before the task finished.\n"
+                                 "Something the task awaits never posted its continuation.\n\n");
+            std::abort();
+        }
+
+    } // namespace detail
+
+    template<typename T = void>
+    class [[nodiscard]] Task;
+
+    template<typename T, Executor E>
+    T sync_wait(E& ex, Task<T> task);
+
+    // Lazily started, single-awaiter coroutine
+    template<typename T>
+    class [[nodiscard]] Task {
+      public:
+        struct promise_type : detail::task_promise_result<T> {
+            Task get_return_object() noexcept {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        Task(Task&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+        Task& operator=(Task&&) = delete;
+        ~Task() {
+            if (h_)
+                h_.destroy();
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            h_.promise().continuation = awaiting;
+            return h_;
+        }
+
+        T await_resume() { return h_.promise().result(); }
+
+      private:
+        template<typename U, Executor E>
+        friend U sync_wait(E& ex, Task<U> task);
+
+        explicit Task(handle_type h) noexcept : h_(h) {}
+        handle_type h_;
+    };
+
+    // Run task to completion on the calling thread, draining ex while it is suspended
+    template<typename T, Executor E>
+    T sync_wait(E& ex, Task<T> task) {
+        task.h_.resume();
+        while (!task.h_.done()) {
+            if (!ex.run_one())
+                detail::sync_wait_deadlock_error();
+        }
+        return task.h_.promise().result();
+    }
+
+    namespace detail {
+
+        // Join counter for one block of bodies. The last one to finish resumes the driver.
+        struct async_group {
+            std::atomic<std::size_t> pending{0};
+            std::coroutine_handle<> waiter;
+        };
+
+    } // namespace detail
+
+    // Return type of an ILP_FOR_ASYNC body. Lazily started; the driver owns the frame.
+    class AsyncBody {
+      public:
+        struct promise_type {
+            detail::async_group* group = nullptr;
+            std::exception_ptr error;
+
+            struct final_awaiter {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) const noexcept {
+                    detail::async_group* g = h.promise().group;
+                    if (g->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        return g->waiter;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            AsyncBody get_return_object() noexcept {
+                return AsyncBody{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            final_awaiter final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { error = std::current_exception(); }
+
+            static void* operator new(std::size_t n) { return detail::coro_frame_alloc(n); }
+            static void operator delete(void* p) noexcept { detail::coro_frame_free(p); }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        AsyncBody(AsyncBody&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+        AsyncBody& operator=(AsyncBody&&) = delete;
+        ~AsyncBody() {
+            if (h_)
+                h_.destroy();
+        }
+
+        handle_type release() noexcept { return std::exchange(h_, {}); }
+
+      private:
+        explicit AsyncBody(handle_type h) noexcept : h_(h) {}
+        handle_type h_;
+    };
+
+    namespace detail {
+
+        template<typename F, typename T>
+        concept ForAsyncBody = std::is_invocable_r_v<AsyncBody, F&, T, ForCtrl&>;
+
+        // One block of in-flight bodies; destroys whatever is left if the driver unwinds
+        template<std::size_t N>
+        struct async_block {
+            std::array<AsyncBody::handle_type, N> lanes{};
+            std::array<ForCtrl, N> ctrls{};
+            std::size_t count = 0;
+
+            async_block() = default;
+            async_block(const async_block&) = delete;
+            async_block& operator=(const async_block&) = delete;
+
+            ~async_block() {
+                for (std::size_t j = 0; j < count; ++j)
+                    if (lanes[j])
+                        lanes[j].destroy();
+            }
+        };
+
+        // Starts every body of the block, then suspends until the last one finishes.
+        // The extra count held during start-up stops a body that completes synchronously
+        // from resuming the driver while it is still launching the rest.
+        template<std::size_t N>
+        struct async_join {
+            async_block<N>& block;
+            async_group& group;
+
+            bool await_ready() const noexcept { return block.count == 0; }
+
+            bool await_suspend(std::coroutine_handle<> driver) noexcept {
+                group.waiter = driver;
+                group.pending.store(block.count + 1, std::memory_order_relaxed);
+                const std::size_t count = block.count;
+                for (std::size_t j = 0; j < count; ++j)
+                    block.lanes[j].resume();
+                // Last one out: carry on without suspending
+                return group.pending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        // Runs the range in blocks of up to N concurrently awaiting bodies. Each block is joined
+        // before the next starts. An exit resolves to the lowest index in the block, as in the
+        // sequential loop, and the remaining blocks are never started.
+        template<std::size_t N, std::integral T, typename F>
+        Task<ForResult> for_loop_async_impl(T start, T end, F body) {
+            coro_frame_slots<N> slots; // must outlive every block that frees into it
+
+            for (T i = start; i < end;) {
+                async_block<N> block;
+                async_group group;
+                {
+                    frame_pool_scope scope{slots.pool()};
+                    const std::size_t remaining = static_cast<std::size_t>(end - i);
+                    const std::size_t count = std::min(N, remaining);
+                    for (std::size_t j = 0; j < count; ++j) {
+                        block.lanes[j] = body(i + static_cast<T>(j), block.ctrls[j]).release();
+                        block.lanes[j].promise().group = &group;
+                        block.count = j + 1;
+                    }
+                }
+
+                co_await async_join<N>{block, group};
+
+                for (std::size_t j = 0; j < block.count; ++j) {
+                    if (auto error = block.lanes[j].promise().error) [[unlikely]]
+                        std::rethrow_exception(error);
+                    if (!block.ctrls[j].ok) [[unlikely]]
+                        co_return ForResult{block.ctrls[j].return_set, block.ctrls[j].storage};
+                }
+
+                i += static_cast<T>(block.count);
+            }
+
+            co_return ForResult{false, {}};
+        }
+
+    } // namespace detail
+
+    // co_await ilp::for_loop_async<N>(start, end, body) - body is a coroutine returning AsyncBody.
+    // Frames for each block come from an N-slot arena inside the driver.
+    template<std::size_t N = 4, std::integral T, typename F>
+        requires detail::ForAsyncBody<std::decay_t<F>, T>
+    Task<ForResult> for_loop_async(T start, T end, F&& body) {
+        detail::validate_unroll_factor<N>();
+        return detail::for_loop_async_impl<N>(start, end, std::decay_t<F>(std::forward<F>(body)));
+    }
+
+} // namespace ilp
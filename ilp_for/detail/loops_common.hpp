@@ -101,5 +101,14 @@ namespace ilp {
         template<typename F, typename Ref, typename R>
         concept ForRangeTypedCtrlBody = std::invocable<F, Ref, ForCtrlTyped<R>&>;
 
+        // True when every size of Range is a multiple of N: the range declares a padded_block
+        // (ilp::padded_span) that N divides, so the range drivers can leave out the remainder loop
+        template<typename Range, std::size_t N>
+        inline constexpr bool whole_blocks_v = false;
+
+        template<typename Range, std::size_t N>
+            requires requires { std::remove_cvref_t<Range>::padded_block; }
+        inline constexpr bool whole_blocks_v<Range, N> = std::remove_cvref_t<Range>::padded_block % N == 0;
+
     } // namespace detail
 } // namespace ilp
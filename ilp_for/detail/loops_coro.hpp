@@ -0,0 +1,275 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "ctrl.hpp"
+#include "loops_common.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Bytes reserved per coroutine frame in the driver's arena.
+// Frames larger than this fall back to the heap. Override with -DILP_CORO_FRAME_SIZE=N.
+#ifndef ILP_CORO_FRAME_SIZE
+#define ILP_CORO_FRAME_SIZE 512
+#endif
+
+namespace ilp {
+    namespace detail {
+
+        ILP_ALWAYS_INLINE void prefetch_address(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+
+        // Untyped view of a fixed-slot frame arena.
+        // Each frame carries a header pointing back at the pool it came from (or nullptr for the
+        // heap), so frames can be released correctly regardless of which pool is current.
+        struct coro_frame_pool {
+            static constexpr std::size_t header = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+            static constexpr std::size_t slot_size = ILP_CORO_FRAME_SIZE + header;
+
+            std::byte** free_slots = nullptr;
+            std::size_t free_count = 0;
+
+            void* take(std::size_t n) noexcept {
+                if (n + header > slot_size || free_count == 0)
+                    return nullptr;
+                return free_slots[--free_count];
+            }
+
+            void give(void* slot) noexcept { free_slots[free_count++] = static_cast<std::byte*>(slot); }
+        };
+
+        inline thread_local coro_frame_pool* current_frame_pool = nullptr;
+
+        inline void* coro_frame_alloc(std::size_t n) {
+            coro_frame_pool* pool = current_frame_pool;
+            void* raw = pool ? pool->take(n) : nullptr;
+            if (!raw) {
+                pool = nullptr;
+                raw = ::operator new(n + coro_frame_pool::header);
+            }
+            *static_cast<coro_frame_pool**>(raw) = pool;
+            return static_cast<std::byte*>(raw) + coro_frame_pool::header;
+        }
+
+        inline void coro_frame_free(void* p) noexcept {
+            void* raw = static_cast<std::byte*>(p) - coro_frame_pool::header;
+            if (coro_frame_pool* pool = *static_cast<coro_frame_pool**>(raw))
+                pool->give(raw);
+            else
+                ::operator delete(raw);
+        }
+
+        // Preallocated storage for Slots frames. Not installed by itself; see frame_pool_scope.
+        template<std::size_t Slots>
+        class coro_frame_slots {
+          public:
+            coro_frame_slots() noexcept {
+                for (std::size_t s = 0; s < Slots; ++s)
+                    free_[s] = storage_[s];
+                pool_.free_slots = free_.data();
+                pool_.free_count = Slots;
+            }
+
+            coro_frame_slots(const coro_frame_slots&) = delete;
+            coro_frame_slots& operator=(const coro_frame_slots&) = delete;
+
+            coro_frame_pool* pool() noexcept { return &pool_; }
+
+          private:
+            alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) std::byte storage_[Slots][coro_frame_pool::slot_size];
+            std::array<std::byte*, Slots> free_;
+            coro_frame_pool pool_;
+        };
+
+        // Makes pool the current pool for its lifetime, restoring the previous one after
+        class frame_pool_scope {
+          public:
+            explicit frame_pool_scope(coro_frame_pool* pool) noexcept : previous_(current_frame_pool) {
+                current_frame_pool = pool;
+            }
+
+            ~frame_pool_scope() { current_frame_pool = previous_; }
+
+            frame_pool_scope(const frame_pool_scope&) = delete;
+            frame_pool_scope& operator=(const frame_pool_scope&) = delete;
+
+          private:
+            coro_frame_pool* previous_;
+        };
+
+        // Slots installed as the current pool for the arena's lifetime.
+        // Nested drivers save and restore the previous pool.
+        template<std::size_t Slots>
+        class coro_frame_arena {
+          public:
+            coro_frame_arena() noexcept = default;
+
+          private:
+            coro_frame_slots<Slots> slots_;
+            frame_pool_scope scope_{slots_.pool()};
+        };
+
+    } // namespace detail
+
+    // Return type of an ILP_FOR_CORO body. Lazily started; the driver owns the frame.
+    class CoroTask {
+      public:
+        struct promise_type {
+            CoroTask get_return_object() noexcept {
+                return CoroTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            // Rethrowing leaves the frame at its final suspend point and propagates out of resume()
+            void unhandled_exception() { throw; }
+
+            static void* operator new(std::size_t n) { return detail::coro_frame_alloc(n); }
+            static void operator delete(void* p) noexcept { detail::coro_frame_free(p); }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        CoroTask(CoroTask&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+        CoroTask& operator=(CoroTask&&) = delete;
+        ~CoroTask() {
+            if (h_)
+                h_.destroy();
+        }
+
+        handle_type release() noexcept { return std::exchange(h_, {}); }
+
+      private:
+        explicit CoroTask(handle_type h) noexcept : h_(h) {}
+        handle_type h_;
+    };
+
+    // co_await ilp::prefetch(ptr) - issue a prefetch and yield to the next in-flight iteration
+    struct PrefetchAwaiter {
+        const void* address;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const noexcept { detail::prefetch_address(address); }
+        void await_resume() const noexcept {}
+    };
+
+    template<typename T>
+    PrefetchAwaiter prefetch(const T* p) noexcept {
+        return PrefetchAwaiter{p};
+    }
+
+    namespace detail {
+
+        template<typename F, typename T>
+        concept ForCoroBody = std::is_invocable_r_v<CoroTask, F, T, ForCtrl&>;
+
+        template<std::integral T>
+        struct coro_lane {
+            CoroTask::handle_type h;
+            T index{};
+            ForCtrl ctrl;
+
+            void reset() noexcept {
+                if (h) {
+                    h.destroy();
+                    h = {};
+                }
+            }
+
+            ~coro_lane() { reset(); }
+        };
+
+        // Runs up to G body coroutines round-robin. Each suspension (normally at a prefetch)
+        // switches to the next lane, so the memory accesses of G iterations overlap.
+        // An exit resolves to the lowest index: lanes below it run to completion, lanes above
+        // it are destroyed at their current suspension point and no further indices start.
+        // An exit is only seen when its lane finishes, so higher indices may already have run
+        // to completion, including ones launched after the exiting lane started.
+        template<std::size_t G, std::integral T, typename F>
+            requires ForCoroBody<F, T>
+        ForResult for_loop_coro_impl(T start, T end, F&& body) {
+            validate_unroll_factor<G>();
+            coro_frame_arena<G> arena; // must outlive the lanes that free into it
+            std::array<coro_lane<T>, G> lanes;
+
+            T next = start;
+            std::size_t active = 0;
+            bool stopped = false;
+            bool has_exit = false;
+            T exit_index{};
+            ForResult result{false, {}};
+
+            auto launch = [&](coro_lane<T>& lane) {
+                lane.index = next;
+                lane.ctrl = ForCtrl{};
+                lane.h = body(next, lane.ctrl).release();
+                ++next;
+                ++active;
+            };
+
+            for (std::size_t g = 0; g < G && next < end; ++g)
+                launch(lanes[g]);
+
+            while (active > 0) {
+                for (auto& lane : lanes) {
+                    if (!lane.h)
+                        continue;
+
+                    lane.h.resume();
+                    if (!lane.h.done())
+                        continue;
+
+                    lane.reset();
+                    --active;
+
+                    if (!lane.ctrl.ok) [[unlikely]] {
+                        if (!has_exit || lane.index < exit_index) {
+                            has_exit = true;
+                            exit_index = lane.index;
+                            result = ForResult{lane.ctrl.return_set, lane.ctrl.storage};
+                        }
+                        stopped = true;
+                        for (auto& other : lanes) {
+                            if (other.h && other.index > exit_index) {
+                                other.reset();
+                                --active;
+                            }
+                        }
+                    }
+
+                    if (!stopped && next < end)
+                        launch(lane);
+                }
+            }
+
+            return result;
+        }
+
+    } // namespace detail
+
+    template<std::size_t G = 4, std::integral T, typename F>
+        requires detail::ForCoroBody<F, T>
+    ForResult for_loop_coro(T start, T end, F&& body) {
+        return detail::for_loop_coro_impl<G>(start, end, std::forward<F>(body));
+    }
+
+} // namespace ilp
@@ -9,6 +9,7 @@
 #include <concepts>
 #include <cstddef>
 #include <ranges>
+#include <type_traits>
 #include <utility>
 
 #include "ctrl.hpp"
@@ -84,8 +85,10 @@ namespace ilp {
                     }
                 }
 
-                for (; i < size && ctrl.ok; ++i) {
-                    body(it[i], ctrl);
+                if constexpr (!whole_blocks_v<Range, N>) {
+                    for (; i < size && ctrl.ok; ++i) {
+                        body(it[i], ctrl);
+                    }
                 }
             } else {
                 static_assert(ForRangeBody<F, Ref>, "Lambda must be invocable with (Ref) or (Ref, LoopCtrl<void>&)");
@@ -96,8 +99,10 @@ namespace ilp {
                     }
                 }
 
-                for (; i < size; ++i) {
-                    body(it[i]);
+                if constexpr (!whole_blocks_v<Range, N>) {
+                    for (; i < size; ++i) {
+                        body(it[i]);
+                    }
                 }
             }
         }
@@ -111,7 +116,7 @@ namespace ilp {
             auto size = std::ranges::size(range);
             std::size_t i = 0;
 
-            for (; i + N <= size; i += N) {
+            for (const std::size_t unrolled = size - size % N; i < unrolled; i += N) {
                 for (std::size_t j = 0; j < N; ++j) {
                     body(it[i + j], ctrl);
                     if (!ctrl.ok) [[unlikely]]
@@ -119,10 +124,12 @@ namespace ilp {
                 }
             }
 
-            for (; i < size; ++i) {
-                body(it[i], ctrl);
-                if (!ctrl.ok) [[unlikely]]
-                    return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+            if constexpr (!whole_blocks_v<Range, N>) {
+                for (; i < size; ++i) {
+                    body(it[i], ctrl);
+                    if (!ctrl.ok) [[unlikely]]
+                        return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                }
             }
 
             return ForResult{false, {}};
@@ -137,7 +144,7 @@ namespace ilp {
             auto size = std::ranges::size(range);
             std::size_t i = 0;
 
-            for (; i + N <= size; i += N) {
+            for (const std::size_t unrolled = size - size % N; i < unrolled; i += N) {
                 for (std::size_t j = 0; j < N; ++j) {
                     body(it[i + j], ctrl);
                     if (!ctrl.ok) [[unlikely]]
@@ -145,10 +152,12 @@ namespace ilp {
                 }
             }
 
-            for (; i < size; ++i) {
-                body(it[i], ctrl);
-                if (!ctrl.ok) [[unlikely]]
-                    return ForResultTyped<R>{ctrl.return_set, std::move(ctrl.storage)};
+            if constexpr (!whole_blocks_v<Range, N>) {
+                for (; i < size; ++i) {
+                    body(it[i], ctrl);
+                    if (!ctrl.ok) [[unlikely]]
+                        return ForResultTyped<R>{ctrl.return_set, std::move(ctrl.storage)};
+                }
             }
 
             return ForResultTyped<R>{false, {}};
@@ -255,28 +264,99 @@ namespace ilp {
         return detail::for_loop_range_ret_simple_impl<N>(std::forward<Range>(range), std::forward<F>(body));
     }
 
-    template<typename ElementT, LoopType LT, std::integral T, typename F>
+    namespace detail {
+
+        // Calls run(std::integral_constant<std::size_t, N>{}) with the _auto loops' N: optimal_N_for,
+        // or with -DILP_HYBRID_CORES the E-core N when the thread is on an E-core of a hybrid part,
+        // or with -DILP_SMT_AWARE the shared-core N when cpu::core_is_shared(). Each alternative
+        // body is only instantiated where its N differs from optimal_N_for.
+        template<typename ElementT, auto LT, auto... More, typename Run>
+        decltype(auto) with_auto_N(Run&& run) {
+            constexpr std::size_t N = optimal_N_for<ElementT, LT, More...>;
+#ifdef ILP_HYBRID_CORES
+            constexpr std::size_t E = efficiency_N_for<ElementT, LT, More...>;
+            if constexpr (E != 0 && E != N) {
+                if (::ilp::cpu::current_core_type() == ::ilp::cpu::CoreType::Efficiency)
+                    return std::forward<Run>(run)(std::integral_constant<std::size_t, E>{});
+            }
+#endif
+#ifdef ILP_SMT_AWARE
+            constexpr std::size_t S = shared_core_N_for<ElementT, LT, More...>;
+            if constexpr (S != N) {
+                if (::ilp::cpu::core_is_shared())
+                    return std::forward<Run>(run)(std::integral_constant<std::size_t, S>{});
+            }
+#endif
+            return std::forward<Run>(run)(std::integral_constant<std::size_t, N>{});
+        }
+
+        // Bytes above which a range streams from memory: the profile's last-level cache, or with
+        // -DILP_DETECT_CACHES the host's where it can be read
+        inline std::size_t streaming_bytes() {
+#ifdef ILP_DETECT_CACHES
+            static const std::size_t llc = [] {
+                const std::size_t host = ::ilp::cpu::detect_cache_sizes().llc;
+                return host != 0 ? host : ::ilp::cpu::cache_sizes(ILP_CPU_PROFILE).llc;
+            }();
+            return llc;
+#else
+            return ::ilp::cpu::cache_sizes(ILP_CPU_PROFILE).llc;
+#endif
+        }
+
+        // with_auto_N for the _auto range loops, which first branch once on the range's size:
+        // a contiguous range larger than streaming_bytes() takes the streaming N
+        // (cpu::streaming), where more chains only add code
+        template<typename ElementT, auto LT, auto... More, typename Range, typename Run>
+        decltype(auto) with_range_auto_N(Range&& range, Run&& run) {
+#if ILP_WORKING_SET_AWARE
+            if constexpr (std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>) {
+                constexpr std::size_t S = streaming_N_for<ElementT, LT, More...>;
+                if constexpr (S != optimal_N_for<ElementT, LT, More...>) {
+                    const auto bytes =
+                        static_cast<std::size_t>(std::ranges::size(range)) * sizeof(std::ranges::range_value_t<Range>);
+                    if (bytes > streaming_bytes())
+                        return std::forward<Run>(run)(std::integral_constant<std::size_t, S>{});
+                }
+            }
+#else
+            (void)range;
+#endif
+            return with_auto_N<ElementT, LT, More...>(std::forward<Run>(run));
+        }
+
+    } // namespace detail
+
+    // The _auto loops take one loop kind (a LoopType or a custom tag), or several for a body that
+    // mixes them (see optimal_N_for)
+    template<typename ElementT, auto LT, auto... More, std::integral T, typename F>
         requires detail::ForUntypedCtrlBody<F, T>
     ForResult for_loop_auto(T start, T end, F&& body) {
-        return for_loop<optimal_N<LT, ElementT>>(start, end, std::forward<F>(body));
+        return detail::with_auto_N<ElementT, LT, More...>(
+            [&](auto n) { return for_loop<decltype(n)::value>(start, end, std::forward<F>(body)); });
     }
 
-    template<typename ElementT, typename R, LoopType LT, std::integral T, typename F>
+    template<typename ElementT, typename R, auto LT, auto... More, std::integral T, typename F>
         requires detail::ForTypedCtrlBody<F, T, R>
     ForResultTyped<R> for_loop_typed_auto(T start, T end, F&& body) {
-        return for_loop_typed<R, optimal_N<LT, ElementT>>(start, end, std::forward<F>(body));
+        return detail::with_auto_N<ElementT, LT, More...>(
+            [&](auto n) { return for_loop_typed<R, decltype(n)::value>(start, end, std::forward<F>(body)); });
     }
 
-    template<typename ElementT, LoopType LT, std::ranges::random_access_range Range, typename F>
+    template<typename ElementT, auto LT, auto... More, std::ranges::random_access_range Range, typename F>
         requires detail::ForRangeUntypedCtrlBody<F, std::ranges::range_reference_t<Range>>
     ForResult for_loop_range_auto(Range&& range, F&& body) {
-        return for_loop_range<optimal_N<LT, ElementT>>(std::forward<Range>(range), std::forward<F>(body));
+        return detail::with_range_auto_N<ElementT, LT, More...>(range, [&](auto n) {
+            return for_loop_range<decltype(n)::value>(std::forward<Range>(range), std::forward<F>(body));
+        });
     }
 
-    template<typename ElementT, typename R, LoopType LT, std::ranges::random_access_range Range, typename F>
+    template<typename ElementT, typename R, auto LT, auto... More, std::ranges::random_access_range Range, typename F>
         requires detail::ForRangeTypedCtrlBody<F, std::ranges::range_reference_t<Range>, R>
     ForResultTyped<R> for_loop_range_typed_auto(Range&& range, F&& body) {
-        return for_loop_range_typed<R, optimal_N<LT, ElementT>>(std::forward<Range>(range), std::forward<F>(body));
+        return detail::with_range_auto_N<ElementT, LT, More...>(range, [&](auto n) {
+            return for_loop_range_typed<R, decltype(n)::value>(std::forward<Range>(range), std::forward<F>(body));
+        });
     }
 
 } // namespace ilp
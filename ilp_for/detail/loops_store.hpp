@@ -0,0 +1,205 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "ctrl.hpp"
+#include "loops_common.hpp"
+#include "loops_ilp.hpp"
+
+// Non-temporal stores for ilp::for_loop_range_store on x86 (SSE2 and up). Elsewhere, or with
+// -DILP_STREAMING_STORES=0, every store is a regular one.
+#ifndef ILP_STREAMING_STORES
+#define ILP_STREAMING_STORES 1
+#endif
+
+#if ILP_STREAMING_STORES && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ILP_HAS_STREAMING_STORES 1
+#include <immintrin.h>
+#else
+#define ILP_HAS_STREAMING_STORES 0
+#endif
+
+namespace ilp {
+
+    // How for_loop_range_store writes its output: Auto streams it when it is larger than the
+    // last-level cache (detail::streaming_bytes), Cached never does, Streaming always does
+    enum class StoreMode { Auto, Cached, Streaming };
+
+    namespace detail {
+
+        template<typename F, typename Ref, typename T>
+        concept ForStoreBody = std::invocable<F, Ref, T&, ForCtrl&>;
+
+        // Non-temporal stores go out a cache line at a time
+        inline constexpr std::size_t stream_line_bytes = 64;
+
+        template<typename T>
+        inline constexpr bool streamable_v = std::is_trivially_copyable_v<T> && stream_line_bytes % sizeof(T) == 0;
+
+#if ILP_HAS_STREAMING_STORES
+        // One line from `from` to the line-aligned `to`, bypassing the cache: no read for
+        // ownership of the destination line and nothing evicted to make room for it
+        ILP_ALWAYS_INLINE void stream_line(void* to, const void* from) noexcept {
+#if defined(__AVX512F__)
+            _mm512_stream_si512(static_cast<__m512i*>(to), _mm512_loadu_si512(from));
+#elif defined(__AVX__)
+            auto* d = static_cast<__m256i*>(to);
+            const auto* s = static_cast<const __m256i*>(from);
+            _mm256_stream_si256(d, _mm256_loadu_si256(s));
+            _mm256_stream_si256(d + 1, _mm256_loadu_si256(s + 1));
+#else
+            auto* d = static_cast<__m128i*>(to);
+            const auto* s = static_cast<const __m128i*>(from);
+            for (int k = 0; k < 4; ++k)
+                _mm_stream_si128(d + k, _mm_loadu_si128(s + k));
+#endif
+        }
+
+        // Non-temporal stores are weakly ordered; this orders them before anything after the loop
+        ILP_ALWAYS_INLINE void stream_fence() noexcept { _mm_sfence(); }
+#endif
+
+        // The body fills a value-initialized slot and the driver stores it, so every element is
+        // written exactly once whichever path runs. On early exit the breaking element is
+        // written too, with whatever the body put in the slot before leaving.
+        template<std::size_t N, StoreMode Mode, typename Src, typename Dst, typename F>
+        ForResult for_loop_range_store_impl(Src&& src, Dst&& dst, F&& body) {
+            validate_unroll_factor<N>();
+            using T = std::ranges::range_value_t<Dst>;
+            ForCtrl ctrl;
+            auto in = std::ranges::begin(src);
+            auto out = std::ranges::begin(dst);
+            const std::size_t size = static_cast<std::size_t>(std::ranges::size(src));
+            assert(static_cast<std::size_t>(std::ranges::size(dst)) >= size && "output range shorter than input");
+            std::size_t i = 0;
+
+            auto store_one = [&](std::size_t k) {
+                T slot{};
+                body(in[k], slot, ctrl);
+                out[k] = std::move(slot);
+            };
+
+#if ILP_HAS_STREAMING_STORES
+            if constexpr (Mode != StoreMode::Cached && std::ranges::contiguous_range<Dst> && streamable_v<T>) {
+                T* const base = std::ranges::data(dst);
+                const auto misaligned = reinterpret_cast<std::uintptr_t>(base) % stream_line_bytes;
+                const std::size_t head_bytes = misaligned == 0 ? 0 : stream_line_bytes - misaligned;
+                const bool stream = Mode == StoreMode::Streaming || size * sizeof(T) > streaming_bytes();
+                if (stream && head_bytes % sizeof(T) == 0) {
+                    // Whole lines covering at least N elements
+                    constexpr std::size_t per_line = stream_line_bytes / sizeof(T);
+                    constexpr std::size_t lines = (N + per_line - 1) / per_line;
+                    constexpr std::size_t block = lines * per_line;
+
+                    const std::size_t head = std::min(size, head_bytes / sizeof(T));
+                    for (; i < head; ++i) {
+                        store_one(i);
+                        if (!ctrl.ok) [[unlikely]]
+                            return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                    }
+
+                    for (; i + block <= size; i += block) {
+                        alignas(stream_line_bytes) T staged[block]{};
+                        for (std::size_t j = 0; j < block; ++j) {
+                            body(in[i + j], staged[j], ctrl);
+                            if (!ctrl.ok) [[unlikely]] {
+                                for (std::size_t k = 0; k <= j; ++k)
+                                    out[i + k] = staged[k];
+                                stream_fence();
+                                return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                            }
+                        }
+                        for (std::size_t line = 0; line < lines; ++line)
+                            stream_line(base + i + line * per_line, staged + line * per_line);
+                    }
+                    stream_fence();
+
+                    for (; i < size; ++i) {
+                        store_one(i);
+                        if (!ctrl.ok) [[unlikely]]
+                            return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                    }
+                    return ForResult{false, {}};
+                }
+            }
+#endif
+
+            for (const std::size_t unrolled = size - size % N; i < unrolled; i += N) {
+                for (std::size_t j = 0; j < N; ++j) {
+                    store_one(i + j);
+                    if (!ctrl.ok) [[unlikely]]
+                        return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                }
+            }
+
+            for (; i < size; ++i) {
+                store_one(i);
+                if (!ctrl.ok) [[unlikely]]
+                    return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+            }
+
+            return ForResult{false, {}};
+        }
+
+        // Plain-loop form for ILP_MODE_SIMPLE: the slot is the output element itself, reset to
+        // T{} before the body runs so a skipped element is written the same as in ILP mode
+        template<typename SrcView, typename DstView>
+        struct store_cursor {
+            SrcView src;
+            DstView dst;
+            std::size_t i = 0;
+
+            bool more() { return i < static_cast<std::size_t>(std::ranges::size(src)); }
+            void next() { ++i; }
+            decltype(auto) in() { return std::ranges::begin(src)[i]; }
+            auto& out() { return std::ranges::begin(dst)[i] = std::ranges::range_value_t<DstView>{}; }
+        };
+
+        template<typename Src, typename Dst>
+        auto make_store_cursor(Src&& src, Dst&& dst) {
+            return store_cursor<decltype(std::views::all(std::forward<Src>(src))),
+                                decltype(std::views::all(std::forward<Dst>(dst)))>{
+                std::views::all(std::forward<Src>(src)), std::views::all(std::forward<Dst>(dst))};
+        }
+
+    } // namespace detail
+
+    // Loop over src that writes one element of dst per element: the body fills `out` and the
+    // driver stores it to dst[i]. For Copy and Transform loops whose output is larger than the
+    // last-level cache the stores are non-temporal, a cache line at a time, so the output
+    // neither evicts the working set nor reads each destination line before overwriting it.
+    // The lines are fenced on every exit, so dst is complete to other threads once the loop
+    // returns. Streaming needs a contiguous dst of a trivially copyable type that tiles a
+    // cache line; other outputs are written with regular stores.
+    template<std::size_t N = 4, StoreMode Mode = StoreMode::Auto, std::ranges::random_access_range Src,
+             std::ranges::random_access_range Dst, typename F>
+        requires std::ranges::sized_range<Src> &&
+                 std::default_initializable<std::ranges::range_value_t<Dst>> &&
+                 detail::ForStoreBody<F, std::ranges::range_reference_t<Src>, std::ranges::range_value_t<Dst>>
+    ForResult for_loop_range_store(Src&& src, Dst&& dst, F&& body) {
+        return detail::for_loop_range_store_impl<N, Mode>(src, dst, std::forward<F>(body));
+    }
+
+    template<typename ElementT, auto LT, auto... More, std::ranges::random_access_range Src,
+             std::ranges::random_access_range Dst, typename F>
+        requires std::ranges::sized_range<Src> &&
+                 std::default_initializable<std::ranges::range_value_t<Dst>> &&
+                 detail::ForStoreBody<F, std::ranges::range_reference_t<Src>, std::ranges::range_value_t<Dst>>
+    ForResult for_loop_range_store_auto(Src&& src, Dst&& dst, F&& body) {
+        return detail::with_range_auto_N<ElementT, LT, More...>(
+            src, [&](auto n) { return for_loop_range_store<decltype(n)::value>(src, dst, std::forward<F>(body)); });
+    }
+
+} // namespace ilp
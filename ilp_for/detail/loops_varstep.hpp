@@ -0,0 +1,84 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+#include "ctrl.hpp"
+#include "loops_common.hpp"
+
+namespace ilp {
+
+    // ForCtrl plus the distance to the next position; ILP_STEP(n) sets it (default 1)
+    struct VarStepCtrl : ForCtrl {
+        std::size_t step = 1;
+    };
+
+    namespace detail {
+
+        template<typename F, typename T>
+        concept ForVarStepBody = std::invocable<F, T, VarStepCtrl&>;
+
+        // Plain-loop form for ILP_MODE_SIMPLE: a range of positions that advances by the step the
+        // body set on the cursor, so ILP_STEP works unchanged and break/continue/return are native.
+        template<std::integral T>
+        struct varstep_cursor {
+            T pos;
+            T last;
+            std::size_t step = 1;
+
+            struct iterator {
+                varstep_cursor* c;
+                T operator*() const { return c->pos; }
+                iterator& operator++() {
+                    assert(c->step > 0 && "ILP_STEP must advance the position");
+                    c->pos = static_cast<T>(c->pos + static_cast<T>(c->step));
+                    c->step = 1;
+                    return *this;
+                }
+                bool operator!=(const iterator&) const { return c->pos < c->last; }
+            };
+
+            iterator begin() { return {this}; }
+            iterator end() { return {this}; }
+        };
+
+        template<std::integral T, std::integral U>
+        varstep_cursor<T> make_varstep_cursor(T start, U end) {
+            return {start, static_cast<T>(end)};
+        }
+
+    } // namespace detail
+
+    // Loop over positions in [start, end) where each iteration decides how far to advance
+    // (length-prefixed records, varints, tokens). The position chain is inherently serial: N only
+    // unrolls the dispatch. For LEB128 streams see ilp::for_each_varint, which finds N boundaries
+    // per block up front and decodes them as independent lanes.
+    template<std::size_t N = 4, std::integral T, typename F>
+        requires detail::ForVarStepBody<F, T>
+    ForResult for_loop_varstep(T start, T end, F&& body) {
+        detail::validate_unroll_factor<N>();
+        VarStepCtrl ctrl;
+        T i = start;
+
+        while (i < end) {
+            for (std::size_t j = 0; j < N && i < end; ++j) {
+                ctrl.step = 1;
+                body(i, ctrl);
+                if (!ctrl.ok) [[unlikely]]
+                    return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                assert(ctrl.step > 0 && "ILP_STEP must advance the position");
+                i = static_cast<T>(i + static_cast<T>(ctrl.step));
+            }
+        }
+
+        return ForResult{false, {}};
+    }
+
+} // namespace ilp
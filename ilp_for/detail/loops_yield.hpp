@@ -0,0 +1,163 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "ctrl.hpp"
+#include "loops_common.hpp"
+
+namespace ilp {
+
+    // ok=false stops production after the current iteration. Each iteration has one slot:
+    // limit is the count it may reach, so a second yield in the same iteration is ignored
+    template<typename V>
+    struct YieldCtrl {
+        bool ok = true;
+        V* slots = nullptr;
+        std::size_t count = 0;
+        std::size_t limit = 0;
+
+        template<typename U>
+        ILP_ALWAYS_INLINE void yield(U&& val) {
+            if (count == limit) [[unlikely]]
+                return;
+            std::construct_at(slots + count, static_cast<U&&>(val));
+            ++count;
+        }
+    };
+
+    namespace detail {
+
+        template<typename F, typename T, typename V>
+        concept ForYieldBody = std::invocable<F, T, YieldCtrl<V>&>;
+
+    } // namespace detail
+
+    // Lazy, single-pass range over the values an unrolled loop yields.
+    // Production runs one N-iteration block at a time and only when the consumer has drained
+    // the previous block, so an early-stopping consumer never pays for the rest of the scan.
+    template<typename V, std::size_t N, std::integral T, typename F>
+    class generate_view {
+      public:
+        using value_type = V;
+
+        generate_view(T start, T end, F body) : next_(start), end_(end), body_(std::move(body)) {}
+
+        generate_view(const generate_view&) = delete;
+        generate_view& operator=(const generate_view&) = delete;
+
+        ~generate_view() { clear(); }
+
+        // Refill and return the next non-empty block of values; empty once the loop is done
+        std::span<V> next_block() {
+            clear();
+            YieldCtrl<V> ctrl{true, slots(), 0, 0};
+
+            // count_ follows ctrl.count even if the body throws, so the view still destroys
+            // the values yielded so far
+            struct sync_count {
+                std::size_t& count;
+                const YieldCtrl<V>& ctrl;
+                ~sync_count() { count = ctrl.count; }
+            } sync{count_, ctrl};
+
+            while (ctrl.count == 0 && !done_) {
+                if (next_ + static_cast<T>(N) <= end_) {
+                    for (std::size_t j = 0; j < N; ++j) {
+                        ctrl.limit = ctrl.count + 1;
+                        body_(next_ + static_cast<T>(j), ctrl);
+                        if (!ctrl.ok) [[unlikely]] {
+                            done_ = true;
+                            break;
+                        }
+                    }
+                    next_ += static_cast<T>(N);
+                } else {
+                    for (; next_ < end_; ++next_) {
+                        ctrl.limit = ctrl.count + 1;
+                        body_(next_, ctrl);
+                        if (!ctrl.ok) [[unlikely]]
+                            break;
+                    }
+                    done_ = true;
+                }
+            }
+
+            return {slots(), ctrl.count};
+        }
+
+        class iterator {
+          public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = V;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            V& operator*() const { return view_->block_[pos_]; }
+
+            iterator& operator++() {
+                if (++pos_ == view_->block_.size()) {
+                    view_->block_ = view_->next_block();
+                    pos_ = 0;
+                }
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.exhausted(); }
+
+          private:
+            friend class generate_view;
+            explicit iterator(generate_view* v) : view_(v) {}
+
+            bool exhausted() const noexcept { return view_->block_.empty(); }
+
+            generate_view* view_ = nullptr;
+            std::size_t pos_ = 0;
+        };
+
+        iterator begin() {
+            block_ = next_block();
+            return iterator{this};
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+      private:
+        V* slots() noexcept { return std::launder(reinterpret_cast<V*>(storage_)); }
+
+        void clear() noexcept {
+            std::destroy_n(slots(), count_);
+            count_ = 0;
+        }
+
+        T next_;
+        T end_;
+        F body_;
+        bool done_ = false;
+        std::size_t count_ = 0;
+        std::span<V> block_;
+        alignas(V) std::byte storage_[N * sizeof(V)];
+    };
+
+    template<typename V, std::size_t N = 4, std::integral T, typename F>
+        requires detail::ForYieldBody<F, T, V>
+    generate_view<V, N, T, std::decay_t<F>> generate(T start, T end, F&& body) {
+        detail::validate_unroll_factor<N>();
+        return {start, end, std::forward<F>(body)};
+    }
+
+} // namespace ilp
@@ -6,6 +6,11 @@
 #pragma once
 
 #include "iota.hpp"
+#include "loops_async.hpp"
+#include "loops_coro.hpp"
+#include "loops_store.hpp"
+#include "loops_varstep.hpp"
+#include "loops_yield.hpp"
 
 #define ILP_FOR(loop_var_decl, start, end, N) for (loop_var_decl : ::ilp::iota((start), (end)))
 
@@ -25,11 +30,66 @@
 
 #define ILP_FOR_RANGE_T_AUTO(ret_type, loop_var_decl, range, loop_type, element_type) for (loop_var_decl : (range))
 
+#define ILP_FOR_MIX_AUTO(loop_var_decl, start, end, element_type, ...) for (loop_var_decl : ::ilp::iota((start), (end)))
+
+#define ILP_FOR_RANGE_MIX_AUTO(loop_var_decl, range, element_type, ...) for (loop_var_decl : (range))
+
+#define ILP_FOR_T_MIX_AUTO(ret_type, loop_var_decl, start, end, element_type, ...)                                     \
+    for (loop_var_decl : ::ilp::iota((start), (end)))
+
+#define ILP_FOR_RANGE_T_MIX_AUTO(ret_type, loop_var_decl, range, element_type, ...) for (loop_var_decl : (range))
+
+// in_decl and out_decl are if-statement initializers, in scope for the body in the else branch
+#define ILP_FOR_RANGE_STORE(in_decl, out_decl, src, dst, N)                                                            \
+    for (auto __ilp_cursor = ::ilp::detail::make_store_cursor((src), (dst)); __ilp_cursor.more(); __ilp_cursor.next()) \
+        if ([[maybe_unused]] in_decl = __ilp_cursor.in(); false) {                                                     \
+        } else if ([[maybe_unused]] out_decl = __ilp_cursor.out(); false) {                                            \
+        } else
+
+#define ILP_FOR_RANGE_STORE_AUTO(in_decl, out_decl, src, dst, loop_type, element_type)                                 \
+    ILP_FOR_RANGE_STORE(in_decl, out_decl, src, dst, 1)
+
+// One if-statement initializer per declared column, in scope for the body in the last else
+#define ILP_FOR_SOA(decls, soa, N)                                                                                     \
+    for (auto __ilp_cursor = ::ilp::detail::make_soa_cursor<::ilp::detail::fixed_string{#decls}>(soa);                 \
+         __ilp_cursor.more(); __ilp_cursor.next())                                                                     \
+    ILP_DETAIL_SOA_BIND decls
+
+// The cursor is named __ilp_ctrl so ILP_STEP is the same expression in both modes
+#define ILP_FOR_VARSTEP(loop_var_decl, start, end, N)                                                                  \
+    for (auto __ilp_ctrl = ::ilp::detail::make_varstep_cursor((start), (end)); loop_var_decl : __ilp_ctrl)
+
+#define ILP_FOR_CORO(loop_var_decl, start, end, G) for (loop_var_decl : ::ilp::iota((start), (end)))
+
+// Plain loop inside the enclosing coroutine - awaits run one at a time
+#define ILP_FOR_ASYNC(loop_var_decl, start, end, N) for (loop_var_decl : ::ilp::iota((start), (end)))
+
+// Still a lambda (a generator has no plain-loop form); N=1 keeps production element-at-a-time
+#define ILP_FOR_YIELD(value_type, loop_var_decl, start, end, N)                                                        \
+    ::ilp::generate<value_type, 1>(start, end,                                                                         \
+                                   [&]([[maybe_unused]] loop_var_decl, [[maybe_unused]] ::ilp::YieldCtrl<value_type>& __ilp_ctrl)
+
 #define ILP_END
 #define ILP_END_RETURN
+#define ILP_END_ASYNC
+#define ILP_END_ASYNC_RETURN
 
 #define ILP_CONTINUE continue
 
 #define ILP_BREAK break
 
 #define ILP_RETURN(x) return x
+
+#define ILP_CO_PREFETCH(ptr) ::ilp::detail::prefetch_address(ptr)
+
+#define ILP_CO_CONTINUE continue
+
+#define ILP_CO_BREAK break
+
+#define ILP_CO_RETURN(x) return x
+
+#define ILP_ASYNC_CONTINUE continue
+
+#define ILP_ASYNC_BREAK break
+
+#define ILP_ASYNC_RETURN(x) co_return x
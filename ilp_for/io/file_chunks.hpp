@@ -0,0 +1,471 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "ilp_for/io/file_chunks.hpp requires POSIX file descriptors"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// io_uring backend: Linux with the uapi header. Define ILP_NO_IO_URING to build without it.
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && !defined(ILP_NO_IO_URING)
+#define ILP_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define ILP_HAS_IO_URING 0
+#endif
+
+namespace ilp {
+
+    enum class io_backend {
+        automatic, // io_uring if the kernel allows it, else pread
+        uring,     // io_uring, falling back to pread if setup fails
+        pread      // synchronous pread into a single buffer
+    };
+
+    namespace detail {
+
+#if ILP_HAS_IO_URING
+        // Just enough of an io_uring to keep reads in flight: one ring, raw syscalls, no liburing.
+        class uring_queue {
+          public:
+            uring_queue() = default;
+            uring_queue(const uring_queue&) = delete;
+            uring_queue& operator=(const uring_queue&) = delete;
+
+            ~uring_queue() {
+                if (sqes_)
+                    ::munmap(sqes_, sqes_size_);
+                if (cq_ptr_ && cq_ptr_ != sq_ptr_)
+                    ::munmap(cq_ptr_, cq_size_);
+                if (sq_ptr_)
+                    ::munmap(sq_ptr_, sq_size_);
+                if (fd_ >= 0)
+                    ::close(fd_);
+            }
+
+            // false if io_uring is unavailable (old kernel, seccomp, sysctl)
+            bool setup(unsigned entries) noexcept {
+                io_uring_params p{};
+                fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+                if (fd_ < 0)
+                    return false;
+
+                sq_size_ = p.sq_off.array + p.sq_entries * sizeof(std::uint32_t);
+                cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+                const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+                if (single)
+                    sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+                sq_ptr_ = map(sq_size_, IORING_OFF_SQ_RING);
+                if (!sq_ptr_)
+                    return false;
+                cq_ptr_ = single ? sq_ptr_ : map(cq_size_, IORING_OFF_CQ_RING);
+                if (!cq_ptr_)
+                    return false;
+                sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+                sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+                if (!sqes_)
+                    return false;
+
+                auto* sq = static_cast<std::byte*>(sq_ptr_);
+                auto* cq = static_cast<std::byte*>(cq_ptr_);
+                sq_tail_ = reinterpret_cast<std::uint32_t*>(sq + p.sq_off.tail);
+                sq_mask_ = *reinterpret_cast<std::uint32_t*>(sq + p.sq_off.ring_mask);
+                sq_array_ = reinterpret_cast<std::uint32_t*>(sq + p.sq_off.array);
+                cq_head_ = reinterpret_cast<std::uint32_t*>(cq + p.cq_off.head);
+                cq_tail_ = reinterpret_cast<std::uint32_t*>(cq + p.cq_off.tail);
+                cq_mask_ = *reinterpret_cast<std::uint32_t*>(cq + p.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+                tail_ = *sq_tail_;
+                return true;
+            }
+
+            // Pins the buffers so reads skip the per-request page mapping. Optional (RLIMIT_MEMLOCK).
+            bool register_buffers(const iovec* iov, unsigned n) noexcept {
+                return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iov, n) == 0;
+            }
+
+            void push_read(int fd, void* buf, unsigned len, std::uint64_t off, int fixed_index,
+                           std::uint64_t user_data) noexcept {
+                io_uring_sqe& sqe = next_sqe();
+                sqe.opcode = fixed_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<std::uint64_t>(buf);
+                sqe.len = len;
+                sqe.off = off;
+                sqe.buf_index = static_cast<std::uint16_t>(fixed_index >= 0 ? fixed_index : 0);
+                sqe.user_data = user_data;
+            }
+
+            void push_cancel(std::uint64_t target, std::uint64_t user_data) noexcept {
+                io_uring_sqe& sqe = next_sqe();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.fd = -1;
+                sqe.addr = target;
+                sqe.user_data = user_data;
+            }
+
+            // Submit everything pushed and wait for at least wait_nr completions; -errno on failure
+            int submit(unsigned wait_nr) noexcept {
+                const unsigned to_submit = pending_;
+                std::atomic_ref<std::uint32_t>(*sq_tail_).store(tail_, std::memory_order_release);
+                for (;;) {
+                    long r = ::syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr,
+                                       wait_nr ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+                    if (r >= 0) {
+                        pending_ -= static_cast<unsigned>(r);
+                        return 0;
+                    }
+                    if (errno != EINTR)
+                        return -errno;
+                }
+            }
+
+            // Calls on_cqe(user_data, res) for every available completion
+            template<typename F>
+            void reap(F&& on_cqe) {
+                std::uint32_t head = *cq_head_;
+                const std::uint32_t tail = std::atomic_ref<std::uint32_t>(*cq_tail_).load(std::memory_order_acquire);
+                for (; head != tail; ++head) {
+                    const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                    on_cqe(cqe.user_data, cqe.res);
+                }
+                std::atomic_ref<std::uint32_t>(*cq_head_).store(head, std::memory_order_release);
+            }
+
+          private:
+            void* map(std::size_t size, off_t offset) noexcept {
+                void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+                return p == MAP_FAILED ? nullptr : p;
+            }
+
+            io_uring_sqe& next_sqe() noexcept {
+                const std::uint32_t index = tail_ & sq_mask_;
+                io_uring_sqe& sqe = sqes_[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sq_array_[index] = index;
+                ++tail_;
+                ++pending_;
+                return sqe;
+            }
+
+            int fd_ = -1;
+            void* sq_ptr_ = nullptr;
+            void* cq_ptr_ = nullptr;
+            io_uring_sqe* sqes_ = nullptr;
+            std::size_t sq_size_ = 0, cq_size_ = 0, sqes_size_ = 0;
+
+            std::uint32_t* sq_tail_ = nullptr;
+            std::uint32_t* sq_array_ = nullptr;
+            std::uint32_t sq_mask_ = 0;
+            std::uint32_t* cq_head_ = nullptr;
+            std::uint32_t* cq_tail_ = nullptr;
+            std::uint32_t cq_mask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+
+            std::uint32_t tail_ = 0;
+            unsigned pending_ = 0;
+        };
+#endif
+
+        struct page_deleter {
+            void operator()(std::byte* p) const noexcept { ::operator delete(p, std::align_val_t{4096}); }
+        };
+
+    } // namespace detail
+
+    // Reads a regular file as a sequence of fixed-size chunks of T for the range macros:
+    //
+    //   ilp::file_chunks<uint32_t> in("column.bin");
+    //   for (auto chunk : in) {
+    //       ILP_FOR_RANGE(auto v, chunk, 8) { ... } ILP_END;
+    //   }
+    //
+    // With io_uring, queue_depth reads are kept in flight into a pool of registered buffers and
+    // chunks are handed out in file order, so the device stays busy while the loop runs.
+    // Without it (or with io_backend::pread) each chunk is a synchronous pread into one buffer.
+    // Chunk size is a multiple of N elements; only the last chunk can be shorter. Trailing bytes
+    // that don't fill a whole T are not read. Leaving the loop early (stop() or destruction)
+    // cancels the outstanding reads and waits for them before the buffers are freed.
+    template<typename T = char, std::size_t N = 16>
+    class file_chunks {
+        static_assert(std::is_trivially_copyable_v<T>, "file_chunks<T> requires a trivially copyable T");
+        static_assert(N >= 1, "N must be at least 1");
+
+        static constexpr std::uint64_t cancel_tag = ~std::uint64_t{0};
+
+      public:
+        explicit file_chunks(const std::filesystem::path& path,
+                             std::size_t chunk_elems = (std::size_t{1} << 20) / sizeof(T), unsigned queue_depth = 8,
+                             io_backend backend = io_backend::automatic) {
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd_ < 0)
+                throw std::system_error(errno, std::generic_category(), path.string());
+            // The destructor doesn't run for a throwing constructor; the members free themselves
+            try {
+                init(path, chunk_elems, queue_depth, backend);
+            } catch (...) {
+                ::close(fd_);
+                throw;
+            }
+        }
+
+        file_chunks(const file_chunks&) = delete;
+        file_chunks& operator=(const file_chunks&) = delete;
+
+        ~file_chunks() {
+            stop();
+            ::close(fd_);
+        }
+
+        // Backend actually in use (automatic resolves to uring or pread)
+        io_backend backend() const noexcept { return backend_; }
+
+        std::size_t chunk_capacity() const noexcept { return chunk_bytes_ / sizeof(T); }
+        std::size_t size() const noexcept { return total_bytes_ / sizeof(T); }
+
+        // Next chunk in file order; empty at end of file or after stop(). Invalidates the previous one.
+        std::span<const T> next() {
+            if (stopped_ || next_deliver_ >= num_chunks_) {
+                release_held();
+                return {};
+            }
+            return backend_ == io_backend::pread ? next_pread() : next_uring();
+        }
+
+        // Cancel outstanding reads and wait until the kernel is done with the buffers
+        void stop() noexcept {
+            if (stopped_)
+                return;
+            stopped_ = true;
+#if ILP_HAS_IO_URING
+            if (backend_ == io_backend::uring && in_flight_ > 0) {
+                for (std::size_t s = 0; s < slots_.size(); ++s)
+                    if (slots_[s].state == slot_state::in_flight)
+                        ring_->push_cancel(s, cancel_tag);
+                (void)ring_->submit(0);
+                while (in_flight_ > 0) {
+                    if (ring_->submit(1) < 0)
+                        break;
+                    reap();
+                }
+            }
+#endif
+        }
+
+        class iterator {
+          public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = std::span<const T>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            value_type operator*() const { return chunk_; }
+
+            iterator& operator++() {
+                chunk_ = src_->next();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.chunk_.empty(); }
+
+          private:
+            friend class file_chunks;
+            explicit iterator(file_chunks* src) : src_(src), chunk_(src->next()) {}
+
+            file_chunks* src_ = nullptr;
+            value_type chunk_;
+        };
+
+        iterator begin() { return iterator{this}; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+      private:
+        enum class slot_state { idle, in_flight, done };
+
+        struct slot {
+            std::byte* data = nullptr;
+            std::size_t chunk = 0;
+            slot_state state = slot_state::idle;
+            int result = 0;
+        };
+
+        // Sizes the chunks and sets up the backend for the open fd_
+        void init(const std::filesystem::path& path, std::size_t chunk_elems, unsigned queue_depth,
+                  io_backend backend) {
+            struct stat st {};
+            if (::fstat(fd_, &st) != 0)
+                throw std::system_error(errno, std::generic_category(), path.string());
+
+            chunk_elems = chunk_elems < N ? N : (chunk_elems + N - 1) / N * N;
+            chunk_bytes_ = chunk_elems * sizeof(T);
+            total_bytes_ = static_cast<std::size_t>(st.st_size) / sizeof(T) * sizeof(T);
+            num_chunks_ = (total_bytes_ + chunk_bytes_ - 1) / chunk_bytes_;
+
+            if (queue_depth < 1)
+                queue_depth = 1;
+#if ILP_HAS_IO_URING
+            if (backend != io_backend::pread && start_uring(queue_depth))
+                return;
+#endif
+            (void)backend;
+            backend_ = io_backend::pread;
+            slots_.resize(1);
+            buffers_.reset(static_cast<std::byte*>(::operator new(chunk_bytes_, std::align_val_t{4096})));
+            slots_[0].data = buffers_.get();
+        }
+
+        std::size_t chunk_length(std::size_t chunk) const noexcept {
+            return std::min(chunk_bytes_, total_bytes_ - chunk * chunk_bytes_);
+        }
+
+        // Reads [done, len) of chunk into buf synchronously; used for pread and to finish short reads
+        void read_rest(std::byte* buf, std::size_t chunk, std::size_t done) {
+            const std::size_t len = chunk_length(chunk);
+            while (done < len) {
+                ssize_t n = ::pread(fd_, buf + done, len - done, static_cast<off_t>(chunk * chunk_bytes_ + done));
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0)
+                    throw std::system_error(errno, std::generic_category(), "file_chunks: pread");
+                if (n == 0)
+                    throw std::system_error(EIO, std::generic_category(), "file_chunks: file shrank");
+                done += static_cast<std::size_t>(n);
+            }
+        }
+
+        std::span<const T> next_pread() {
+            const std::size_t chunk = next_deliver_++;
+            read_rest(slots_[0].data, chunk, 0);
+            return {reinterpret_cast<const T*>(slots_[0].data), chunk_length(chunk) / sizeof(T)};
+        }
+
+        void release_held() {
+#if ILP_HAS_IO_URING
+            if (held_ < 0)
+                return;
+            slot& s = slots_[static_cast<std::size_t>(held_)];
+            held_ = -1;
+            s.state = slot_state::idle;
+            if (!stopped_ && next_submit_ < num_chunks_)
+                submit_read(static_cast<std::size_t>(&s - slots_.data()));
+#endif
+        }
+
+#if ILP_HAS_IO_URING
+        bool start_uring(unsigned depth) {
+            const std::size_t wanted = std::min<std::size_t>(depth, std::max<std::size_t>(num_chunks_, 1));
+            auto ring = std::make_unique<detail::uring_queue>();
+            // Room for a read and a cancel per slot
+            if (!ring->setup(static_cast<unsigned>(wanted * 2)))
+                return false;
+
+            buffers_.reset(static_cast<std::byte*>(::operator new(wanted * chunk_bytes_, std::align_val_t{4096})));
+            slots_.resize(wanted);
+            std::vector<iovec> iov(wanted);
+            for (std::size_t s = 0; s < wanted; ++s) {
+                slots_[s].data = buffers_.get() + s * chunk_bytes_;
+                iov[s] = iovec{slots_[s].data, chunk_bytes_};
+            }
+            fixed_ = ring->register_buffers(iov.data(), static_cast<unsigned>(wanted));
+
+            ring_ = std::move(ring);
+            backend_ = io_backend::uring;
+            for (std::size_t s = 0; s < wanted && next_submit_ < num_chunks_; ++s)
+                submit_read(s);
+            return true;
+        }
+
+        void submit_read(std::size_t s) {
+            slot& sl = slots_[s];
+            sl.chunk = next_submit_++;
+            sl.state = slot_state::in_flight;
+            ring_->push_read(fd_, sl.data, static_cast<unsigned>(chunk_length(sl.chunk)), sl.chunk * chunk_bytes_,
+                             fixed_ ? static_cast<int>(s) : -1, s);
+            ++in_flight_;
+            if (int err = ring_->submit(0); err < 0) {
+                --in_flight_;
+                sl.state = slot_state::done;
+                sl.result = err;
+            }
+        }
+
+        void reap() {
+            ring_->reap([&](std::uint64_t user_data, int res) {
+                if (user_data == cancel_tag)
+                    return;
+                slot& sl = slots_[static_cast<std::size_t>(user_data)];
+                sl.state = slot_state::done;
+                sl.result = res;
+                --in_flight_;
+            });
+        }
+
+        std::span<const T> next_uring() {
+            release_held();
+            const std::size_t chunk = next_deliver_++;
+            const std::size_t s = chunk % slots_.size();
+            slot& sl = slots_[s];
+            while (sl.state != slot_state::done) {
+                if (int err = ring_->submit(1); err < 0)
+                    throw std::system_error(-err, std::generic_category(), "file_chunks: io_uring_enter");
+                reap();
+            }
+            held_ = static_cast<int>(s);
+
+            if (sl.result < 0)
+                throw std::system_error(-sl.result, std::generic_category(), "file_chunks: read");
+            if (static_cast<std::size_t>(sl.result) < chunk_length(chunk)) [[unlikely]]
+                read_rest(sl.data, chunk, static_cast<std::size_t>(sl.result));
+            return {reinterpret_cast<const T*>(sl.data), chunk_length(chunk) / sizeof(T)};
+        }
+#endif
+
+        int fd_ = -1;
+        io_backend backend_ = io_backend::pread;
+        std::size_t chunk_bytes_ = 0;
+        std::size_t total_bytes_ = 0;
+        std::size_t num_chunks_ = 0;
+        std::size_t next_submit_ = 0;
+        std::size_t next_deliver_ = 0;
+        std::size_t in_flight_ = 0;
+        int held_ = -1;
+        bool stopped_ = false;
+        std::vector<slot> slots_;
+        std::unique_ptr<std::byte, detail::page_deleter> buffers_;
+#if ILP_HAS_IO_URING
+        std::unique_ptr<detail::uring_queue> ring_; // after buffers_: unregistered before they are freed
+        bool fixed_ = false;
+#endif
+    };
+
+} // namespace ilp
@@ -0,0 +1,269 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ILP_HAS_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define ILP_HAS_MMAP 0
+#include <fstream>
+#endif
+
+// Default readahead window for mapped_file, in bytes. Override with -DILP_MMAP_WINDOW=N.
+#ifndef ILP_MMAP_WINDOW
+#define ILP_MMAP_WINDOW (std::size_t{4} << 20)
+#endif
+
+namespace ilp {
+
+    namespace detail {
+
+        // Window bookkeeping shared by every iterator of one mapping.
+        // Crossing into window k prefetches window k+1 and releases everything before window k-1,
+        // so at most three windows are resident and an early exit touches at most one more.
+        struct mmap_advisor {
+            const std::byte* base = nullptr;
+            std::size_t bytes = 0;
+            std::size_t window = 0;       // bytes, page multiple
+            std::size_t next_check = 0;   // element index that triggers the next advance()
+            std::size_t released = 0;     // bytes [0, released) have been dropped
+            std::size_t elem_size = 1;
+            bool release_behind = true;
+
+            void advise(std::size_t from, std::size_t to, [[maybe_unused]] int advice) const noexcept {
+                if (to > bytes)
+                    to = bytes;
+                if (from >= to)
+                    return;
+#if ILP_HAS_MMAP
+                ::madvise(const_cast<std::byte*>(base) + from, to - from, advice);
+#endif
+            }
+
+            void start() noexcept {
+#if ILP_HAS_MMAP
+                advise(0, bytes, MADV_SEQUENTIAL);
+                advise(0, 2 * window, MADV_WILLNEED);
+#endif
+                next_check = (window + elem_size - 1) / elem_size;
+            }
+
+            void advance(std::size_t index) noexcept {
+                const std::size_t k = index * elem_size / window;
+#if ILP_HAS_MMAP
+                advise((k + 1) * window, (k + 2) * window, MADV_WILLNEED);
+                if (release_behind && k >= 2) {
+                    const std::size_t behind = (k - 1) * window;
+                    if (behind > released) {
+                        advise(released, behind, MADV_DONTNEED);
+                        released = behind;
+                    }
+                }
+#endif
+                next_check = ((k + 1) * window + elem_size - 1) / elem_size; // first element of window k+1
+            }
+        };
+
+    } // namespace detail
+
+    // Read-only file viewed as a random-access range of T, for ILP_FOR_RANGE and friends.
+    // The file is mapped rather than read, so the scan starts at once and only touches the pages
+    // it reaches. Element access past the current window issues the next readahead hint and
+    // (by default) drops pages two windows behind the cursor. Backwards access still works;
+    // dropped pages fault back in from the page cache.
+    // Trailing bytes that don't fill a whole T are not part of the range. The advice state is
+    // shared, so one mapping shouldn't be scanned from several threads at once.
+    template<typename T>
+    class mapped_file {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_file<T> requires a trivially copyable T");
+
+      public:
+        class iterator {
+          public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = const T&;
+            using pointer = const T*;
+
+            iterator() = default;
+
+            reference operator*() const noexcept { return at(pos_); }
+            reference operator[](difference_type n) const noexcept { return at(pos_ + static_cast<std::size_t>(n)); }
+
+            iterator& operator++() noexcept {
+                ++pos_;
+                return *this;
+            }
+            iterator operator++(int) noexcept { return iterator{adv_, data_, pos_++}; }
+            iterator& operator--() noexcept {
+                --pos_;
+                return *this;
+            }
+            iterator operator--(int) noexcept { return iterator{adv_, data_, pos_--}; }
+
+            iterator& operator+=(difference_type n) noexcept {
+                pos_ += static_cast<std::size_t>(n);
+                return *this;
+            }
+            iterator& operator-=(difference_type n) noexcept {
+                pos_ -= static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+            friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+            friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const iterator& a, const iterator& b) noexcept {
+                return static_cast<difference_type>(a.pos_) - static_cast<difference_type>(b.pos_);
+            }
+
+            friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.pos_ == b.pos_; }
+            friend auto operator<=>(const iterator& a, const iterator& b) noexcept { return a.pos_ <=> b.pos_; }
+
+          private:
+            friend class mapped_file;
+
+            iterator(detail::mmap_advisor* adv, const T* data, std::size_t pos) noexcept
+                : adv_(adv), data_(data), pos_(pos) {}
+
+            const T& at(std::size_t index) const noexcept {
+                if (index >= adv_->next_check) [[unlikely]]
+                    adv_->advance(index);
+                return data_[index];
+            }
+
+            detail::mmap_advisor* adv_ = nullptr;
+            const T* data_ = nullptr;
+            std::size_t pos_ = 0;
+        };
+
+        // window_bytes is rounded up to a whole number of pages
+        explicit mapped_file(const std::filesystem::path& path, std::size_t window_bytes = ILP_MMAP_WINDOW,
+                             bool release_behind = true)
+            : adv_(std::make_unique<detail::mmap_advisor>()) {
+            open(path);
+            const std::size_t page = page_size();
+            adv_->window = window_bytes < page ? page : (window_bytes + page - 1) / page * page;
+            adv_->elem_size = sizeof(T);
+            adv_->release_behind = release_behind;
+            adv_->start();
+        }
+
+        mapped_file(mapped_file&& o) noexcept
+            : adv_(std::move(o.adv_)), data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0)),
+              buffer_(std::move(o.buffer_)) {}
+
+        mapped_file& operator=(mapped_file&& o) noexcept {
+            if (this != &o) {
+                unmap();
+                adv_ = std::move(o.adv_);
+                data_ = std::exchange(o.data_, nullptr);
+                size_ = std::exchange(o.size_, 0);
+                buffer_ = std::move(o.buffer_);
+            }
+            return *this;
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        ~mapped_file() { unmap(); }
+
+        iterator begin() const noexcept { return iterator{adv_.get(), data_, 0}; }
+        iterator end() const noexcept { return iterator{adv_.get(), data_, size_}; }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        // Raw pointer to the mapping; access through it bypasses the readahead hints
+        const T* data() const noexcept { return data_; }
+
+        std::size_t size_bytes() const noexcept { return adv_ ? adv_->bytes : 0; }
+
+      private:
+        static std::size_t page_size() noexcept {
+#if ILP_HAS_MMAP
+            return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#else
+            return 4096;
+#endif
+        }
+
+#if ILP_HAS_MMAP
+        void open(const std::filesystem::path& path) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), path.string());
+
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), path.string());
+            }
+
+            const auto bytes = static_cast<std::size_t>(st.st_size);
+            if (bytes > 0) {
+                void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+                if (p == MAP_FAILED) {
+                    int err = errno;
+                    ::close(fd);
+                    throw std::system_error(err, std::generic_category(), path.string());
+                }
+                data_ = static_cast<const T*>(p);
+            }
+            ::close(fd); // the mapping keeps the file alive
+
+            adv_->base = reinterpret_cast<const std::byte*>(data_);
+            adv_->bytes = bytes;
+            size_ = bytes / sizeof(T);
+        }
+
+        void unmap() noexcept {
+            if (data_ && adv_)
+                ::munmap(const_cast<T*>(data_), adv_->bytes);
+            data_ = nullptr;
+        }
+#else
+        // No mmap: read the whole file up front. Same interface, no streaming.
+        void open(const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), path.string());
+            const auto bytes = static_cast<std::size_t>(std::filesystem::file_size(path));
+            size_ = bytes / sizeof(T);
+            buffer_ = std::make_unique<T[]>(size_);
+            in.read(reinterpret_cast<char*>(buffer_.get()), static_cast<std::streamsize>(size_ * sizeof(T)));
+            data_ = buffer_.get();
+            adv_->base = reinterpret_cast<const std::byte*>(data_);
+            adv_->bytes = size_ * sizeof(T);
+        }
+
+        void unmap() noexcept { data_ = nullptr; }
+#endif
+
+        std::unique_ptr<detail::mmap_advisor> adv_; // stable address for iterators across moves
+        const T* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::unique_ptr<T[]> buffer_; // non-mmap fallback only
+    };
+
+} // namespace ilp
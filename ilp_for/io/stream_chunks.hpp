@@ -0,0 +1,283 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "ilp_for/io/stream_chunks.hpp requires POSIX file descriptors"
+#endif
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace ilp {
+
+    namespace detail {
+
+        struct line_deleter {
+            void operator()(std::byte* p) const noexcept { ::operator delete(p, std::align_val_t{64}); }
+        };
+
+    } // namespace detail
+
+    // Reads a file descriptor (pipe, socket, stdin, file) as a sequence of chunks of T, double
+    // buffered: a reader thread fills one buffer while the caller runs its loop over the other.
+    //
+    //   ilp::stream_chunks<char> in(STDIN_FILENO, 1 << 16, '\n');
+    //   for (auto chunk : in) {
+    //       ILP_FOR_RANGE(auto c, chunk, 8) { ... } ILP_END;
+    //   }
+    //
+    // Chunk capacity is a multiple of N elements, so under steady input every chunk but the last
+    // is full and the unrolled loop has no remainder. With a delimiter, each chunk ends on a
+    // delimiter and the partial record after it is carried to the front of the next chunk
+    // (a record longer than a whole chunk is split). If less than a chunk is available, whatever
+    // has arrived is delivered rather than waiting for more.
+    // The two buffers are allocated up front; steady state doesn't allocate.
+    // stop() or destruction stops reading: the reader is woken through poll(), so it never
+    // blocks in read(), and at most one chunk past the caller's position has been read.
+    template<typename T = char, std::size_t N = 16>
+    class stream_chunks {
+        static_assert(std::is_trivially_copyable_v<T>, "stream_chunks<T> requires a trivially copyable T");
+        static_assert(N >= 1, "N must be at least 1");
+
+      public:
+        explicit stream_chunks(int fd, std::size_t chunk_elems = (std::size_t{64} << 10) / sizeof(T),
+                               std::optional<T> delimiter = std::nullopt)
+            : fd_(fd), delimiter_(delimiter) {
+            if (fd < 0)
+                throw std::system_error(EBADF, std::generic_category(), "stream_chunks: fd");
+            chunk_elems = chunk_elems < N ? N : (chunk_elems + N - 1) / N * N;
+            capacity_ = chunk_elems * sizeof(T);
+            for (auto& slot : slots_)
+                slot.data.reset(static_cast<std::byte*>(::operator new(capacity_, std::align_val_t{64})));
+
+            if (::pipe(wake_) != 0)
+                throw std::system_error(errno, std::generic_category(), "stream_chunks: pipe");
+            // The destructor doesn't run for a throwing constructor; the buffers free themselves
+            try {
+                reader_ = std::thread([this] { read_loop(); });
+            } catch (...) {
+                ::close(wake_[0]);
+                ::close(wake_[1]);
+                throw;
+            }
+        }
+
+        stream_chunks(const stream_chunks&) = delete;
+        stream_chunks& operator=(const stream_chunks&) = delete;
+
+        ~stream_chunks() {
+            stop();
+            reader_.join();
+            ::close(wake_[0]);
+            ::close(wake_[1]);
+        }
+
+        // Next chunk; empty at end of input or after stop(). Invalidates the previous chunk.
+        // Rethrows a read error once the chunks read before it have been delivered.
+        std::span<const T> next() {
+            std::unique_lock lock(mutex_);
+            if (held_) {
+                slots_[consume_].filled = false;
+                consume_ ^= 1;
+                held_ = false;
+                cv_.notify_all();
+            }
+            cv_.wait(lock, [&] { return slots_[consume_].filled || finished_; });
+
+            slot& s = slots_[consume_];
+            if (s.filled) {
+                held_ = true;
+                return {reinterpret_cast<const T*>(s.data.get()), s.count};
+            }
+            if (error_)
+                throw std::system_error(error_, std::generic_category(), "stream_chunks: read");
+            return {};
+        }
+
+        // Stop reading. Chunks already read are still returned by next().
+        void stop() noexcept {
+            {
+                std::lock_guard lock(mutex_);
+                if (stopping_)
+                    return;
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            const char byte = 1;
+            [[maybe_unused]] auto w = ::write(wake_[1], &byte, 1);
+        }
+
+        std::size_t chunk_capacity() const noexcept { return capacity_ / sizeof(T); }
+
+        class iterator {
+          public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = std::span<const T>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            value_type operator*() const { return chunk_; }
+
+            iterator& operator++() {
+                chunk_ = src_->next();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.chunk_.empty(); }
+
+          private:
+            friend class stream_chunks;
+            explicit iterator(stream_chunks* src) : src_(src), chunk_(src->next()) {}
+
+            stream_chunks* src_ = nullptr;
+            value_type chunk_;
+        };
+
+        iterator begin() { return iterator{this}; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+      private:
+        struct slot {
+            std::unique_ptr<std::byte, detail::line_deleter> data;
+            std::size_t count = 0; // whole elements delivered
+            bool filled = false;
+        };
+
+        // Waits until fd is readable; false if woken by stop()
+        bool wait_readable(int timeout_ms) {
+            pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_[0], POLLIN, 0}};
+            for (;;) {
+                int r = ::poll(fds, 2, timeout_ms);
+                if (r < 0 && errno == EINTR)
+                    continue;
+                if (r <= 0 || (fds[1].revents & POLLIN))
+                    return false;
+                return true;
+            }
+        }
+
+        // Bytes of a filled buffer that form the chunk; the rest is carried to the next buffer
+        std::size_t deliverable(const std::byte* data, std::size_t filled, bool eof) const noexcept {
+            const std::size_t whole = filled / sizeof(T) * sizeof(T);
+            if (eof || !delimiter_)
+                return whole;
+            for (std::size_t off = whole; off >= sizeof(T); off -= sizeof(T)) {
+                T v;
+                std::memcpy(&v, data + off - sizeof(T), sizeof(T));
+                if (v == *delimiter_)
+                    return off;
+            }
+            return filled == capacity_ ? whole : 0; // no delimiter: split only when the buffer is full
+        }
+
+        void read_loop() {
+            int fill = 0;
+            std::size_t carry = 0;
+            const std::byte* carry_from = nullptr;
+
+            for (;;) {
+                {
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [&] { return !slots_[fill].filled || stopping_; });
+                    if (stopping_)
+                        break;
+                }
+
+                slot& s = slots_[fill];
+                if (carry)
+                    std::memmove(s.data.get(), carry_from, carry); // tail of the other buffer, never delivered
+                std::size_t filled = carry;
+                bool eof = false;
+                int err = 0;
+                std::size_t deliver = 0;
+
+                while (filled < capacity_) {
+                    // Block only when nothing deliverable has arrived yet
+                    if (!wait_readable(deliver ? 0 : -1)) {
+                        if (deliver)
+                            break;
+                        eof = true; // stopped
+                        break;
+                    }
+                    ssize_t n = ::read(fd_, s.data.get() + filled, capacity_ - filled);
+                    if (n < 0) {
+                        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                            continue;
+                        err = errno;
+                        eof = true;
+                        break;
+                    }
+                    if (n == 0) {
+                        eof = true;
+                        break;
+                    }
+                    filled += static_cast<std::size_t>(n);
+                    deliver = deliverable(s.data.get(), filled, false);
+                }
+
+                if (eof)
+                    deliver = deliverable(s.data.get(), filled, true);
+                else if (filled == capacity_)
+                    deliver = deliverable(s.data.get(), filled, false);
+                carry = eof ? 0 : filled - deliver;
+                carry_from = s.data.get() + deliver;
+
+                std::lock_guard lock(mutex_);
+                if (deliver) {
+                    s.count = deliver / sizeof(T);
+                    s.filled = true;
+                    fill ^= 1;
+                }
+                if (eof) {
+                    error_ = err;
+                    break;
+                }
+                cv_.notify_all();
+            }
+
+            std::lock_guard lock(mutex_);
+            finished_ = true;
+            cv_.notify_all();
+        }
+
+        int fd_;
+        std::optional<T> delimiter_;
+        std::size_t capacity_ = 0; // bytes per buffer
+        std::array<slot, 2> slots_{};
+        int wake_[2] = {-1, -1};
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        int consume_ = 0;
+        bool held_ = false;
+        bool stopping_ = false;
+        bool finished_ = false;
+        int error_ = 0;
+
+        std::thread reader_; // last: starts after everything above is initialized
+    };
+
+} // namespace ilp
@@ -0,0 +1,314 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../detail/ctrl.hpp"
+#include "../detail/loops_common.hpp"
+
+namespace ilp {
+
+    namespace bitpack {
+
+        // Value k of a Bits-wide column is bits [k * Bits, (k + 1) * Bits) of a little-endian
+        // stream of 64-bit words, so a value may straddle two words
+        template<unsigned Bits>
+        using value_t = std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>;
+
+        constexpr std::size_t words_for(unsigned bits, std::size_t count) noexcept {
+            return (count * bits + 63) / 64;
+        }
+
+        template<unsigned Bits>
+        inline constexpr std::uint64_t mask = Bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << Bits) - 1;
+
+        // Value i, with the shift worked out at run time
+        template<unsigned Bits>
+        ILP_ALWAYS_INLINE value_t<Bits> get(const std::uint64_t* words, std::size_t i) noexcept {
+            const std::size_t bit = i * Bits;
+            const std::size_t w = bit / 64;
+            const unsigned shift = static_cast<unsigned>(bit % 64);
+            std::uint64_t v = words[w] >> shift;
+            if (shift + Bits > 64)
+                v |= words[w + 1] << (64 - shift);
+            return static_cast<value_t<Bits>>(v & mask<Bits>);
+        }
+
+        // Value K counted from a word boundary: the word, shift and straddle are constants
+        template<unsigned Bits, std::size_t K>
+        ILP_ALWAYS_INLINE value_t<Bits> get(const std::uint64_t* words) noexcept {
+            constexpr std::size_t bit = K * Bits;
+            constexpr unsigned shift = bit % 64;
+            std::uint64_t v = words[bit / 64] >> shift;
+            if constexpr (shift + Bits > 64)
+                v |= words[bit / 64 + 1] << (64 - shift);
+            return static_cast<value_t<Bits>>(v & mask<Bits>);
+        }
+
+        // Pack values (each below 2^Bits) into the word stream get() reads
+        template<unsigned Bits, std::ranges::input_range R>
+        std::vector<std::uint64_t> pack(R&& values) {
+            std::vector<std::uint64_t> words;
+            std::size_t count = 0;
+            for (auto&& x : values) {
+                const auto v = static_cast<std::uint64_t>(x);
+                assert((v & ~mask<Bits>) == 0 && "value doesn't fit in Bits");
+                const std::size_t bit = count * Bits;
+                const std::size_t w = bit / 64;
+                const unsigned shift = static_cast<unsigned>(bit % 64);
+                if (words.size() < w + 2)
+                    words.resize(w + 2);
+                words[w] |= v << shift;
+                if (shift + Bits > 64)
+                    words[w + 1] |= v >> (64 - shift);
+                ++count;
+            }
+            words.resize(words_for(Bits, count));
+            return words;
+        }
+
+    } // namespace bitpack
+
+    namespace detail {
+
+        // Random-access iterator over any view with operator[] and size()
+        template<typename View>
+        class index_iterator {
+          public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using reference = decltype(std::declval<const View&>()[std::size_t{}]);
+            using value_type = std::remove_cvref_t<reference>;
+            using difference_type = std::ptrdiff_t;
+
+            index_iterator() = default;
+            index_iterator(const View* view, std::size_t pos) noexcept : view_(view), pos_(pos) {}
+
+            reference operator*() const { return (*view_)[pos_]; }
+            reference operator[](difference_type n) const { return (*view_)[pos_ + static_cast<std::size_t>(n)]; }
+
+            index_iterator& operator++() noexcept {
+                ++pos_;
+                return *this;
+            }
+            index_iterator operator++(int) noexcept { return {view_, pos_++}; }
+            index_iterator& operator--() noexcept {
+                --pos_;
+                return *this;
+            }
+            index_iterator operator--(int) noexcept { return {view_, pos_--}; }
+
+            index_iterator& operator+=(difference_type n) noexcept {
+                pos_ += static_cast<std::size_t>(n);
+                return *this;
+            }
+            index_iterator& operator-=(difference_type n) noexcept {
+                pos_ -= static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            friend index_iterator operator+(index_iterator it, difference_type n) noexcept { return it += n; }
+            friend index_iterator operator+(difference_type n, index_iterator it) noexcept { return it += n; }
+            friend index_iterator operator-(index_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const index_iterator& a, const index_iterator& b) noexcept {
+                return static_cast<difference_type>(a.pos_) - static_cast<difference_type>(b.pos_);
+            }
+
+            friend bool operator==(const index_iterator& a, const index_iterator& b) noexcept {
+                return a.pos_ == b.pos_;
+            }
+            friend auto operator<=>(const index_iterator& a, const index_iterator& b) noexcept {
+                return a.pos_ <=> b.pos_;
+            }
+
+          private:
+            const View* view_ = nullptr;
+            std::size_t pos_ = 0;
+        };
+
+    } // namespace detail
+
+    // Read-only view of a bit-packed integer column: size values of Bits bits each in words.
+    // Indexing and iteration decode one value at a time, so it works with ILP_FOR_RANGE;
+    // for_each_decoded unpacks whole blocks with every shift known at compile time.
+    template<unsigned Bits>
+    class packed_view {
+        static_assert(Bits >= 1 && Bits <= 64, "packed_view needs 1 to 64 bits per value");
+
+      public:
+        using value_type = bitpack::value_t<Bits>;
+        static constexpr unsigned bits = Bits;
+
+        packed_view() = default;
+        packed_view(std::span<const std::uint64_t> words, std::size_t size) noexcept : words_(words), size_(size) {
+            assert(words.size() >= bitpack::words_for(Bits, size) && "too few words for size values");
+        }
+
+        value_type operator[](std::size_t i) const noexcept { return bitpack::get<Bits>(words_.data(), i); }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        std::span<const std::uint64_t> words() const noexcept { return words_; }
+
+        detail::index_iterator<packed_view> begin() const noexcept { return {this, 0}; }
+        detail::index_iterator<packed_view> end() const noexcept { return {this, size_}; }
+
+      private:
+        std::span<const std::uint64_t> words_;
+        std::size_t size_ = 0;
+    };
+
+    // Dictionary-encoded column: element i is dict[codes[i]]. Codes is a packed_view or any
+    // random-access range of integers, held by value (pass a view or a span).
+    template<typename Codes, typename Dict>
+    class dict_view {
+      public:
+        dict_view(Codes codes, const Dict& dict) : codes_(std::move(codes)), dict_(&dict) {}
+
+        decltype(auto) operator[](std::size_t i) const {
+            return (*dict_)[static_cast<std::size_t>(std::ranges::begin(codes_)[static_cast<std::ptrdiff_t>(i)])];
+        }
+
+        std::size_t size() const noexcept { return static_cast<std::size_t>(std::ranges::size(codes_)); }
+        bool empty() const noexcept { return size() == 0; }
+        const Codes& codes() const noexcept { return codes_; }
+        const Dict& dict() const noexcept { return *dict_; }
+
+        detail::index_iterator<dict_view> begin() const noexcept { return {this, 0}; }
+        detail::index_iterator<dict_view> end() const noexcept { return {this, size()}; }
+
+      private:
+        Codes codes_;
+        const Dict* dict_;
+    };
+
+    template<typename Codes, typename Dict>
+    dict_view(Codes, const Dict&) -> dict_view<Codes, Dict>;
+
+    namespace detail {
+
+        template<typename F, typename V>
+        concept DecodedBody = std::invocable<F, V>;
+
+        template<typename F, typename V>
+        concept DecodedCtrlBody = std::invocable<F, V, LoopCtrl<void>&>;
+
+        // Calls body(v) or body(v, ctrl); true when the body broke
+        template<typename F, typename V>
+        ILP_ALWAYS_INLINE bool decoded_call(F& body, V&& v, LoopCtrl<void>& ctrl) {
+            if constexpr (DecodedCtrlBody<F, V>) {
+                body(std::forward<V>(v), ctrl);
+                return !ctrl.ok;
+            } else {
+                body(std::forward<V>(v));
+                return false;
+            }
+        }
+
+        // Block of a unit: decodes its N values, then runs the body over them. Returns the
+        // breaking element's position in the unit plus one, or 0 if the body didn't break.
+        template<std::size_t N, unsigned Bits, std::size_t Block, typename Lookup, typename F>
+        ILP_ALWAYS_INLINE std::size_t packed_block(const std::uint64_t* unit, Lookup& lookup, F& body,
+                                                   LoopCtrl<void>& ctrl) {
+            const auto values = [&]<std::size_t... J>(std::index_sequence<J...>) {
+                return std::array<bitpack::value_t<Bits>, N>{bitpack::get<Bits, Block * N + J>(unit)...};
+            }(std::make_index_sequence<N>{});
+            for (std::size_t j = 0; j < N; ++j) {
+                if (decoded_call(body, lookup(values[j]), ctrl)) [[unlikely]]
+                    return Block * N + j + 1;
+            }
+            return 0;
+        }
+
+        // Unpacks N values at a time and hands each through lookup to the body. A unit of
+        // lcm(N, 64 / gcd(Bits, 64)) values starts on a word boundary, so each of its blocks is
+        // decoded with constant shifts; a break stops before the next block is decoded.
+        // Returns the values delivered.
+        template<std::size_t N, unsigned Bits, typename Lookup, typename F>
+        std::size_t for_each_packed_impl(const packed_view<Bits>& col, Lookup&& lookup, F& body) {
+            validate_unroll_factor<N>();
+            constexpr std::size_t group = 64 / std::gcd(std::size_t{Bits}, std::size_t{64});
+            constexpr std::size_t unit = std::lcm(N, group);
+            constexpr std::size_t unit_words = unit * Bits / 64;
+
+            const std::uint64_t* base = col.words().data();
+            const std::size_t size = col.size();
+            LoopCtrl<void> ctrl;
+            std::size_t i = 0;
+
+            for (const std::uint64_t* w = base; i + unit <= size; i += unit, w += unit_words) {
+                std::size_t stop = 0;
+                [&]<std::size_t... B>(std::index_sequence<B...>) {
+                    (void)((stop = packed_block<N, Bits, B>(w, lookup, body, ctrl)) || ...);
+                }(std::make_index_sequence<unit / N>{});
+                if (stop != 0) [[unlikely]]
+                    return i + stop;
+            }
+
+            for (; i < size; ++i) {
+                if (decoded_call(body, lookup(bitpack::get<Bits>(base, i)), ctrl)) [[unlikely]]
+                    return i + 1;
+            }
+            return size;
+        }
+
+    } // namespace detail
+
+    // Decode a packed or dictionary-encoded column straight into the body: body(value) for each
+    // element, or body(value, LoopCtrl<void>&) to stop early. Packed codes are unpacked N at a
+    // time with compile-time shifts; dictionary entries are passed by reference. Nothing past the
+    // block holding the breaking element is decoded. Returns the elements delivered.
+    template<std::size_t N = 8, unsigned Bits, typename F>
+        requires detail::DecodedBody<F, bitpack::value_t<Bits>> ||
+                 detail::DecodedCtrlBody<F, bitpack::value_t<Bits>>
+    std::size_t for_each_decoded(const packed_view<Bits>& col, F&& body) {
+        return detail::for_each_packed_impl<N>(col, [](auto v) { return v; }, body);
+    }
+
+    template<std::size_t N = 8, unsigned Bits, typename Dict, typename F>
+    std::size_t for_each_decoded(const dict_view<packed_view<Bits>, Dict>& col, F&& body) {
+        const Dict& dict = col.dict();
+        return detail::for_each_packed_impl<N>(
+            col.codes(), [&](auto code) -> decltype(auto) { return dict[static_cast<std::size_t>(code)]; }, body);
+    }
+
+    // Dictionary over plain codes: only the lookup to fuse
+    template<std::size_t N = 8, typename Codes, typename Dict, typename F>
+    std::size_t for_each_decoded(const dict_view<Codes, Dict>& col, F&& body) {
+        detail::validate_unroll_factor<N>();
+        LoopCtrl<void> ctrl;
+        const std::size_t size = col.size();
+        std::size_t i = 0;
+        for (; i + N <= size; i += N) {
+            for (std::size_t j = 0; j < N; ++j) {
+                if (detail::decoded_call(body, col[i + j], ctrl)) [[unlikely]]
+                    return i + j + 1;
+            }
+        }
+        for (; i < size; ++i) {
+            if (detail::decoded_call(body, col[i], ctrl)) [[unlikely]]
+                return i + 1;
+        }
+        return size;
+    }
+
+} // namespace ilp
+
+namespace std::ranges {
+    template<unsigned Bits>
+    inline constexpr bool enable_borrowed_range<ilp::packed_view<Bits>> = true;
+} // namespace std::ranges
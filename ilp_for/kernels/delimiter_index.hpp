@@ -0,0 +1,157 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "swar.hpp"
+
+namespace ilp {
+
+    // Structural index for delimited text (CSV, TSV, newline-delimited logs).
+    // One pass over the buffer, 64 bytes at a time: each 8-byte word is compared against every
+    // delimiter with exact SWAR byte matches, the hits become a 64-bit mask, and quoted regions
+    // are masked out with a prefix XOR of the quote bits (so "" escapes cancel out by themselves).
+    // The result is the sorted offsets of every delimiter outside quotes. Field extraction is
+    // then random access instead of a char-by-char state machine.
+    //
+    //   ilp::delimiter_index idx(",\n");
+    //   idx.build(csv);
+    //   auto f = idx.field(csv, 7);       // text between the 7th delimiter and the 8th
+    //
+    // append() continues an index across chunks, carrying the quote state, with offsets
+    // relative to the first byte passed to build(). Offsets are 32-bit: up to 4 GiB per index.
+    class delimiter_index {
+      public:
+        static constexpr std::size_t max_delimiters = 4;
+
+        // delimiters: up to 4 distinct bytes. quote: '\0' disables quote tracking.
+        explicit delimiter_index(std::string_view delimiters, char quote = '"') : count_(delimiters.size()) {
+            assert(!delimiters.empty() && delimiters.size() <= max_delimiters && "1 to 4 delimiter bytes");
+            if (count_ > max_delimiters)
+                count_ = max_delimiters;
+            for (std::size_t d = 0; d < count_; ++d)
+                patterns_[d] = swar::broadcast(static_cast<std::uint8_t>(delimiters[d]));
+            quoted_ = quote != '\0';
+            quote_pattern_ = swar::broadcast(static_cast<std::uint8_t>(quote));
+        }
+
+        // Index text from scratch
+        std::span<const std::uint32_t> build(std::string_view text) {
+            size_ = 0;
+            base_ = 0;
+            in_quote_ = 0;
+            return append(text);
+        }
+
+        // Continue the index with the next bytes of the same stream
+        std::span<const std::uint32_t> append(std::string_view text) {
+            assert(base_ + text.size() <= std::numeric_limits<std::uint32_t>::max() && "index limited to 4 GiB");
+            const char* p = text.data();
+            const std::size_t n = text.size();
+            std::size_t i = 0;
+            for (; i + swar::block_bytes <= n; i += swar::block_bytes) {
+                if (capacity_ - size_ < swar::block_bytes) [[unlikely]]
+                    grow(n - i);
+                size_ = emit(block_mask(p + i, swar::block_bytes), static_cast<std::uint32_t>(base_ + i), size_);
+            }
+
+            if (i < n) {
+                alignas(8) char tail[swar::block_bytes] = {};
+                std::memcpy(tail, p + i, n - i);
+                if (capacity_ - size_ < swar::block_bytes)
+                    grow(n - i);
+                size_ = emit(block_mask(tail, n - i), static_cast<std::uint32_t>(base_ + i), size_);
+            }
+
+            base_ += n;
+            return offsets();
+        }
+
+        std::span<const std::uint32_t> offsets() const noexcept { return {offsets_.get(), size_}; }
+        std::size_t size() const noexcept { return size_; }
+
+        // True if the indexed text ended inside an open quote
+        bool in_quote() const noexcept { return in_quote_ != 0; }
+
+        // Bytes between delimiter k-1 and delimiter k (field 0 starts at offset 0).
+        // field(text, size()) is whatever follows the last delimiter.
+        std::string_view field(std::string_view text, std::size_t k) const noexcept {
+            const std::size_t begin = k == 0 ? 0 : offsets_[k - 1] + 1;
+            const std::size_t end = k < size_ ? offsets_[k] : text.size();
+            return text.substr(begin, end - begin);
+        }
+
+      private:
+        // Mask of structural delimiters among the first len (<= 64) bytes of block
+        std::uint64_t block_mask(const char* block, std::size_t len) noexcept {
+            std::uint64_t delims = 0;
+            std::uint64_t quotes = 0;
+            for (std::size_t w = 0; w < swar::block_bytes / 8; ++w) {
+                const std::uint64_t word = swar::load_le(block + w * 8);
+                std::uint64_t hit = 0;
+                for (std::size_t d = 0; d < max_delimiters; ++d)
+                    if (d < count_)
+                        hit |= swar::equal_bytes(word, patterns_[d]);
+                delims |= swar::high_bit_mask(hit) << (w * 8);
+                quotes |= swar::high_bit_mask(swar::equal_bytes(word, quote_pattern_)) << (w * 8);
+            }
+
+            const std::uint64_t valid = swar::low_mask(len);
+            delims &= valid;
+            if (!quoted_)
+                return delims;
+
+            // Bit i is set while byte i is inside quotes (the opening quote itself included)
+            const std::uint64_t inside = swar::prefix_xor(quotes & valid) ^ in_quote_;
+            // Quote bits past len are masked off, so bit 63 is the state after the last real byte
+            in_quote_ = static_cast<std::uint64_t>(static_cast<std::int64_t>(inside) >> 63);
+            return delims & ~inside;
+        }
+
+        std::size_t emit(std::uint64_t mask, std::uint32_t base, std::size_t at) noexcept {
+            std::uint32_t* out = offsets_.get() + at;
+            while (mask) {
+                *out++ = base + static_cast<std::uint32_t>(std::countr_zero(mask));
+                mask &= mask - 1;
+            }
+            return static_cast<std::size_t>(out - offsets_.get());
+        }
+
+        // Room for at least one more block; sized from the remaining input (a delimiter every
+        // 8 bytes or so) and doubled when that guess runs out. Not zero-filled.
+        void grow(std::size_t remaining) {
+            const std::size_t wanted = size_ + std::max(remaining / 8, swar::block_bytes) + swar::block_bytes;
+            const std::size_t cap = std::max(wanted, capacity_ * 2);
+            auto bigger = std::make_unique_for_overwrite<std::uint32_t[]>(cap);
+            if (size_)
+                std::memcpy(bigger.get(), offsets_.get(), size_ * sizeof(std::uint32_t));
+            offsets_ = std::move(bigger);
+            capacity_ = cap;
+        }
+
+        std::array<std::uint64_t, max_delimiters> patterns_{};
+        std::size_t count_;
+        std::uint64_t quote_pattern_ = 0;
+        bool quoted_ = true;
+        std::uint64_t in_quote_ = 0; // all ones while inside quotes across a block boundary
+        std::size_t base_ = 0;
+        std::unique_ptr<std::uint32_t[]> offsets_;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+    };
+
+} // namespace ilp
@@ -0,0 +1,363 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "../cpu_profiles/ilp_cpu.hpp"
+#include "../detail/ctrl.hpp"
+#include "../detail/loops_common.hpp"
+#include "swar.hpp"
+
+// Hardware CRC32C: SSE4.2 on x86-64, the CRC extension on ARMv8. -DILP_NO_HW_CRC32C forces the table.
+#if !defined(ILP_NO_HW_CRC32C) && (defined(__x86_64__) || defined(_M_X64)) &&                                          \
+    (defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__)))
+#define ILP_HAS_HW_CRC32C 1
+#include <nmmintrin.h>
+#elif !defined(ILP_NO_HW_CRC32C) && defined(__ARM_FEATURE_CRC32) && (defined(__aarch64__) || defined(_M_ARM64))
+#define ILP_HAS_HW_CRC32C 1
+#include <arm_acle.h>
+#else
+#define ILP_HAS_HW_CRC32C 0
+#endif
+
+namespace ilp {
+
+    // Hashes and checksums with N independent state lanes.
+    //
+    // A single-state hash is one dependency chain: every word waits for the multiply (or CRC) of
+    // the word before. striped_hash<Algo, N> keeps N lanes, steps them in lock-step over the input
+    // and combines them at the end, so N chains are in flight at once.
+    //
+    // An Algo provides:
+    //   state_type, result_type
+    //   static constexpr LoopType loop_type      // picks striped_fast_N through optimal_N
+    //   static constexpr bool segmented          // false: lane j takes word j of every N-word stripe
+    //                                            // true:  lane j takes the j-th contiguous segment
+    //   static constexpr bool lane_invariant     // the value is the same for every N
+    //   static state_type init(std::uint64_t seed, std::size_t lane)
+    //   static state_type step(state_type, std::uint64_t word)       // 8 bytes, little-endian
+    //   static result_type finish(std::span<const state_type, N> lanes, std::size_t lane_bytes,
+    //                             const std::uint8_t* tail, std::size_t tail_len,
+    //                             std::uint64_t total_len, std::uint64_t seed)
+    namespace hash {
+
+        // FNV-1a, 64-bit. N = 1 is standard FNV-1a. With N lanes the lane values are folded into
+        // lane 0 as bytes, then the tail bytes follow.
+        struct fnv1a {
+            using state_type = std::uint64_t;
+            using result_type = std::uint64_t;
+            static constexpr LoopType loop_type = LoopType::Multiply;
+            static constexpr bool segmented = false;
+            static constexpr bool lane_invariant = false;
+
+            static constexpr std::uint64_t basis = 0xCBF29CE484222325ull;
+            static constexpr std::uint64_t prime = 0x00000100000001B3ull;
+
+            static constexpr state_type init(std::uint64_t seed, std::size_t lane) noexcept {
+                return basis ^ seed ^ (lane * 0x9E3779B97F4A7C15ull);
+            }
+
+            ILP_ALWAYS_INLINE static constexpr state_type step(state_type h, std::uint64_t word) noexcept {
+                for (int b = 0; b < 8; ++b) {
+                    h = (h ^ (word & 0xFF)) * prime;
+                    word >>= 8;
+                }
+                return h;
+            }
+
+            template<std::size_t N>
+            static result_type finish(std::span<const state_type, N> lanes, std::size_t, const std::uint8_t* tail,
+                                      std::size_t tail_len, std::uint64_t, std::uint64_t) noexcept {
+                state_type h = lanes[0];
+                for (std::size_t j = 1; j < N; ++j)
+                    h = step(h, lanes[j]);
+                for (std::size_t i = 0; i < tail_len; ++i)
+                    h = (h ^ tail[i]) * prime;
+                return h;
+            }
+        };
+
+        // XXH64 construction. N = 4 is XXH64 bit for bit; other N use the same round, merge and
+        // tail with N accumulators and an N * 8-byte stripe.
+        struct xxh64 {
+            using state_type = std::uint64_t;
+            using result_type = std::uint64_t;
+            static constexpr LoopType loop_type = LoopType::Multiply;
+            static constexpr bool segmented = false;
+            static constexpr bool lane_invariant = false;
+
+            static constexpr std::uint64_t p1 = 0x9E3779B185EBCA87ull;
+            static constexpr std::uint64_t p2 = 0xC2B2AE3D27D4EB4Full;
+            static constexpr std::uint64_t p3 = 0x165667B19E3779F9ull;
+            static constexpr std::uint64_t p4 = 0x85EBCA77C2B2AE63ull;
+            static constexpr std::uint64_t p5 = 0x27D4EB2F165667C5ull;
+
+            static constexpr state_type init(std::uint64_t seed, std::size_t lane) noexcept {
+                constexpr std::uint64_t offset[4] = {p1 + p2, p2, 0, 0 - p1};
+                return seed + offset[lane % 4] + (lane / 4) * p5;
+            }
+
+            ILP_ALWAYS_INLINE static constexpr state_type step(state_type acc, std::uint64_t word) noexcept {
+                return std::rotl(acc + word * p2, 31) * p1;
+            }
+
+            template<std::size_t N>
+            static result_type finish(std::span<const state_type, N> lanes, std::size_t lane_bytes,
+                                      const std::uint8_t* tail, std::size_t tail_len, std::uint64_t total_len,
+                                      std::uint64_t seed) noexcept {
+                std::uint64_t h;
+                if (lane_bytes > 0) {
+                    constexpr int rot[4] = {1, 7, 12, 18};
+                    h = 0;
+                    for (std::size_t j = 0; j < N; ++j)
+                        h += std::rotl(lanes[j], rot[j % 4] + static_cast<int>(j / 4));
+                    for (std::size_t j = 0; j < N; ++j)
+                        h = (h ^ step(0, lanes[j])) * p1 + p4;
+                } else {
+                    h = seed + p5;
+                }
+                h += total_len;
+
+                std::size_t i = 0;
+                for (; i + 8 <= tail_len; i += 8)
+                    h = std::rotl(h ^ step(0, swar::load_le(tail + i)), 27) * p1 + p4;
+                if (i + 4 <= tail_len) {
+                    std::uint32_t w;
+                    std::memcpy(&w, tail + i, 4);
+                    if constexpr (std::endian::native == std::endian::big)
+                        w = (w >> 24) | ((w >> 8) & 0xFF00u) | ((w << 8) & 0xFF0000u) | (w << 24);
+                    h = std::rotl(h ^ (std::uint64_t{w} * p1), 23) * p2 + p3;
+                    i += 4;
+                }
+                for (; i < tail_len; ++i)
+                    h = std::rotl(h ^ (tail[i] * p5), 11) * p1;
+
+                h ^= h >> 33;
+                h *= p2;
+                h ^= h >> 29;
+                h *= p3;
+                h ^= h >> 32;
+                return h;
+            }
+        };
+
+    } // namespace hash
+
+    namespace detail {
+
+        // CRC32C (Castagnoli), reflected polynomial
+        inline constexpr std::uint32_t crc32c_poly = 0x82F63B78u;
+
+        // Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero bytes
+        constexpr std::array<std::array<std::uint32_t, 256>, 8> make_crc32c_tables() {
+            std::array<std::array<std::uint32_t, 256>, 8> t{};
+            for (std::uint32_t b = 0; b < 256; ++b) {
+                std::uint32_t c = b;
+                for (int k = 0; k < 8; ++k)
+                    c = c & 1 ? (c >> 1) ^ crc32c_poly : c >> 1;
+                t[0][b] = c;
+            }
+            for (std::size_t k = 1; k < 8; ++k)
+                for (std::size_t b = 0; b < 256; ++b)
+                    t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xFF];
+            return t;
+        }
+
+        inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+        ILP_ALWAYS_INLINE std::uint32_t crc32c_word_table(std::uint32_t crc, std::uint64_t word) noexcept {
+            const std::uint64_t x = word ^ crc;
+            const auto& t = crc32c_tables;
+            return t[7][x & 0xFF] ^ t[6][(x >> 8) & 0xFF] ^ t[5][(x >> 16) & 0xFF] ^ t[4][(x >> 24) & 0xFF] ^
+                   t[3][(x >> 32) & 0xFF] ^ t[2][(x >> 40) & 0xFF] ^ t[1][(x >> 48) & 0xFF] ^ t[0][x >> 56];
+        }
+
+        ILP_ALWAYS_INLINE std::uint32_t crc32c_word(std::uint32_t crc, std::uint64_t word) noexcept {
+#if ILP_HAS_HW_CRC32C && (defined(__x86_64__) || defined(_M_X64))
+            return static_cast<std::uint32_t>(_mm_crc32_u64(crc, word));
+#elif ILP_HAS_HW_CRC32C
+            return __crc32cd(crc, word);
+#else
+            return crc32c_word_table(crc, word);
+#endif
+        }
+
+        ILP_ALWAYS_INLINE std::uint32_t crc32c_byte(std::uint32_t crc, std::uint8_t b) noexcept {
+#if ILP_HAS_HW_CRC32C && (defined(__x86_64__) || defined(_M_X64))
+            return _mm_crc32_u8(crc, b);
+#elif ILP_HAS_HW_CRC32C
+            return __crc32cb(crc, b);
+#else
+            return (crc >> 8) ^ crc32c_tables[0][(crc ^ b) & 0xFF];
+#endif
+        }
+
+        // All ones if bit is 1, else 0, without an unsigned wrap
+        constexpr std::uint32_t crc32c_select(std::uint32_t bit) noexcept {
+            return static_cast<std::uint32_t>(-static_cast<std::int32_t>(bit));
+        }
+
+        // a * b modulo the polynomial, both reflected (bit 31 is x^0). Branch-free bit-serial loop.
+        constexpr std::uint32_t crc32c_multmodp(std::uint32_t a, std::uint32_t b) noexcept {
+            std::uint32_t p = 0;
+            for (int i = 0; i < 32; ++i) {
+                p ^= b & crc32c_select((a >> (31 - i)) & 1u);
+                b = (b >> 1) ^ (crc32c_poly & crc32c_select(b & 1u));
+            }
+            return p;
+        }
+
+        // x^(2^k) modulo the polynomial
+        constexpr std::array<std::uint32_t, 64> make_crc32c_x2n() {
+            std::array<std::uint32_t, 64> t{};
+            std::uint32_t p = 1u << 30; // x^1
+            t[0] = p;
+            for (std::size_t k = 1; k < 64; ++k)
+                t[k] = p = crc32c_multmodp(p, p);
+            return t;
+        }
+
+        inline constexpr auto crc32c_x2n = make_crc32c_x2n();
+
+        // x^(8 len) modulo the polynomial: multiplying a CRC register by it appends len zero bytes
+        constexpr std::uint32_t crc32c_x8n(std::uint64_t len) noexcept {
+            std::uint32_t p = 1u << 31; // x^0
+            for (std::size_t k = 3; len; len >>= 1, ++k)
+                if (len & 1)
+                    p = crc32c_multmodp(crc32c_x2n[k], p);
+            return p;
+        }
+
+    } // namespace detail
+
+    namespace hash {
+
+        // CRC32C (iSCSI, ext4, RocksDB), N-way over contiguous segments. The value does not depend
+        // on N: segment registers are joined by multiplying by x^(8 * segment bytes) modulo the
+        // polynomial. The seed is a previous CRC, so crc32c(b, crc32c(a)) == crc32c(a + b).
+        struct crc32c {
+            using state_type = std::uint32_t;
+            using result_type = std::uint32_t;
+            // crc32 is latency 3 at one per cycle on x86, close to the Bitwise entries (3-4 lanes);
+            // the table fallback is load-bound and wants about as many
+            static constexpr LoopType loop_type = LoopType::Bitwise;
+            static constexpr bool segmented = true;
+            static constexpr bool lane_invariant = true;
+
+            static constexpr state_type init(std::uint64_t seed, std::size_t lane) noexcept {
+                return lane == 0 ? ~static_cast<std::uint32_t>(seed) : 0u;
+            }
+
+            ILP_ALWAYS_INLINE static state_type step(state_type crc, std::uint64_t word) noexcept {
+                return detail::crc32c_word(crc, word);
+            }
+
+            template<std::size_t N>
+            static result_type finish(std::span<const state_type, N> lanes, std::size_t lane_bytes,
+                                      const std::uint8_t* tail, std::size_t tail_len, std::uint64_t,
+                                      std::uint64_t) noexcept {
+                state_type crc = lanes[0];
+                if constexpr (N > 1) {
+                    // Horner over equal-length segments: one power, N - 1 multiplies
+                    const std::uint32_t shift = detail::crc32c_x8n(lane_bytes);
+                    for (std::size_t j = 1; j < N; ++j)
+                        crc = detail::crc32c_multmodp(shift, crc) ^ lanes[j];
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= tail_len; i += 8)
+                    crc = detail::crc32c_word(crc, swar::load_le(tail + i));
+                for (; i < tail_len; ++i)
+                    crc = detail::crc32c_byte(crc, tail[i]);
+                return ~crc;
+            }
+        };
+
+    } // namespace hash
+
+    // Fastest N for Algo on this build's CPU profile and ISA. For an Algo whose value depends
+    // on N, hashes made with it differ between builds, so use it only for in-process tables.
+    template<typename Algo>
+    inline constexpr std::size_t striped_fast_N = optimal_N<Algo::loop_type, std::uint64_t>;
+
+    namespace detail {
+
+        // The default N must give the same value in every build: 4 (XXH64's own lane count)
+        // unless the Algo's value doesn't depend on N
+        template<typename Algo>
+        inline constexpr std::size_t striped_default_N = Algo::lane_invariant ? striped_fast_N<Algo> : 4;
+
+        // Segmented lanes pay a fixed cost to combine; below this many bytes per lane use one lane
+        inline constexpr std::size_t striped_min_segment = 512;
+
+    } // namespace detail
+
+    // For fnv1a and xxh64 the value depends on N, so N defaults to a fixed 4 and a hash is the
+    // same in every build. crc32c's value doesn't, so its N defaults to striped_fast_N.
+    template<typename Algo, std::size_t N = detail::striped_default_N<Algo>>
+    struct striped_hash {
+        using result_type = typename Algo::result_type;
+        static constexpr std::size_t lanes = N;
+
+        static result_type hash(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept {
+            detail::validate_unroll_factor<N>();
+            const auto* p = static_cast<const std::uint8_t*>(data);
+            using state_type = typename Algo::state_type;
+
+            if constexpr (Algo::segmented && N > 1) {
+                if (len < N * detail::striped_min_segment)
+                    return striped_hash<Algo, 1>::hash(data, len, seed);
+            }
+
+            std::array<state_type, N> lane;
+            for (std::size_t j = 0; j < N; ++j)
+                lane[j] = Algo::init(seed, j);
+
+            std::size_t done = 0;
+            if constexpr (Algo::segmented) {
+                // Lane j owns bytes [j * seg, (j + 1) * seg)
+                const std::size_t seg = len / (N * 8) * 8;
+                for (std::size_t t = 0; t < seg; t += 8)
+                    for (std::size_t j = 0; j < N; ++j)
+                        lane[j] = Algo::step(lane[j], swar::load_le(p + j * seg + t));
+                done = N * seg;
+            } else {
+                // Lane j owns word j of every N-word stripe
+                for (; done + N * 8 <= len; done += N * 8)
+                    for (std::size_t j = 0; j < N; ++j)
+                        lane[j] = Algo::step(lane[j], swar::load_le(p + done + j * 8));
+            }
+
+            return Algo::template finish<N>(std::span<const state_type, N>(lane), done / N, p + done, len - done,
+                                            len, seed);
+        }
+
+        static result_type hash(std::span<const std::byte> bytes, std::uint64_t seed = 0) noexcept {
+            return hash(bytes.data(), bytes.size(), seed);
+        }
+
+        // Hasher form, e.g. std::unordered_map<std::string, V, ilp::striped_hash<ilp::hash::xxh64, 4>>
+        result_type operator()(std::string_view s) const noexcept { return hash(s.data(), s.size()); }
+    };
+
+    // CRC32C of data, continuing from crc (0 to start)
+    template<std::size_t N = detail::striped_default_N<hash::crc32c>>
+    std::uint32_t crc32c(const void* data, std::size_t len, std::uint32_t crc = 0) noexcept {
+        return striped_hash<hash::crc32c, N>::hash(data, len, crc);
+    }
+
+    // CRC32C of a + b from crc32c(a), crc32c(b) and b's length, e.g. to join per-chunk checksums
+    constexpr std::uint32_t crc32c_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t len_b) noexcept {
+        return detail::crc32c_multmodp(detail::crc32c_x8n(len_b), crc_a) ^ crc_b;
+    }
+
+} // namespace ilp
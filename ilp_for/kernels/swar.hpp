@@ -0,0 +1,72 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../detail/ctrl.hpp"
+
+// Word-at-a-time byte primitives (SIMD within a register) shared by the byte kernels.
+// Everything is portable C++; the compiler keeps the eight words of a 64-byte block in
+// independent dependency chains, which is where the ILP comes from.
+
+namespace ilp::swar {
+
+    inline constexpr std::uint64_t ones = 0x0101010101010101ull;
+    inline constexpr std::uint64_t high_bits = 0x8080808080808080ull;
+    inline constexpr std::uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+
+    // Bytes per block handled by the block kernels: one bit per byte in a 64-bit mask
+    inline constexpr std::size_t block_bytes = 64;
+
+    constexpr std::uint64_t broadcast(std::uint8_t b) noexcept { return ones * b; }
+
+    // Little-endian 8-byte load, byte i of the input in bits [8i, 8i+8)
+    ILP_ALWAYS_INLINE std::uint64_t load_le(const void* p) noexcept {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        if constexpr (std::endian::native == std::endian::big) {
+            w = ((w & 0x00000000FFFFFFFFull) << 32) | ((w & 0xFFFFFFFF00000000ull) >> 32);
+            w = ((w & 0x0000FFFF0000FFFFull) << 16) | ((w & 0xFFFF0000FFFF0000ull) >> 16);
+            w = ((w & 0x00FF00FF00FF00FFull) << 8) | ((w & 0xFF00FF00FF00FF00ull) >> 8);
+        }
+        return w;
+    }
+
+    // High bit of each byte set iff that byte is zero. Exact: no false positives from borrows.
+    constexpr std::uint64_t zero_bytes(std::uint64_t x) noexcept {
+        return ~(((x & low7) + low7) | x | low7);
+    }
+
+    // High bit of each byte set iff that byte equals pattern (a broadcast byte)
+    constexpr std::uint64_t equal_bytes(std::uint64_t w, std::uint64_t pattern) noexcept {
+        return zero_bytes(w ^ pattern);
+    }
+
+    // Gather the high bit of each byte into an 8-bit mask, byte i -> bit i.
+    // The multiplier places each bit at a distinct position, so no carries disturb the top byte.
+    constexpr std::uint64_t high_bit_mask(std::uint64_t h) noexcept {
+        return ((h >> 7) * 0x0102040810204080ull) >> 56;
+    }
+
+    // Inclusive prefix XOR over bits: bit i = b0 ^ ... ^ bi
+    constexpr std::uint64_t prefix_xor(std::uint64_t m) noexcept {
+        m ^= m << 1;
+        m ^= m << 2;
+        m ^= m << 4;
+        m ^= m << 8;
+        m ^= m << 16;
+        m ^= m << 32;
+        return m;
+    }
+
+    // Mask with the low n bits set (n <= 64)
+    constexpr std::uint64_t low_mask(std::size_t n) noexcept { return n >= 64 ? ~0ull : (1ull << n) - 1; }
+
+} // namespace ilp::swar
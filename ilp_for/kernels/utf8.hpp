@@ -0,0 +1,232 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../detail/ctrl.hpp"
+#include "../detail/loops_common.hpp"
+#include "swar.hpp"
+
+namespace ilp {
+
+    namespace detail {
+
+        // Shift-based UTF-8 DFA (RFC 3629: no overlongs, no surrogates, nothing above U+10FFFF).
+        // A state is a bit offset into the row for the next byte, so a step is one shift and mask
+        // and the dependency chain per byte is a couple of cycles. accept is 0, reject absorbs.
+        inline constexpr unsigned utf8_accept = 0;
+        inline constexpr unsigned utf8_reject = 6;
+
+        constexpr std::array<std::uint64_t, 256> make_utf8_dfa() {
+            enum : unsigned { accept = 0, reject = 6, need1 = 12, need2 = 18, need3 = 24, e0 = 30, ed = 36, f0 = 42, f4 = 48 };
+            constexpr unsigned states[] = {accept, reject, need1, need2, need3, e0, ed, f0, f4};
+            std::array<std::uint64_t, 256> table{};
+            for (unsigned b = 0; b < 256; ++b) {
+                auto next = [b](unsigned s) -> unsigned {
+                    const bool lo = b >= 0x80 && b <= 0x8F;  // continuation ranges that
+                    const bool mid = b >= 0x90 && b <= 0x9F; // the E0/ED/F0/F4 leads
+                    const bool hi = b >= 0xA0 && b <= 0xBF;  // restrict
+                    const bool cont = lo || mid || hi;
+                    switch (s) {
+                    case accept:
+                        if (b < 0x80)
+                            return accept;
+                        if (b >= 0xC2 && b <= 0xDF)
+                            return need1;
+                        if (b == 0xE0)
+                            return e0;
+                        if (b == 0xED)
+                            return ed;
+                        if (b >= 0xE1 && b <= 0xEF)
+                            return need2;
+                        if (b == 0xF0)
+                            return f0;
+                        if (b == 0xF4)
+                            return f4;
+                        if (b >= 0xF1 && b <= 0xF3)
+                            return need3;
+                        return reject;
+                    case need1:
+                        return cont ? accept : reject;
+                    case need2:
+                        return cont ? need1 : reject;
+                    case need3:
+                        return cont ? need2 : reject;
+                    case e0:
+                        return hi ? need1 : reject;
+                    case ed:
+                        return lo || mid ? need1 : reject;
+                    case f0:
+                        return mid || hi ? need2 : reject;
+                    case f4:
+                        return lo ? need2 : reject;
+                    default:
+                        return reject;
+                    }
+                };
+                for (unsigned s : states)
+                    table[b] |= std::uint64_t{next(s)} << s;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint64_t, 256> utf8_dfa = make_utf8_dfa();
+
+        ILP_ALWAYS_INLINE unsigned utf8_step(unsigned state, std::uint8_t b) noexcept {
+            return static_cast<unsigned>(utf8_dfa[b] >> state) & 63;
+        }
+
+        constexpr bool utf8_is_continuation(std::uint8_t b) noexcept { return (b & 0xC0) == 0x80; }
+
+        // DFA over [i, e). Whole 64-byte blocks are skipped when they are ASCII and the state is
+        // between characters; per-block rather than per-word so mixed text doesn't mispredict.
+        inline unsigned utf8_run(const std::uint8_t* p, std::size_t i, std::size_t e, unsigned state) noexcept {
+            for (; i + swar::block_bytes <= e; i += swar::block_bytes) {
+                std::uint64_t high = 0;
+                for (std::size_t w = 0; w < swar::block_bytes; w += 8)
+                    high |= swar::load_le(p + i + w);
+                if ((high & swar::high_bits) == 0 && state == utf8_accept)
+                    continue;
+                for (std::size_t j = 0; j < swar::block_bytes; ++j)
+                    state = utf8_step(state, p[i + j]);
+                if (state == utf8_reject) [[unlikely]]
+                    return state;
+            }
+            for (; i < e; ++i)
+                state = utf8_step(state, p[i]);
+            return state;
+        }
+
+        // Start of the first ill-formed sequence in [b, e) (b on a character boundary), or e.
+        // A bad or missing continuation byte is charged to its lead byte.
+        inline std::size_t utf8_first_error(const std::uint8_t* p, std::size_t b, std::size_t e) noexcept {
+            unsigned state = utf8_accept;
+            std::size_t seq = b;
+            for (std::size_t i = b; i < e; ++i) {
+                if (state == utf8_accept)
+                    seq = i;
+                state = utf8_step(state, p[i]);
+                if (state == utf8_reject)
+                    return seq;
+            }
+            return state == utf8_accept ? e : seq;
+        }
+
+    } // namespace detail
+
+    // Offset of the first ill-formed UTF-8 sequence in text, or text.size() if it is all valid
+    // (so the return value is also the length of the valid prefix).
+    //
+    // The byte-at-a-time DFA is one long dependency chain. Large inputs are split into N segments
+    // at character boundaries and the N state machines step in lock-step, 64 bytes per block;
+    // blocks where every segment is ASCII between characters are skipped with word-wide checks.
+    // The first block with a rejecting segment ends the interleaved pass: earlier segments are
+    // finished in order and the offending segment is rescanned for the exact offset.
+    template<std::size_t N = 4>
+    std::size_t utf8_validate(std::string_view text) {
+        detail::validate_unroll_factor<N>();
+        const auto* p = reinterpret_cast<const std::uint8_t*>(text.data());
+        const std::size_t n = text.size();
+
+        // Below a few KB per segment the split and merge cost more than the chains save
+        if (N == 1 || n < N * 1024) {
+            return detail::utf8_run(p, 0, n, detail::utf8_accept) == detail::utf8_accept
+                       ? n
+                       : detail::utf8_first_error(p, 0, n);
+        }
+
+        // Move each split off continuation bytes. Three is enough: a fourth in a row is ill-formed
+        // and the segment before it reports that error first.
+        std::array<std::size_t, N + 1> bound{};
+        bound[N] = n;
+        for (std::size_t s = 1; s < N; ++s) {
+            std::size_t b = n / N * s;
+            for (int k = 0; k < 3 && detail::utf8_is_continuation(p[b]); ++k)
+                ++b;
+            bound[s] = b;
+        }
+
+        std::size_t common = n;
+        for (std::size_t s = 0; s < N; ++s)
+            common = std::min(common, bound[s + 1] - bound[s]);
+
+        std::array<unsigned, N> state{};
+        std::size_t k = 0;
+        for (; k + swar::block_bytes <= common; k += swar::block_bytes) {
+            std::uint64_t high = 0;
+            unsigned pending = 0;
+            for (std::size_t s = 0; s < N; ++s) {
+                for (std::size_t w = 0; w < swar::block_bytes; w += 8)
+                    high |= swar::load_le(p + bound[s] + k + w);
+                pending |= state[s];
+            }
+            if ((high & swar::high_bits) == 0 && pending == detail::utf8_accept)
+                continue;
+
+            for (std::size_t j = 0; j < swar::block_bytes; ++j)
+                for (std::size_t s = 0; s < N; ++s)
+                    state[s] = detail::utf8_step(state[s], p[bound[s] + k + j]);
+
+            bool rejected = false;
+            for (std::size_t s = 0; s < N; ++s)
+                rejected |= state[s] == detail::utf8_reject;
+            if (rejected) [[unlikely]] {
+                k += swar::block_bytes;
+                break;
+            }
+        }
+
+        for (std::size_t s = 0; s < N; ++s) {
+            if (state[s] != detail::utf8_reject)
+                state[s] = detail::utf8_run(p, bound[s] + k, bound[s + 1], state[s]);
+            if (state[s] != detail::utf8_accept)
+                return detail::utf8_first_error(p, bound[s], bound[s + 1]);
+        }
+        return n;
+    }
+
+    template<std::size_t N = 4>
+    bool utf8_valid(std::string_view text) {
+        return utf8_validate<N>(text) == text.size();
+    }
+
+    // Number of code points in valid UTF-8: every byte that is not a continuation byte (10xxxxxx).
+    // Counts 8 bytes per word with a popcount, N words in independent accumulators.
+    // On ill-formed input this is the number of non-continuation bytes.
+    template<std::size_t N = 4>
+    std::size_t utf8_count(std::string_view text) {
+        detail::validate_unroll_factor<N>();
+        const auto* p = reinterpret_cast<const std::uint8_t*>(text.data());
+        const std::size_t n = text.size();
+
+        // Continuation: bit 7 set and bit 6 clear. Shifting left by one lines bit 6 up with bit 7.
+        auto continuations = [](std::uint64_t w) {
+            return static_cast<std::size_t>(std::popcount(w & ~(w << 1) & swar::high_bits));
+        };
+
+        std::array<std::size_t, N> cont{};
+        std::size_t i = 0;
+        for (; i + N * 8 <= n; i += N * 8)
+            for (std::size_t j = 0; j < N; ++j)
+                cont[j] += continuations(swar::load_le(p + i + j * 8));
+        for (; i + 8 <= n; i += 8)
+            cont[0] += continuations(swar::load_le(p + i));
+
+        std::size_t total = 0;
+        for (std::size_t j = 0; j < N; ++j)
+            total += cont[j];
+        for (; i < n; ++i)
+            total += detail::utf8_is_continuation(p[i]);
+        return n - total;
+    }
+
+} // namespace ilp
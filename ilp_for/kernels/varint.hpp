@@ -0,0 +1,173 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "../detail/ctrl.hpp"
+#include "../detail/loops_common.hpp"
+#include "swar.hpp"
+
+namespace ilp {
+
+    namespace varint {
+
+        // Longest LEB128 encoding of a 64-bit value
+        inline constexpr std::size_t max_bytes = 10;
+
+        // Decode one varint of known length (1..10) from a pointer with at least 8 readable bytes.
+        // The first 8 bytes are compacted in-register: 7-bit groups pair up into 14, 28, then 56 bits.
+        ILP_ALWAYS_INLINE std::uint64_t decode_known(const std::uint8_t* p, std::size_t len) noexcept {
+            std::uint64_t x = swar::load_le(p) & swar::low7;
+            if (len < 8)
+                x &= swar::low_mask(len * 8);
+            x = (x & 0x007F007F007F007Full) | ((x & 0x7F007F007F007F00ull) >> 1);
+            x = (x & 0x00003FFF00003FFFull) | ((x & 0x3FFF00003FFF0000ull) >> 2);
+            x = (x & 0x000000000FFFFFFFull) | ((x & 0x0FFFFFFF00000000ull) >> 4);
+            if (len > 8) [[unlikely]] {
+                x |= std::uint64_t{p[8] & 0x7Fu} << 56;
+                if (len > 9)
+                    x |= std::uint64_t{p[9]} << 63;
+            }
+            return x;
+        }
+
+        // Byte-at-a-time decoder: the reference, and the baseline in the benchmarks.
+        // Returns the encoded length, or 0 if the input ends mid-varint or the varint is overlong.
+        inline std::size_t decode_scalar(const std::uint8_t* p, std::size_t n, std::uint64_t& out) noexcept {
+            std::uint64_t v = 0;
+            for (std::size_t i = 0; i < n && i < max_bytes; ++i) {
+                v |= std::uint64_t{p[i] & 0x7Fu} << (7 * i);
+                if (!(p[i] & 0x80u)) {
+                    out = v;
+                    return i + 1;
+                }
+            }
+            return 0;
+        }
+
+        // Bytes needed to encode v
+        constexpr std::size_t encoded_size(std::uint64_t v) noexcept {
+            return v == 0 ? 1 : (static_cast<std::size_t>(std::bit_width(v)) + 6) / 7;
+        }
+
+        // Encode v at p (max_bytes of room), returning the length
+        inline std::size_t encode(std::uint64_t v, std::uint8_t* p) noexcept {
+            std::size_t i = 0;
+            for (; v >= 0x80; v >>= 7)
+                p[i++] = static_cast<std::uint8_t>(v | 0x80);
+            p[i++] = static_cast<std::uint8_t>(v);
+            return i;
+        }
+
+    } // namespace varint
+
+    namespace detail {
+
+        template<typename F>
+        concept VarintBody = std::invocable<F, std::uint64_t>;
+
+        template<typename F>
+        concept VarintCtrlBody = std::invocable<F, std::uint64_t, LoopCtrl<void>&>;
+
+        // One block starting at the first byte of a varint: p has avail real bytes and at least
+        // block_bytes + 8 readable ones. Returns bytes consumed (whole varints only).
+        template<std::size_t N, typename F>
+        ILP_ALWAYS_INLINE std::size_t varint_block(const std::uint8_t* p, std::size_t avail, F& body,
+                                                   LoopCtrl<void>& ctrl) {
+            // A clear high bit ends a varint: one terminator bit per byte
+            std::uint64_t ends = 0;
+            for (std::size_t w = 0; w < swar::block_bytes / 8; ++w)
+                ends |= swar::high_bit_mask(~swar::load_le(p + w * 8) & swar::high_bits) << (w * 8);
+            ends &= swar::low_mask(avail);
+
+            std::size_t start = 0;
+            while (ends) {
+                // Up to N boundaries are known before any decode starts, so the lanes are independent
+                std::array<std::size_t, N> stop{};
+                std::size_t k = 0;
+                for (; k < N && ends; ++k) {
+                    stop[k] = static_cast<std::size_t>(std::countr_zero(ends)) + 1;
+                    ends &= ends - 1;
+                }
+
+                std::array<std::uint64_t, N> value{};
+                std::size_t from = start;
+                bool overlong = false;
+                for (std::size_t j = 0; j < k; ++j) {
+                    if (stop[j] - from > varint::max_bytes) [[unlikely]] {
+                        k = j; // deliver the lanes before it, then stop in front of it
+                        overlong = true;
+                        break;
+                    }
+                    value[j] = varint::decode_known(p + from, stop[j] - from);
+                    from = stop[j];
+                }
+
+                for (std::size_t j = 0; j < k; ++j) {
+                    if constexpr (VarintCtrlBody<F>) {
+                        body(value[j], ctrl);
+                        if (!ctrl.ok) [[unlikely]]
+                            return stop[j];
+                    } else {
+                        body(value[j]);
+                    }
+                }
+                if (overlong) [[unlikely]]
+                    return from;
+                start = stop[k - 1];
+            }
+            return start;
+        }
+
+    } // namespace detail
+
+    // Decode a stream of LEB128 varints (protobuf wire format), calling body(value) for each,
+    // or body(value, LoopCtrl<void>&) to stop early. Works on 64-byte blocks: the continuation
+    // bits of the whole block give every boundary at once, then N varints at a time are decoded
+    // as independent lanes instead of a byte-by-byte chain where each length gates the next load.
+    //
+    // Returns the bytes consumed. Decoding stops in front of a varint that is cut off by the end
+    // of the input (carry those bytes into the next chunk), longer than 10 bytes, or after the
+    // value at which the body broke.
+    template<std::size_t N = 4, typename F>
+        requires detail::VarintBody<F> || detail::VarintCtrlBody<F>
+    std::size_t for_each_varint(std::span<const std::uint8_t> bytes, F&& body) {
+        detail::validate_unroll_factor<N>();
+        constexpr std::size_t block = swar::block_bytes;
+        const std::uint8_t* p = bytes.data();
+        const std::size_t n = bytes.size();
+        LoopCtrl<void> ctrl;
+        std::size_t pos = 0;
+
+        // Main loop: the block and an 8-byte overread stay inside the input
+        while (pos + block + 8 <= n) {
+            const std::size_t used = detail::varint_block<N>(p + pos, block, body, ctrl);
+            pos += used;
+            if (!ctrl.ok || used == 0) [[unlikely]]
+                return pos;
+        }
+
+        // Tail from a zero-padded copy; padding bytes are masked off as terminators
+        alignas(8) std::uint8_t tail[block + 8];
+        while (pos < n) {
+            const std::size_t avail = n - pos < block ? n - pos : block;
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, p + pos, avail);
+            const std::size_t used = detail::varint_block<N>(tail, avail, body, ctrl);
+            pos += used;
+            if (!ctrl.ok || used == 0)
+                break;
+        }
+        return pos;
+    }
+
+} // namespace ilp
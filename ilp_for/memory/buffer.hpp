@@ -0,0 +1,252 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../detail/arch.hpp"
+
+// Huge pages through transparent huge pages: an anonymous mapping advised with MADV_HUGEPAGE.
+// Where the kernel has THP off, or on other platforms, the same calls give regular pages.
+#if defined(__linux__)
+#define ILP_HAS_HUGEPAGES 1
+#include <sys/mman.h>
+#else
+#define ILP_HAS_HUGEPAGES 0
+#endif
+
+namespace ilp {
+
+    // Page size for a buffer or aligned_allocator. Huge applies to allocations of at least one
+    // 2 MiB page; smaller ones use regular pages either way.
+    enum class Pages { Default, Huge };
+
+    namespace detail {
+
+        inline constexpr std::size_t huge_page_bytes = std::size_t{2} << 20;
+
+        inline bool use_huge_pages([[maybe_unused]] std::size_t bytes, [[maybe_unused]] Pages pages) noexcept {
+#if ILP_HAS_HUGEPAGES
+            return pages == Pages::Huge && bytes >= huge_page_bytes;
+#else
+            return false;
+#endif
+        }
+
+        // Huge: a mapping trimmed to start on a 2 MiB boundary, so every page of it can be a huge
+        // page. Otherwise aligned operator new. Throws std::bad_alloc either way.
+        inline void* allocate_aligned(std::size_t bytes, std::size_t align, Pages pages) {
+#if ILP_HAS_HUGEPAGES
+            if (use_huge_pages(bytes, pages)) {
+                const std::size_t len = (bytes + huge_page_bytes - 1) / huge_page_bytes * huge_page_bytes;
+                void* raw = ::mmap(nullptr, len + huge_page_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                   -1, 0);
+                if (raw == MAP_FAILED)
+                    throw std::bad_alloc();
+                auto* first = static_cast<std::byte*>(raw);
+                auto* base = reinterpret_cast<std::byte*>(
+                    (reinterpret_cast<std::uintptr_t>(first) + huge_page_bytes - 1) & ~(huge_page_bytes - 1));
+                if (base != first)
+                    ::munmap(first, static_cast<std::size_t>(base - first));
+                if (const std::size_t after = huge_page_bytes - static_cast<std::size_t>(base - first); after != 0)
+                    ::munmap(base + len, after);
+                ::madvise(base, len, MADV_HUGEPAGE); // fails harmlessly where THP is unavailable
+                return base;
+            }
+#endif
+            return ::operator new(bytes, std::align_val_t{align});
+        }
+
+        inline void deallocate_aligned(void* p, std::size_t bytes, std::size_t align, Pages pages) noexcept {
+#if ILP_HAS_HUGEPAGES
+            if (use_huge_pages(bytes, pages)) {
+                ::munmap(p, (bytes + huge_page_bytes - 1) / huge_page_bytes * huge_page_bytes);
+                return;
+            }
+#endif
+            ::operator delete(p, bytes, std::align_val_t{align});
+        }
+
+        template<typename T>
+        inline constexpr std::size_t line_align_v = std::max(arch::cache_line, alignof(T));
+
+        // A whole cache line of T, and never fewer than 16 (the largest sensible N), so every
+        // power-of-two N up to 16 divides it
+        template<typename T>
+        inline constexpr std::size_t buffer_block_v = std::max<std::size_t>(16, arch::cache_line / sizeof(T));
+
+    } // namespace detail
+
+    // Allocator for std::vector and friends: cache-line aligned storage, and with Pages::Huge
+    // huge-page-backed storage for allocations of 2 MiB and more
+    template<typename T, Pages P = Pages::Default>
+    struct aligned_allocator {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = aligned_allocator<U, P>;
+        };
+
+        aligned_allocator() noexcept = default;
+        template<typename U>
+        aligned_allocator(const aligned_allocator<U, P>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(detail::allocate_aligned(n * sizeof(T), detail::line_align_v<T>, P));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            detail::deallocate_aligned(p, n * sizeof(T), detail::line_align_v<T>, P);
+        }
+
+        template<typename U>
+        friend bool operator==(const aligned_allocator&, const aligned_allocator<U, P>&) noexcept {
+            return true;
+        }
+    };
+
+    // Contiguous view whose size is always a multiple of Block. The range drivers see
+    // padded_block and, for an N that divides it, run whole blocks with no remainder loop.
+    template<typename T, std::size_t Block>
+    class padded_span : public std::span<T> {
+      public:
+        static constexpr std::size_t padded_block = Block;
+
+        padded_span(T* data, std::size_t size) noexcept : std::span<T>(data, size) {
+            assert(size % Block == 0 && "padded_span size must be a multiple of the block");
+        }
+    };
+
+    // Fixed-size array for ILP loops. The data starts on a cache line, and the storage is
+    // rounded up to a multiple of Block elements, so padded() can hand the range drivers whole
+    // blocks. The padding elements are value-initialized; pad() sets them to a value the loop
+    // body ignores (0 for a sum, a non-matching key for a search). With Pages::Huge a buffer of
+    // 2 MiB or more is backed by huge pages where the kernel allows it, cutting TLB misses on
+    // large scans.
+    template<typename T, std::size_t Block = detail::buffer_block_v<T>>
+    class buffer {
+        static_assert(Block >= 1, "buffer block must be at least one element");
+        static_assert(std::is_nothrow_destructible_v<T>, "buffer<T> requires a nothrow destructible T");
+
+      public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr std::size_t block = Block;
+
+        buffer() noexcept = default;
+
+        explicit buffer(std::size_t size, Pages pages = Pages::Default) : buffer(size, pages, 0) {
+            construct([&] { std::uninitialized_value_construct_n(data_, capacity_); });
+        }
+
+        buffer(std::size_t size, const T& value, Pages pages = Pages::Default) : buffer(size, pages, 0) {
+            construct([&] {
+                std::uninitialized_fill_n(data_, size_, value);
+                try {
+                    std::uninitialized_value_construct_n(data_ + size_, capacity_ - size_);
+                } catch (...) {
+                    std::destroy_n(data_, size_);
+                    throw;
+                }
+            });
+        }
+
+        buffer(buffer&& o) noexcept
+            : data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0)),
+              capacity_(std::exchange(o.capacity_, 0)), pages_(o.pages_) {}
+
+        buffer& operator=(buffer&& o) noexcept {
+            if (this != &o) {
+                release();
+                data_ = std::exchange(o.data_, nullptr);
+                size_ = std::exchange(o.size_, 0);
+                capacity_ = std::exchange(o.capacity_, 0);
+                pages_ = o.pages_;
+            }
+            return *this;
+        }
+
+        buffer(const buffer&) = delete;
+        buffer& operator=(const buffer&) = delete;
+
+        ~buffer() { release(); }
+
+        T* data() noexcept { return data_; }
+        const T* data() const noexcept { return data_; }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        // Elements allocated: size() rounded up to a multiple of Block
+        std::size_t capacity() const noexcept { return capacity_; }
+
+        T& operator[](std::size_t i) noexcept { return data_[i]; }
+        const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        iterator begin() noexcept { return data_; }
+        iterator end() noexcept { return data_ + size_; }
+        const_iterator begin() const noexcept { return data_; }
+        const_iterator end() const noexcept { return data_ + size_; }
+
+        // The elements and the padding after them, for loops the padding doesn't change
+        padded_span<T, Block> padded() noexcept { return {data_, capacity_}; }
+        padded_span<const T, Block> padded() const noexcept { return {data_, capacity_}; }
+
+        void pad(const T& value) { std::fill(data_ + size_, data_ + capacity_, value); }
+
+      private:
+        buffer(std::size_t size, Pages pages, int)
+            : size_(size), capacity_((size + Block - 1) / Block * Block), pages_(pages) {}
+
+        template<typename Init>
+        void construct(Init&& init) {
+            if (capacity_ == 0)
+                return;
+            data_ = static_cast<T*>(detail::allocate_aligned(bytes(), detail::line_align_v<T>, pages_));
+            try {
+                init();
+            } catch (...) {
+                // The delegated-to constructor has finished, so ~buffer runs after this
+                detail::deallocate_aligned(data_, bytes(), detail::line_align_v<T>, pages_);
+                data_ = nullptr;
+                throw;
+            }
+        }
+
+        std::size_t bytes() const noexcept { return capacity_ * sizeof(T); }
+
+        void release() noexcept {
+            if (!data_)
+                return;
+            std::destroy_n(data_, capacity_);
+            detail::deallocate_aligned(data_, bytes(), detail::line_align_v<T>, pages_);
+            data_ = nullptr;
+        }
+
+        T* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+        Pages pages_ = Pages::Default;
+    };
+
+} // namespace ilp
+
+namespace std::ranges {
+    template<typename T, std::size_t Block>
+    inline constexpr bool enable_borrowed_range<ilp::padded_span<T, Block>> = true;
+} // namespace std::ranges
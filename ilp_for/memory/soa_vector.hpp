@@ -0,0 +1,274 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../detail/ctrl.hpp"
+#include "../detail/loops_common.hpp"
+#include "buffer.hpp"
+
+namespace ilp {
+
+    namespace detail {
+
+        // String literal as a template argument: column names, and the declaration list of
+        // ILP_FOR_SOA
+        template<std::size_t N>
+        struct fixed_string {
+            char chars[N]{};
+
+            constexpr fixed_string(const char (&s)[N]) {
+                for (std::size_t i = 0; i < N; ++i)
+                    chars[i] = s[i];
+            }
+
+            constexpr std::string_view view() const { return {chars, N - 1}; }
+        };
+
+        constexpr bool is_identifier_char(char c) {
+            return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        }
+
+        // Declarations in a stringized "(auto price, const auto& qty)"
+        constexpr std::size_t soa_decl_count(std::string_view decls) {
+            std::size_t count = 1;
+            for (char c : decls)
+                count += c == ',';
+            return count;
+        }
+
+        // The name the k-th declaration declares: the last identifier before its comma. Scanned
+        // by index: under GCC's -fsanitize=undefined, string_view::find's null test on the
+        // characters of a template argument is not a constant expression.
+        constexpr std::string_view soa_decl_name(std::string_view decls, std::size_t k) {
+            std::size_t close = decls.size();
+            while (close > 0 && decls[close - 1] != ')')
+                --close;
+            std::size_t start = 0;
+            while (decls[start] != '(')
+                ++start;
+            ++start;
+            for (std::size_t i = 0; i < k; ++i) {
+                while (decls[start] != ',')
+                    ++start;
+                ++start;
+            }
+            std::size_t end = start;
+            while (end + 1 < close && decls[end] != ',')
+                ++end;
+            while (end > start && !is_identifier_char(decls[end - 1]))
+                --end;
+            std::size_t begin = end;
+            while (begin > start && is_identifier_char(decls[begin - 1]))
+                --begin;
+            return decls.substr(begin, end - begin);
+        }
+
+        // Column index of each name in Decls, in declaration order
+        template<typename Soa, fixed_string Decls>
+        inline constexpr auto soa_selection = [] {
+            constexpr std::string_view decls = Decls.view();
+            std::array<std::size_t, soa_decl_count(decls)> columns{};
+            for (std::size_t k = 0; k < columns.size(); ++k)
+                columns[k] = Soa::column_index(soa_decl_name(decls, k));
+            return columns;
+        }();
+
+        template<typename Soa, fixed_string Decls>
+        constexpr bool soa_selection_valid() {
+            for (std::size_t column : soa_selection<Soa, Decls>)
+                if (column >= Soa::columns)
+                    return false;
+            return true;
+        }
+
+        template<std::size_t N, typename F, typename... Cols>
+        ForResult for_loop_soa_impl(std::size_t size, F&& body, Cols... cols) {
+            validate_unroll_factor<N>();
+            ForCtrl ctrl;
+            std::size_t i = 0;
+
+            for (const std::size_t unrolled = size - size % N; i < unrolled; i += N) {
+                for (std::size_t j = 0; j < N; ++j) {
+                    body(cols[i + j]..., ctrl);
+                    if (!ctrl.ok) [[unlikely]]
+                        return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+                }
+            }
+
+            for (; i < size; ++i) {
+                body(cols[i]..., ctrl);
+                if (!ctrl.ok) [[unlikely]]
+                    return ForResult{ctrl.return_set, std::move(ctrl.storage)};
+            }
+
+            return ForResult{false, {}};
+        }
+
+    } // namespace detail
+
+    // A named column of a soa_vector: ilp::field<"price", double>
+    template<detail::fixed_string Name, typename T>
+    struct field {
+        using type = T;
+        static constexpr std::string_view name = Name.view();
+    };
+
+    // Records stored as one contiguous, cache-line aligned array per field. A loop that reads
+    // two fields of a wide record streams just those two arrays instead of every whole record,
+    // and each column is a plain array the unrolled body indexes directly.
+    template<typename... Fields>
+    class soa_vector {
+        static_assert(sizeof...(Fields) >= 1, "soa_vector needs at least one field");
+        static_assert((!std::is_same_v<typename Fields::type, bool> && ...),
+                      "soa_vector can't hold a bool field: std::vector<bool> has no data(); use std::uint8_t");
+
+        template<typename T>
+        using column_t = std::vector<T, aligned_allocator<T>>;
+
+      public:
+        static constexpr std::size_t columns = sizeof...(Fields);
+
+        // Index of the field called name, or columns if there is none
+        static constexpr std::size_t column_index(std::string_view name) {
+            constexpr std::array<std::string_view, columns> names{Fields::name...};
+            for (std::size_t i = 0; i < columns; ++i)
+                if (names[i] == name)
+                    return i;
+            return columns;
+        }
+
+        soa_vector() = default;
+        explicit soa_vector(std::size_t size) { resize(size); }
+
+        std::size_t size() const noexcept { return std::get<0>(columns_).size(); }
+        bool empty() const noexcept { return size() == 0; }
+
+        void reserve(std::size_t n) {
+            std::apply([n](auto&... col) { (col.reserve(n), ...); }, columns_);
+        }
+        void resize(std::size_t n) {
+            std::apply([n](auto&... col) { (col.resize(n), ...); }, columns_);
+        }
+        void clear() noexcept {
+            std::apply([](auto&... col) { (col.clear(), ...); }, columns_);
+        }
+
+        void push_back(const typename Fields::type&... values) {
+            push_back_impl(std::index_sequence_for<Fields...>{}, values...);
+        }
+
+        template<std::size_t I>
+        auto& column() noexcept {
+            return std::get<I>(columns_);
+        }
+        template<std::size_t I>
+        const auto& column() const noexcept {
+            return std::get<I>(columns_);
+        }
+
+        template<detail::fixed_string Name>
+        auto& column() noexcept {
+            static_assert(column_index(Name.view()) < columns, "soa_vector has no field with this name");
+            return std::get<column_index(Name.view())>(columns_);
+        }
+        template<detail::fixed_string Name>
+        const auto& column() const noexcept {
+            static_assert(column_index(Name.view()) < columns, "soa_vector has no field with this name");
+            return std::get<column_index(Name.view())>(columns_);
+        }
+
+        // References to every field of record i
+        auto row(std::size_t i) noexcept {
+            return std::apply([i](auto&... col) { return std::tie(col[i]...); }, columns_);
+        }
+        auto row(std::size_t i) const noexcept {
+            return std::apply([i](const auto&... col) { return std::tie(col[i]...); }, columns_);
+        }
+
+      private:
+        template<std::size_t... I>
+        void push_back_impl(std::index_sequence<I...>, const typename Fields::type&... values) {
+            (std::get<I>(columns_).push_back(values), ...);
+        }
+
+        std::tuple<column_t<typename Fields::type>...> columns_;
+    };
+
+    // Loop over the columns of soa whose names Decls declares, in declaration order: for
+    // "(auto price, auto& qty)" the body gets price[i] and qty[i]. ILP_FOR_SOA passes Decls.
+    template<std::size_t N, detail::fixed_string Decls, typename Soa, typename F>
+    ForResult for_loop_soa(Soa&& soa, F&& body) {
+        using S = std::remove_cvref_t<Soa>;
+        static_assert(detail::soa_selection_valid<S, Decls>(), "ILP_FOR_SOA names a field the soa_vector doesn't have");
+        constexpr auto cols = detail::soa_selection<S, Decls>;
+        return [&]<std::size_t... K>(std::index_sequence<K...>) {
+            return detail::for_loop_soa_impl<N>(soa.size(), std::forward<F>(body),
+                                                soa.template column<cols[K]>().data()...);
+        }(std::make_index_sequence<cols.size()>{});
+    }
+
+    // AoS to SoA: one projection per field, in field order (typically &Record::member)
+    template<typename Soa, std::ranges::input_range Records, typename... Proj>
+    Soa to_soa(Records&& records, Proj... proj) {
+        static_assert(sizeof...(Proj) == Soa::columns, "to_soa needs one projection per field");
+        Soa soa;
+        if constexpr (std::ranges::sized_range<Records>)
+            soa.reserve(static_cast<std::size_t>(std::ranges::size(records)));
+        for (auto&& r : records)
+            soa.push_back(std::invoke(proj, r)...);
+        return soa;
+    }
+
+    // SoA to AoS: a default-initialized Record per row with each field assigned through its
+    // member pointer, in field order
+    template<typename Record, typename Soa, typename... Members>
+        requires std::default_initializable<Record>
+    std::vector<Record> to_aos(const Soa& soa, Members... members) {
+        static_assert(sizeof...(Members) == std::remove_cvref_t<Soa>::columns, "to_aos needs one member per field");
+        std::vector<Record> records(soa.size());
+        for (std::size_t i = 0; i < soa.size(); ++i) {
+            std::apply([&](const auto&... value) { ((records[i].*members = value), ...); }, soa.row(i));
+        }
+        return records;
+    }
+
+    namespace detail {
+
+        // Plain-loop form of ILP_FOR_SOA for ILP_MODE_SIMPLE: get<k>() is the k-th declared column
+        template<typename Soa, fixed_string Decls>
+        struct soa_cursor {
+            Soa& soa;
+            std::size_t i = 0;
+
+            bool more() const { return i < soa.size(); }
+            void next() { ++i; }
+
+            template<std::size_t K>
+            decltype(auto) get() const {
+                return soa.template column<soa_selection<std::remove_const_t<Soa>, Decls>[K]>()[i];
+            }
+        };
+
+        template<fixed_string Decls, typename Soa>
+        auto make_soa_cursor(Soa& soa) {
+            static_assert(soa_selection_valid<std::remove_const_t<Soa>, Decls>(),
+                          "ILP_FOR_SOA names a field the soa_vector doesn't have");
+            return soa_cursor<Soa, Decls>{soa};
+        }
+
+    } // namespace detail
+
+} // namespace ilp
@@ -0,0 +1,486 @@
+#!/usr/bin/env python3
+"""
+Generate ilp::cpu::Profile blocks from instruction latency/throughput data.
+
+Each Profile field is mapped to the instruction that bounds it (VADDPS for sum_4f, VPMULLD
+for multiply_4i, ...). N is then ceil(L x TPC), clamped to [MIN_N, MAX_N]. The generated block
+carries the same comment table as the hand-written profiles.
+
+Timing data is either a CSV (instruction,latency,rthroughput) or the instructions.xml from
+https://uops.info/xml.html. The profiles shipped in ilp_cpu_profiles.hpp are described in
+scripts/profiles/profiles.json with one CSV each.
+
+    generate_profile.py                    # print every shipped profile
+    generate_profile.py zen5               # print one
+    generate_profile.py --check            # fail if ilp_cpu_profiles.hpp is out of date
+    generate_profile.py --write            # regenerate ilp_cpu_profiles.hpp in place
+    generate_profile.py --name gnr --title "Intel Granite Rapids" --isa x86 \\
+        --uops-xml instructions.xml --arch GNR   # a new profile from uops.info data
+
+Only the standard library is needed.
+"""
+
+import argparse
+import csv
+import difflib
+import json
+import math
+import sys
+import xml.etree.ElementTree as ET
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+HEADER = ROOT / 'ilp_for' / 'cpu_profiles' / 'ilp_cpu_profiles.hpp'
+PROFILES = Path(__file__).resolve().parent / 'profiles'
+
+# Fewer than two chains is no ILP at all; above 16 the library warns (validate_unroll_factor)
+MIN_N = 2
+MAX_N = 16
+
+# rthroughput is usually published to two places (0.33 for 1/3), so L/RThr is taken with a
+# little slack: 1 / 0.33 is 3 chains, not 4
+ROUNDING_SLACK = 0.1
+
+# Fields in Profile declaration order: (field, group, use case, {isa: candidate instructions}).
+# The first candidate present in the data wins. Fields without candidates are memory-bound
+# and take MEMORY_BOUND unless the profile overrides them.
+FIELDS = [
+    ('sum_1', 'Sum', 'Int Add', {'x86': ['VPADDB'], 'arm': ['ADD']}),
+    ('sum_2', 'Sum', 'Int Add', {'x86': ['VPADDW'], 'arm': ['ADD']}),
+    ('sum_4i', 'Sum', 'Int Add', {'x86': ['VPADDD'], 'arm': ['ADD']}),
+    ('sum_8i', 'Sum', 'Int Add', {'x86': ['VPADDQ'], 'arm': ['ADD']}),
+    ('sum_4f', 'Sum', 'FP Add', {'x86': ['VADDPS'], 'arm': ['FADD']}),
+    ('sum_8f', 'Sum', 'FP Add', {'x86': ['VADDPD'], 'arm': ['FADD']}),
+    ('dotproduct_4', 'DotProduct', 'FMA', {'x86': ['VFMADD231PS'], 'arm': ['FMLA']}),
+    ('dotproduct_8', 'DotProduct', 'FMA', {'x86': ['VFMADD231PD'], 'arm': ['FMLA']}),
+    ('search_1', 'Search', 'Cmp+Branch', {'x86': ['CMP'], 'arm': ['FCMP', 'CMP']}),
+    ('search_2', 'Search', 'Cmp+Branch', {'x86': ['CMP'], 'arm': ['FCMP', 'CMP']}),
+    ('search_4', 'Search', 'Cmp+Branch', {'x86': ['CMP'], 'arm': ['FCMP', 'CMP']}),
+    ('search_8', 'Search', 'Cmp+Branch', {'x86': ['CMP'], 'arm': ['FCMP', 'CMP']}),
+    ('copy_1', 'Copy', None, {}),
+    ('copy_2', 'Copy', None, {}),
+    ('copy_4', 'Copy', None, {}),
+    ('copy_8', 'Copy', None, {}),
+    ('transform_1', 'Transform', None, {}),
+    ('transform_2', 'Transform', None, {}),
+    ('transform_4', 'Transform', None, {}),
+    ('transform_8', 'Transform', None, {}),
+    ('multiply_4f', 'Multiply', 'FP Mul', {'x86': ['VMULPS'], 'arm': ['FMUL']}),
+    ('multiply_8f', 'Multiply', 'FP Mul', {'x86': ['VMULPD'], 'arm': ['FMUL']}),
+    ('multiply_4i', 'Multiply', 'Int Mul', {'x86': ['VPMULLD'], 'arm': ['MUL']}),
+    ('multiply_8i', 'Multiply', 'Int Mul', {'x86': ['VPMULLQ', 'IMUL'], 'arm': ['MUL']}),
+    ('divide_4f', 'Divide', 'FP Div', {'x86': ['VDIVPS'], 'arm': ['FDIV']}),
+    ('divide_8f', 'Divide', 'FP Div', {'x86': ['VDIVPD'], 'arm': ['FDIV']}),
+    ('sqrt_4f', 'Sqrt', 'FP Sqrt', {'x86': ['VSQRTPS'], 'arm': ['FSQRT']}),
+    ('sqrt_8f', 'Sqrt', 'FP Sqrt', {'x86': ['VSQRTPD'], 'arm': ['FSQRT']}),
+    ('minmax_1', 'MinMax', 'Int MinMax', {'x86': ['VPMAXSB'], 'arm': ['SMAX']}),
+    ('minmax_2', 'MinMax', 'Int MinMax', {'x86': ['VPMAXSW'], 'arm': ['SMAX']}),
+    ('minmax_4i', 'MinMax', 'Int MinMax', {'x86': ['VPMAXSD'], 'arm': ['SMAX']}),
+    ('minmax_8i', 'MinMax', 'Int MinMax', {'x86': ['VPMAXSQ', 'VPCMPGTQ'], 'arm': ['CMGT']}),
+    ('minmax_4f', 'MinMax', 'FP MinMax', {'x86': ['VMAXPS'], 'arm': ['FMAX']}),
+    ('minmax_8f', 'MinMax', 'FP MinMax', {'x86': ['VMAXPD'], 'arm': ['FMAX']}),
+    ('bitwise_1', 'Bitwise', 'Bitwise', {'x86': ['VPAND', 'VPANDD'], 'arm': ['AND']}),
+    ('bitwise_2', 'Bitwise', 'Bitwise', {'x86': ['VPAND', 'VPANDD'], 'arm': ['AND']}),
+    ('bitwise_4', 'Bitwise', 'Bitwise', {'x86': ['VPAND', 'VPANDD'], 'arm': ['AND']}),
+    ('bitwise_8', 'Bitwise', 'Bitwise', {'x86': ['VPAND', 'VPANDD'], 'arm': ['AND']}),
+    ('shift_1', 'Shift', 'Shift', {'x86': ['VPSLLW'], 'arm': ['SHL']}),
+    ('shift_2', 'Shift', 'Shift', {'x86': ['VPSLLW'], 'arm': ['SHL']}),
+    ('shift_4', 'Shift', 'Shift', {'x86': ['VPSLLD'], 'arm': ['SHL']}),
+    ('shift_8', 'Shift', 'Shift', {'x86': ['VPSLLQ'], 'arm': ['SHL']}),
+    ('gather_4', 'Gather', 'Gather', {'x86': ['VPGATHERDD'], 'arm': ['LD1W', 'LDR']}),
+    ('gather_8', 'Gather', 'Gather', {'x86': ['VPGATHERQQ'], 'arm': ['LD1D', 'LDR']}),
+    ('popcount_4', 'Popcount', 'Popcount', {'x86': ['VPOPCNTD', 'POPCNT'], 'arm': ['CNT']}),
+    ('popcount_8', 'Popcount', 'Popcount', {'x86': ['VPOPCNTQ', 'POPCNT'], 'arm': ['CNT']}),
+    ('cmpxchg_4', 'CompareExchange', 'Min+Max', {'x86': ['VPMAXSD'], 'arm': ['SMAX']}),
+    ('cmpxchg_8', 'CompareExchange', 'Min+Max', {'x86': ['VPMAXSQ', 'VPCMPGTQ'], 'arm': ['CMGT']}),
+    ('convert_4', 'Convert', 'Int→FP', {'x86': ['VCVTDQ2PS'], 'arm': ['SCVTF']}),
+    ('convert_8', 'Convert', 'Int→FP', {'x86': ['VCVTDQ2PD'], 'arm': ['SCVTF']}),
+    ('hash_4', 'Hash', 'Mul+Xor', {'x86': ['IMUL'], 'arm': ['MADD']}),
+    ('hash_8', 'Hash', 'Mul+Xor', {'x86': ['IMUL'], 'arm': ['MADD']}),
+    ('scan_4i', 'Scan', 'Add+Store', {'x86': ['VPADDD'], 'arm': ['ADD']}),
+    ('scan_8i', 'Scan', 'Add+Store', {'x86': ['VPADDQ'], 'arm': ['ADD']}),
+    ('scan_4f', 'Scan', 'Add+Store', {'x86': ['VADDPS'], 'arm': ['FADD']}),
+    ('scan_8f', 'Scan', 'Add+Store', {'x86': ['VADDPD'], 'arm': ['FADD']}),
+]
+
+# Fields whose chain is more than the one instruction that bounds it:
+#   ops   - issues of that instruction per element (a compare-exchange is a min and a max)
+#   extra - latency of the single-cycle ops also on the chain (hash: xor and shift)
+#   limit - another row that caps throughput (a scan stores every element; STORE is the
+#           scalar store issue rate)
+CHAINS = {
+    'cmpxchg_4': {'ops': 2},
+    'cmpxchg_8': {'ops': 2},
+    'hash_4': {'extra': 2},
+    'hash_8': {'extra': 2},
+    'scan_4i': {'limit': 'STORE'},
+    'scan_8i': {'limit': 'STORE'},
+    'scan_4f': {'limit': 'STORE'},
+    'scan_8f': {'limit': 'STORE'},
+}
+
+# Defaults for the fields no single instruction bounds
+MEMORY_BOUND = {
+    'copy_1': (8, 'memory bandwidth limited'),
+    'copy_2': (4, 'memory bandwidth limited'),
+    'copy_4': (4, 'memory bandwidth limited'),
+    'copy_8': (4, 'memory bandwidth limited'),
+    'transform_1': (4, 'memory + compute balanced'),
+    'transform_2': (4, 'memory + compute balanced'),
+    'transform_4': (4, 'memory + compute balanced'),
+    'transform_8': (4, 'memory + compute balanced'),
+}
+
+# uops.info names instructions by operand form; these are the forms the CSV keys stand for.
+# {v} is the vector register of the profile's width (XMM, YMM or ZMM).
+UOPS_FORMS = {
+    'CMP': 'CMP (R64, R64)',
+    'IMUL': 'IMUL (R64, R64)',
+    'POPCNT': 'POPCNT (R64, R64)',
+    'STORE': 'MOV (M64, R64)',
+    'VPGATHERDD': 'VPGATHERDD ({v}, VSIB_{v}, {v})',
+    'VPGATHERQQ': 'VPGATHERQQ ({v}, VSIB_{v}, {v})',
+    'VPOPCNTD': 'VPOPCNTD ({v}, {v})',
+    'VPOPCNTQ': 'VPOPCNTQ ({v}, {v})',
+    'VCVTDQ2PS': 'VCVTDQ2PS ({v}, {v})',
+    'VCVTDQ2PD': 'VCVTDQ2PD ({v}, XMM)',
+    'VSQRTPS': 'VSQRTPS ({v}, {v})',
+    'VSQRTPD': 'VSQRTPD ({v}, {v})',
+    'VPSLLW': 'VPSLLW ({v}, {v}, I8)',
+    'VPSLLD': 'VPSLLD ({v}, {v}, I8)',
+    'VPSLLQ': 'VPSLLQ ({v}, {v}, I8)',
+}
+
+VECTOR_REGISTER = {128: 'XMM', 256: 'YMM', 512: 'ZMM'}
+
+# Architectural (GPR, vector) register counts by ISA and vector width. AVX-512's EVEX
+# encoding doubles the vector file to 32; x86 GPRs include the stack pointer.
+REGISTERS = {
+    ('x86', 128): (16, 16, 'RAX-R15, XMM0-15'),
+    ('x86', 256): (16, 16, 'RAX-R15, YMM0-15'),
+    ('x86', 512): (16, 32, 'RAX-R15, ZMM0-31'),
+    ('arm', 128): (31, 32, 'X0-X30, V0-V31'),
+    ('arm', 256): (31, 32, 'X0-X30, Z0-Z31'),
+}
+
+
+def uops_form(key, width=256):
+    return UOPS_FORMS.get(key, '%s ({v}, {v}, {v})' % key).format(v=VECTOR_REGISTER[width])
+
+
+class Timing:
+    def __init__(self, latency, rthroughput):
+        self.latency = float(latency)
+        self.rthroughput = float(rthroughput)
+        if self.latency <= 0 or self.rthroughput <= 0:
+            raise ValueError('latency and rthroughput must be positive')
+
+    def n(self):
+        chains = math.ceil(self.latency / self.rthroughput - ROUNDING_SLACK)
+        return max(MIN_N, min(MAX_N, chains))
+
+    def tpc(self):
+        t = 1.0 / self.rthroughput
+        return fmt_number(round(t, 1) if t >= 1 else round(t, 2))
+
+
+def fmt_number(x):
+    return f'{x:g}'
+
+
+def load_csv(path):
+    rows = [line for line in Path(path).read_text(encoding='utf-8').splitlines()
+            if line.strip() and not line.lstrip().startswith('#')]
+    data = {}
+    for row in csv.DictReader(rows):
+        try:
+            data[row['instruction'].strip()] = Timing(row['latency'], row['rthroughput'])
+        except (KeyError, ValueError) as e:
+            raise SystemExit(f'{path}: bad row {row}: {e}')
+    return data
+
+
+def load_uops_xml(path, arch, isa, width=256):
+    """Pick the instructions FIELDS can use out of uops.info's instructions.xml."""
+    keys = [k for f in FIELDS for k in f[3].get(isa, [])]
+    keys += [c['limit'] for c in CHAINS.values() if 'limit' in c]
+    wanted = {uops_form(k, width): k for k in keys}
+    data = {}
+    for inst in ET.parse(path).getroot().iter('instruction'):
+        key = wanted.get(inst.get('string'))
+        if key is None or key in data:
+            continue
+        for a in inst.iter('architecture'):
+            if a.get('name') != arch:
+                continue
+            m = a.find('measurement')
+            if m is None:
+                continue
+            tp = m.get('TP_unrolled') or m.get('TP_loop') or m.get('TP')
+            cycles = [float(lat.get(attr)) for lat in m.iter('latency')
+                      for attr in ('cycles', 'max_cycles') if lat.get(attr)]
+            if tp and cycles:
+                data[key] = Timing(max(cycles), tp)
+    return data
+
+
+def shorten(names):
+    """VPADDB, VPADDW, VPADDD -> VPADDB/W/D; VADDPS, VADDPD -> VADDPS/PD."""
+    base = names[0]
+    parts = [base]
+    for name in names[1:]:
+        common = 0
+        while common < min(len(base), len(name)) and base[common] == name[common]:
+            common += 1
+        if common and base[common - 1] == 'P':
+            common -= 1  # keep packed suffixes whole
+        if common >= len(base) // 2:
+            parts.append(name[common:])
+        else:
+            base = name
+            parts.append(name)
+    return '/'.join(parts)
+
+
+def resolve(spec, data):
+    """Field -> (n, instruction or None, timing or None, reason or None)."""
+    isa = spec['isa']
+    overrides = spec.get('overrides', {})
+    out = {}
+    for field, _, _, candidates in FIELDS:
+        if field in overrides:
+            n, reason = overrides[field]
+            if not isinstance(n, int) or not 1 <= n <= MAX_N:
+                raise SystemExit(f"{spec['name']}: override {field} = {n} is not in 1..{MAX_N}")
+            out[field] = (n, None, None, reason)
+            continue
+        if field in MEMORY_BOUND:
+            n, reason = MEMORY_BOUND[field]
+            out[field] = (n, None, None, reason)
+            continue
+        inst = next((c for c in candidates.get(isa, []) if c in data), None)
+        if inst is None:
+            raise SystemExit(f"{spec['name']}: no timing for {field}; add one of "
+                             f"{candidates.get(isa, [])} to the data or an override")
+        t = chain_timing(spec, field, data[inst], data)
+        out[field] = (t.n(), inst, t, None)
+    for field in overrides:
+        if field not in out:
+            raise SystemExit(f"{spec['name']}: override for unknown field {field}")
+    return out
+
+
+def chain_timing(spec, field, timing, data):
+    chain = CHAINS.get(field)
+    if not chain:
+        return timing
+    rthroughput = timing.rthroughput * chain.get('ops', 1)
+    limit = chain.get('limit')
+    if limit:
+        if limit not in data:
+            raise SystemExit(f"{spec['name']}: no timing for {field}; add {limit} to the data")
+        rthroughput = max(rthroughput, data[limit].rthroughput)
+    return Timing(timing.latency + chain.get('extra', 0), rthroughput)
+
+
+def render(spec, data):
+    resolved = resolve(spec, data)
+    use_case = {f: u for f, _, u, _ in FIELDS}
+
+    # Comment table in field order; instructions with the same use and timing share a row
+    rows = {}
+    for field, _, _, _ in FIELDS:
+        n, inst, t, _ = resolved[field]
+        if inst:
+            names = rows.setdefault((use_case[field], t.latency, t.rthroughput), [])
+            if inst not in names:
+                names.append(inst)
+
+    rule = '    // +----------------+------------+---------+-------+-------+'
+    lines = [f"    // {spec['title']} - Source: {spec['source']}",
+             '    //',
+             rule,
+             '    // | Instruction    | Use Case   | Latency | RThr  | L×TPC |',
+             rule]
+    for (use, lat, rthr), names in rows.items():
+        t = Timing(lat, rthr)
+        lines.append(f'    // | {shorten(names):<14} | {use:<10} | {fmt_number(lat):^7} | '
+                     f'{rthr:5.2f} | {t.n():^5} |')
+    lines.append(rule)
+    lines.append(f"    inline constexpr Profile {spec['name']} = {{")
+    lines.append(f'        .id = "{spec["name"]}",')
+
+    group = None
+    for field, g, _, _ in FIELDS:
+        if g != group:
+            group = g
+            lines.append(f'        // {g} - {group_comment(g, resolved)}')
+        lines.append(f'        .{field} = {resolved[field][0]},')
+    gpr, vec, names = registers(spec)
+    lines.append(f'        // Registers - {names}')
+    lines.append(f'        .gpr_registers = {gpr},')
+    lines.append(f'        .vector_registers = {vec},')
+    caches = spec['caches']
+    sizes = ', '.join(f'{level.upper()} {fmt_kib(caches[level])}' for level in ('l1d', 'l2', 'llc'))
+    part = f" ({caches['part']})" if caches.get('part') else ''
+    lines.append(f'        // Caches - {sizes}{part}')
+    for level in ('l1d', 'l2', 'llc'):
+        lines.append(f'        .{level}_kib = {caches[level]},')
+    lines.append('    };')
+    return '\n'.join(lines) + '\n'
+
+
+def fmt_kib(kib):
+    return f'{kib // 1024} MiB' if kib >= 1024 and kib % 1024 == 0 else f'{kib} KiB'
+
+
+def registers(spec):
+    # NEON is 128-bit, and x86 profiles without a width are timed on their 256-bit forms
+    key = (spec['isa'], spec.get('width') or (128 if spec['isa'] == 'arm' else 256))
+    if key not in REGISTERS:
+        raise SystemExit(f"{spec['name']}: no register counts for {key[0]} at {key[1]} bits")
+    return REGISTERS[key]
+
+
+def group_comment(group, resolved):
+    fields = [f for f, g, _, _ in FIELDS if g == group]
+    parts = []
+    by_timing = {}
+    for f in fields:
+        n, inst, t, _ = resolved[f]
+        if inst:
+            by_timing.setdefault((t.latency, t.rthroughput), []).append(inst)
+    for (lat, rthr), insts in by_timing.items():
+        t = Timing(lat, rthr)
+        names = list(dict.fromkeys(insts))
+        parts.append(f'{shorten(names)}: L={fmt_number(lat)}, TPC={t.tpc()} → {t.n()}')
+
+    reasons = [(f, resolved[f][3]) for f in fields if resolved[f][3]]
+    if reasons:
+        common = {r for _, r in reasons}
+        if len(common) == 1 and len(reasons) == len(fields):
+            parts.append(reasons[0][1])
+        else:
+            pinned = {}
+            for f, r in reasons:
+                if r == MEMORY_BOUND.get(f, (None, None))[1]:
+                    parts.append(r)
+                else:
+                    pinned.setdefault((r, resolved[f][0]), []).append(f)
+            for (r, n), fs in pinned.items():
+                parts.append(f'{shorten(fs)}: {r} → {n}')
+    return '; '.join(dict.fromkeys(parts))
+
+
+def load_specs():
+    specs = json.loads((PROFILES / 'profiles.json').read_text(encoding='utf-8'))
+    for name, spec in specs.items():
+        spec['name'] = name
+    return specs
+
+
+def spec_data(spec):
+    return load_csv(PROFILES / spec['data'])
+
+
+def block_span(lines, name):
+    """Line range of the comment block and initializer of `name` in the header."""
+    decl = f'    inline constexpr Profile {name} = {{'
+    try:
+        i = lines.index(decl)
+    except ValueError:
+        return None
+    start = i
+    while start > 0 and lines[start - 1].startswith('    //'):
+        start -= 1
+    end = lines.index('    };', i)
+    return start, end + 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('profiles', nargs='*', help='shipped profiles to generate (default: all)')
+    mode = ap.add_mutually_exclusive_group()
+    mode.add_argument('--check', action='store_true', help='diff the header against the generated blocks')
+    mode.add_argument('--write', action='store_true', help='rewrite the blocks in the header')
+    ap.add_argument('--name', help='generate a new profile with this name')
+    ap.add_argument('--title', help='comment title of a new profile')
+    ap.add_argument('--source', default='https://uops.info', help='source line of a new profile')
+    ap.add_argument('--isa', choices=['x86', 'arm'], default='x86')
+    ap.add_argument('--csv', help='timing CSV for a new profile')
+    ap.add_argument('--uops-xml', help='uops.info instructions.xml for a new profile')
+    ap.add_argument('--arch', help='uops.info architecture name, e.g. SKL, ADL-P, ZEN4')
+    ap.add_argument('--width', type=int, choices=sorted(VECTOR_REGISTER),
+                    help='vector width of the uops.info forms and the register file '
+                         '(default: 256 on x86, 128 on arm)')
+    ap.add_argument('--caches', default='32,256,8192', metavar='L1D,L2,LLC',
+                    help='cache sizes of a new profile in KiB (default: default_profile\'s)')
+    ap.add_argument('--override', action='append', default=[], metavar='FIELD=N:REASON',
+                    help='pin a field of a new profile')
+    args = ap.parse_args()
+
+    if args.name:
+        if not (args.csv or (args.uops_xml and args.arch)):
+            ap.error('--name needs --csv or --uops-xml with --arch')
+        overrides = {}
+        for o in args.override:
+            field, _, rest = o.partition('=')
+            n, _, reason = rest.partition(':')
+            overrides[field] = [int(n), reason or 'pinned']
+        spec = {'name': args.name, 'title': args.title or args.name, 'source': args.source,
+                'isa': args.isa, 'width': args.width, 'overrides': overrides}
+        try:
+            l1d, l2, llc = (int(kib) for kib in args.caches.split(','))
+        except ValueError:
+            ap.error('--caches takes three sizes in KiB, e.g. 48,2048,107520')
+        spec['caches'] = {'l1d': l1d, 'l2': l2, 'llc': llc}
+        data = load_csv(args.csv) if args.csv else load_uops_xml(args.uops_xml, args.arch, args.isa, args.width or 256)
+        sys.stdout.write(render(spec, data))
+        return 0
+
+    specs = load_specs()
+    names = args.profiles or list(specs)
+    for n in names:
+        if n not in specs:
+            ap.error(f'unknown profile {n}; known: {", ".join(specs)}')
+
+    if not (args.check or args.write):
+        sys.stdout.write('\n'.join(render(specs[n], spec_data(specs[n])) for n in names))
+        return 0
+
+    text = HEADER.read_text(encoding='utf-8')
+    lines = text.split('\n')
+    stale = []
+    for n in names:
+        want = render(specs[n], spec_data(specs[n])).rstrip('\n').split('\n')
+        span = block_span(lines, n)
+        if span is None:
+            # New profiles go in front of the hand-written default_profile
+            at = block_span(lines, 'default_profile')[0]
+            lines[at:at] = [''] * 2
+            span = (at, at)
+        have = lines[span[0]:span[1]]
+        if want != have:
+            stale.append(n)
+            if args.check:
+                sys.stdout.writelines(difflib.unified_diff(
+                    [l + '\n' for l in have], [l + '\n' for l in want],
+                    f'{HEADER.name} ({n})', f'generated ({n})'))
+            lines[span[0]:span[1]] = want
+
+    if args.write:
+        if stale:
+            HEADER.write_text('\n'.join(lines), encoding='utf-8')
+        print(f'regenerated: {", ".join(stale) or "nothing to do"}')
+        return 0
+
+    if stale:
+        print(f'\n{HEADER.name} is out of date for: {", ".join(stale)}\n'
+              f'run scripts/generate_profile.py --write', file=sys.stderr)
+        return 1
+    print(f'{HEADER.name} matches scripts/profiles for: {", ".join(names)}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,186 @@
+#include "../../ilp_for.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <coroutine>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// ILP_FOR_ASYNC - concurrently awaiting bodies (plain loop in SIMPLE mode)
+
+namespace {
+    // Fake I/O device: reads complete only when the executor runs out of ready work,
+    // newest request first, so later indices routinely finish before earlier ones.
+    class FakeIo {
+      public:
+        struct ReadAwaiter {
+            FakeIo& io;
+            int key;
+            int result = 0;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) {
+                io.pending_.push_back({h, this});
+                io.max_in_flight = std::max(io.max_in_flight, io.pending_.size());
+            }
+            int await_resume() const noexcept { return result; }
+        };
+
+        ReadAwaiter read(int key) { return ReadAwaiter{*this, key}; }
+
+        void post(std::coroutine_handle<> h) { queue_.post(h); }
+
+        bool run_one() {
+            if (queue_.run_one())
+                return true;
+            if (pending_.empty())
+                return false;
+            auto req = pending_.back();
+            pending_.pop_back();
+            req.awaiter->result = req.awaiter->key * 10;
+            ++completed;
+            req.h.resume();
+            return true;
+        }
+
+        std::size_t max_in_flight = 0;
+        std::size_t completed = 0;
+
+      private:
+        struct Request {
+            std::coroutine_handle<> h;
+            ReadAwaiter* awaiter;
+        };
+
+        ilp::RunQueue queue_;
+        std::vector<Request> pending_;
+    };
+
+    static_assert(ilp::Executor<FakeIo>);
+    static_assert(ilp::Executor<ilp::RunQueue>);
+
+    ilp::Task<long> sum_reads(FakeIo& io, int n) {
+        long sum = 0;
+        ILP_FOR_ASYNC(auto i, 0, n, 4) {
+            sum += co_await io.read(i);
+        }
+        ILP_END_ASYNC;
+        co_return sum;
+    }
+
+    ilp::Task<std::optional<int>> find_read(FakeIo& io, const std::vector<int>& keys, int target) {
+        ILP_FOR_ASYNC(auto i, std::size_t{0}, keys.size(), 4) {
+            int v = co_await io.read(keys[i]);
+            if (v == target)
+                ILP_ASYNC_RETURN(static_cast<int>(i));
+        }
+        ILP_END_ASYNC_RETURN;
+        co_return std::nullopt;
+    }
+} // namespace
+
+TEST_CASE("ILP_FOR_ASYNC visits every index", "[async]") {
+    FakeIo io;
+    CHECK(ilp::sync_wait(io, sum_reads(io, 103)) == 10L * 103 * 102 / 2);
+    CHECK(io.completed == 103);
+#if !defined(ILP_MODE_SIMPLE)
+    CHECK(io.max_in_flight == 4);
+#else
+    CHECK(io.max_in_flight == 1);
+#endif
+}
+
+TEST_CASE("ILP_FOR_ASYNC empty range", "[async]") {
+    FakeIo io;
+    CHECK(ilp::sync_wait(io, sum_reads(io, 0)) == 0);
+    CHECK(io.completed == 0);
+}
+
+TEST_CASE("ILP_FOR_ASYNC return resolves to lowest index", "[async][return]") {
+    FakeIo io;
+    std::vector<int> keys(40);
+    for (int i = 0; i < 40; ++i)
+        keys[i] = i;
+
+    SECTION("two matches in one block") {
+        // 9 and 10 share a block; 10 completes first but 9 wins
+        keys[10] = 9;
+        CHECK(ilp::sync_wait(io, find_read(io, keys, 90)) == 9);
+        CHECK(io.completed <= 12); // remaining blocks never started
+    }
+
+    SECTION("no match") {
+        CHECK_FALSE(ilp::sync_wait(io, find_read(io, keys, -10)).has_value());
+        CHECK(io.completed == 40);
+    }
+}
+
+TEST_CASE("ILP_FOR_ASYNC break stops later blocks", "[async][break]") {
+    FakeIo io;
+    std::vector<int> visited;
+
+    auto run = [&]() -> ilp::Task<> {
+        ILP_FOR_ASYNC(auto i, 0, 100, 4) {
+            int v = co_await io.read(i);
+            if (v == 170 || v == 190)
+                ILP_ASYNC_BREAK;
+            visited.push_back(i);
+        }
+        ILP_END_ASYNC;
+    };
+    ilp::sync_wait(io, run());
+
+    std::sort(visited.begin(), visited.end());
+    REQUIRE(visited.size() >= 17);
+    for (int i = 0; i < 17; ++i)
+        CHECK(visited[i] == i);
+    CHECK(visited.back() < 20);
+}
+
+TEST_CASE("ILP_FOR_ASYNC propagates exceptions", "[async][exception]") {
+    FakeIo io;
+    auto run = [&]() -> ilp::Task<> {
+        ILP_FOR_ASYNC(auto i, 0, 50, 4) {
+            co_await io.read(i);
+            if (i == 6)
+                throw std::runtime_error("read failed");
+        }
+        ILP_END_ASYNC;
+    };
+    CHECK_THROWS_AS(ilp::sync_wait(io, run()), std::runtime_error);
+    CHECK(io.completed <= 8);
+}
+
+#if !defined(ILP_MODE_SIMPLE)
+
+TEST_CASE("for_loop_async with synchronous bodies", "[async][sync]") {
+    // Bodies that never suspend complete during launch; the join must not resume early
+    ilp::RunQueue q;
+    int sum = 0;
+    auto run = [&]() -> ilp::Task<int> {
+        auto r = co_await ilp::for_loop_async<8>(0, 21, [&](int i, ilp::ForCtrl&) -> ilp::AsyncBody {
+            sum += i;
+            co_return;
+        });
+        (void)r;
+        co_return sum;
+    };
+    CHECK(ilp::sync_wait(q, run()) == 210);
+    CHECK(ilp::detail::current_frame_pool == nullptr);
+}
+
+TEST_CASE("for_loop_async through an executor hop", "[async][schedule]") {
+    ilp::RunQueue q;
+    std::vector<int> order;
+    auto run = [&]() -> ilp::Task<> {
+        auto r = co_await ilp::for_loop_async<3>(0, 6, [&](int i, ilp::ForCtrl&) -> ilp::AsyncBody {
+            co_await ilp::schedule(q);
+            order.push_back(i);
+        });
+        (void)r;
+    };
+    ilp::sync_wait(q, run());
+    CHECK(order == std::vector<int>{0, 1, 2, 3, 4, 5});
+}
+
+#endif // !ILP_MODE_SIMPLE
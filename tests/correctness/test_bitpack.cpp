@@ -0,0 +1,131 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/kernels/bitpack.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+// ilp::packed_view / dict_view and for_each_decoded - block unpacking vs one value at a time
+
+namespace {
+
+    template<unsigned Bits>
+    std::vector<std::uint64_t> random_values(std::size_t n, unsigned seed = 7) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint64_t> v(n);
+        for (auto& x : v)
+            x = rng() & ilp::bitpack::mask<Bits>;
+        return v;
+    }
+
+    template<unsigned Bits, std::size_t N>
+    void check_width(std::size_t n) {
+        const auto values = random_values<Bits>(n, Bits);
+        const auto words = ilp::bitpack::pack<Bits>(values);
+        REQUIRE(words.size() == ilp::bitpack::words_for(Bits, n));
+        const ilp::packed_view<Bits> col(words, n);
+
+        for (std::size_t i = 0; i < n; ++i)
+            REQUIRE(col[i] == values[i]);
+
+        std::vector<std::uint64_t> out;
+        CHECK(ilp::for_each_decoded<N>(col, [&](auto v) { out.push_back(v); }) == n);
+        CHECK(out == values);
+    }
+
+} // namespace
+
+TEST_CASE("pack and for_each_decoded round trip", "[bitpack]") {
+    for (std::size_t n : {0u, 1u, 7u, 63u, 64u, 65u, 1000u}) {
+        INFO("n = " << n);
+        check_width<1, 8>(n);
+        check_width<3, 4>(n);
+        check_width<7, 8>(n);
+        check_width<12, 8>(n);
+        check_width<12, 3>(n);
+        check_width<16, 16>(n);
+        check_width<33, 4>(n);
+        check_width<64, 2>(n);
+    }
+}
+
+TEST_CASE("packed_view is a random-access range", "[bitpack]") {
+    const std::vector<std::uint32_t> values{5, 4095, 0, 17, 2048, 9, 1};
+    const auto words = ilp::bitpack::pack<12>(values);
+    const ilp::packed_view<12> col(words, values.size());
+
+    STATIC_REQUIRE(std::ranges::random_access_range<ilp::packed_view<12>>);
+    CHECK(col.end() - col.begin() == 7);
+    CHECK(col.begin()[3] == 17u);
+
+    std::uint64_t sum = 0;
+    ILP_FOR_RANGE(auto v, col, 4) {
+        sum += v;
+    }
+    ILP_END;
+    CHECK(sum == 5u + 4095u + 17u + 2048u + 9u + 1u);
+}
+
+TEST_CASE("for_each_decoded stops decoding at a break", "[bitpack]") {
+    const auto values = random_values<12>(1000);
+    const auto words = ilp::bitpack::pack<12>(values);
+    const ilp::packed_view<12> col(words, values.size());
+
+    for (std::size_t at : {0u, 5u, 15u, 16u, 500u, 991u, 999u}) {
+        INFO("break at " << at);
+        std::size_t calls = 0;
+        const std::size_t used = ilp::for_each_decoded<8>(col, [&](std::uint32_t, ilp::LoopCtrl<void>& ctrl) {
+            if (calls++ == at)
+                ctrl.break_loop();
+        });
+        CHECK(used == at + 1);
+        CHECK(calls == at + 1);
+    }
+
+    std::size_t calls = 0;
+    CHECK(ilp::for_each_decoded(col, [&](std::uint32_t, ilp::LoopCtrl<void>&) { ++calls; }) == 1000);
+    CHECK(calls == 1000);
+}
+
+TEST_CASE("dict_view maps codes through the dictionary", "[bitpack][dict]") {
+    const std::vector<std::string> dict{"apple", "pear", "plum", "fig", "kiwi"};
+    std::vector<std::uint8_t> codes(203);
+    for (std::size_t i = 0; i < codes.size(); ++i)
+        codes[i] = static_cast<std::uint8_t>((i * 7) % dict.size());
+
+    std::vector<std::string> expected;
+    for (auto c : codes)
+        expected.push_back(dict[c]);
+
+    SECTION("Over packed codes") {
+        const auto words = ilp::bitpack::pack<3>(codes);
+        const ilp::dict_view col(ilp::packed_view<3>(words, codes.size()), dict);
+        CHECK(col[4] == "fig");
+
+        std::vector<std::string> out;
+        CHECK(ilp::for_each_decoded<8>(col, [&](const std::string& s) { out.push_back(s); }) == codes.size());
+        CHECK(out == expected);
+
+        const std::size_t used = ilp::for_each_decoded<8>(col, [&](const std::string& s, ilp::LoopCtrl<void>& ctrl) {
+            if (s == "kiwi")
+                ctrl.break_loop();
+        });
+        CHECK(used == 3);
+    }
+
+    SECTION("Over plain codes") {
+        const ilp::dict_view col(std::span<const std::uint8_t>(codes), dict);
+        std::vector<std::string> out;
+        CHECK(ilp::for_each_decoded<4>(col, [&](const std::string& s) { out.push_back(s); }) == codes.size());
+        CHECK(out == expected);
+
+        std::size_t pears = 0;
+        ILP_FOR_RANGE(const auto& s, col, 4) {
+            pears += s == "pear";
+        }
+        ILP_END;
+        CHECK(pears == 40);
+    }
+}
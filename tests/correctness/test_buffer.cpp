@@ -0,0 +1,120 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/memory/buffer.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("buffer is cache-line aligned and padded to whole blocks") {
+    ilp::buffer<float> buf(1000);
+    CHECK(reinterpret_cast<std::uintptr_t>(buf.data()) % ilp::arch::cache_line == 0);
+    CHECK(buf.size() == 1000);
+    CHECK(buf.capacity() % decltype(buf)::block == 0);
+    CHECK(buf.capacity() >= buf.size());
+    CHECK(buf.capacity() - buf.size() < decltype(buf)::block);
+    CHECK(decltype(buf)::block % 16 == 0);
+
+    SECTION("Elements and padding start value-initialized") {
+        for (std::size_t i = 0; i < buf.capacity(); ++i)
+            CHECK(buf.data()[i] == 0.0f);
+    }
+    SECTION("pad() fills only the padding") {
+        ilp::buffer<int, 8> keys(13, 5);
+        keys.pad(-1);
+        CHECK(keys.capacity() == 16);
+        CHECK(keys[12] == 5);
+        CHECK(keys.data()[13] == -1);
+        CHECK(keys.data()[15] == -1);
+    }
+    SECTION("Empty and moved-from buffers") {
+        ilp::buffer<double> none(0);
+        CHECK(none.empty());
+        CHECK(none.capacity() == 0);
+        CHECK(none.data() == nullptr);
+        ilp::buffer<double> moved(3, 1.5);
+        ilp::buffer<double> other(std::move(moved));
+        CHECK(other[2] == 1.5);
+        CHECK(moved.data() == nullptr);
+        none = std::move(other);
+        CHECK(none.size() == 3);
+        CHECK(other.empty());
+    }
+    SECTION("Non-trivial element types") {
+        ilp::buffer<std::string> words(3, std::string(40, 'x'));
+        CHECK(words[2].size() == 40);
+        CHECK(words.data()[words.capacity() - 1].empty());
+    }
+}
+
+TEST_CASE("buffer with huge pages") {
+    constexpr std::size_t n = (std::size_t{3} << 20) / sizeof(std::uint32_t);
+    ilp::buffer<std::uint32_t> big(n, 7u, ilp::Pages::Huge);
+#if ILP_HAS_HUGEPAGES
+    CHECK(reinterpret_cast<std::uintptr_t>(big.data()) % ilp::detail::huge_page_bytes == 0);
+#endif
+    CHECK(big[0] == 7u);
+    CHECK(big[n - 1] == 7u);
+
+    // Below one huge page the same call gives regular aligned storage
+    ilp::buffer<std::uint32_t> small(100, ilp::Pages::Huge);
+    CHECK(reinterpret_cast<std::uintptr_t>(small.data()) % ilp::arch::cache_line == 0);
+}
+
+TEST_CASE("aligned_allocator backs standard containers") {
+    std::vector<double, ilp::aligned_allocator<double>> v(1000, 1.0);
+    CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % ilp::arch::cache_line == 0);
+    v.resize(5000, 2.0);
+    CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % ilp::arch::cache_line == 0);
+    CHECK(std::accumulate(v.begin(), v.end(), 0.0) == 9000.0);
+
+    std::vector<std::uint8_t, ilp::aligned_allocator<std::uint8_t, ilp::Pages::Huge>> bytes(std::size_t{4} << 20, 1);
+    CHECK(bytes.back() == 1);
+}
+
+TEST_CASE("Range loops over padded() skip the remainder loop") {
+    using ilp::detail::whole_blocks_v;
+    using Padded = ilp::padded_span<const float, 16>;
+    STATIC_REQUIRE(whole_blocks_v<Padded, 4>);
+    STATIC_REQUIRE(whole_blocks_v<Padded&, 16>);
+    STATIC_REQUIRE_FALSE(whole_blocks_v<Padded, 3>);
+    STATIC_REQUIRE_FALSE(whole_blocks_v<std::vector<float>, 4>);
+    STATIC_REQUIRE_FALSE(whole_blocks_v<ilp::buffer<float>, 4>);
+
+    ilp::buffer<std::uint32_t> buf(1001);
+    std::iota(buf.begin(), buf.end(), 1u);
+
+    SECTION("Sum over the zero padding") {
+        std::uint64_t sum = 0;
+        ILP_FOR_RANGE(auto x, buf.padded(), 8) {
+            sum += x;
+        }
+        ILP_END;
+        CHECK(sum == 1001u * 1002u / 2);
+    }
+
+    SECTION("Search with a padding value that never matches") {
+        buf.pad(0);
+        auto find = [&](std::uint32_t key) -> std::size_t {
+            ILP_FOR_RANGE(auto&& x, buf.padded(), 4) {
+                if (x == key)
+                    ILP_RETURN(static_cast<std::size_t>(&x - buf.data()));
+            }
+            ILP_END_RETURN;
+            return buf.size();
+        };
+        CHECK(find(1001) == 1000);
+        CHECK(find(5000) == buf.size());
+    }
+
+    SECTION("Break inside the last block") {
+        std::size_t visited = 0;
+        ILP_FOR_RANGE(auto x, buf.padded(), 8) {
+            if (x == 0)
+                ILP_BREAK;
+            ++visited;
+        }
+        ILP_END;
+        CHECK(visited == 1001);
+    }
+}
@@ -0,0 +1,159 @@
+#include "../../ilp_for.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// ILP_FOR_CORO - interleaved coroutine bodies (plain loop in SIMPLE mode)
+
+namespace {
+    struct Node {
+        int value;
+        const Node* next;
+    };
+
+    std::optional<int> find_chain_value(const std::vector<const Node*>& heads, int target) {
+        ILP_FOR_CORO(auto i, std::size_t{0}, heads.size(), 4) {
+            const Node* n = heads[i];
+            ILP_CO_PREFETCH(n);
+            if (n->value == target)
+                ILP_CO_RETURN(static_cast<int>(i));
+            ILP_CO_PREFETCH(n->next);
+            if (n->next->value == target)
+                ILP_CO_RETURN(static_cast<int>(i));
+        }
+        ILP_END_RETURN;
+        return std::nullopt;
+    }
+} // namespace
+
+TEST_CASE("ILP_FOR_CORO visits every index", "[coro]") {
+    std::vector<int> data(103);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<int>(i);
+
+    std::int64_t sum = 0;
+    std::vector<int> seen(data.size(), 0);
+    ILP_FOR_CORO(auto i, std::size_t{0}, data.size(), 4) {
+        ILP_CO_PREFETCH(&data[i]);
+        sum += data[i];
+        seen[i]++;
+    }
+    ILP_END;
+
+    CHECK(sum == 103 * 102 / 2);
+    for (int s : seen)
+        CHECK(s == 1);
+}
+
+TEST_CASE("ILP_FOR_CORO empty range", "[coro]") {
+    int count = 0;
+    ILP_FOR_CORO([[maybe_unused]] auto i, 0, 0, 4) {
+        ILP_CO_PREFETCH(&count);
+        count++;
+    }
+    ILP_END;
+    CHECK(count == 0);
+}
+
+TEST_CASE("ILP_FOR_CORO continue skips", "[coro]") {
+    int sum = 0;
+    ILP_FOR_CORO(auto i, 0, 20, 3) {
+        ILP_CO_PREFETCH(&sum);
+        if (i % 2)
+            ILP_CO_CONTINUE;
+        sum += i;
+    }
+    ILP_END;
+    CHECK(sum == 90);
+}
+
+TEST_CASE("ILP_FOR_CORO return resolves to lowest index", "[coro][return]") {
+    // Two hops per element; matches at different depths so a later index finishes first
+    std::vector<Node> tails(64), nodes(64);
+    std::vector<const Node*> heads(64);
+    for (int i = 0; i < 64; ++i) {
+        tails[i] = Node{1000 + i, nullptr};
+        nodes[i] = Node{i, &tails[i]};
+        heads[i] = &nodes[i];
+    }
+
+    SECTION("match on second hop before later match on first hop") {
+        tails[10].value = -1; // index 10 matches after two suspensions
+        nodes[11].value = -1; // index 11 matches after one
+        CHECK(find_chain_value(heads, -1) == 10);
+    }
+
+    SECTION("single match") {
+        CHECK(find_chain_value(heads, 1037) == 37);
+    }
+
+    SECTION("no match") {
+        CHECK_FALSE(find_chain_value(heads, -5).has_value());
+    }
+}
+
+TEST_CASE("ILP_FOR_CORO break stops at lowest index", "[coro][break]") {
+    std::vector<int> data(50, 0);
+    data[30] = 1;
+    data[33] = 1;
+
+    int last = -1;
+    ILP_FOR_CORO(auto i, 0, 50, 4) {
+        ILP_CO_PREFETCH(&data[i]);
+        if (data[i])
+            ILP_CO_BREAK;
+        if (i > last)
+            last = i;
+    }
+    ILP_END;
+    CHECK(last == 29);
+}
+
+#if !defined(ILP_MODE_SIMPLE)
+
+TEST_CASE("for_loop_coro keeps frames in the arena", "[coro][arena]") {
+    // Frames come from the driver's arena while it runs; the pool is uninstalled after
+    CHECK(ilp::detail::current_frame_pool == nullptr);
+    const ilp::detail::coro_frame_pool* during = nullptr;
+
+    auto r = ilp::for_loop_coro<4>(0, 16, [&](int, ilp::ForCtrl&) -> ilp::CoroTask {
+        during = ilp::detail::current_frame_pool;
+        co_return;
+    });
+    CHECK_FALSE(r.has_return);
+    CHECK(during != nullptr);
+    CHECK(ilp::detail::current_frame_pool == nullptr);
+}
+
+TEST_CASE("for_loop_coro propagates exceptions", "[coro][exception]") {
+    int started = 0;
+    auto run = [&] {
+        (void)ilp::for_loop_coro<4>(0, 100, [&](int i, ilp::ForCtrl&) -> ilp::CoroTask {
+            ++started;
+            co_await ilp::prefetch(&started);
+            if (i == 5)
+                throw std::runtime_error("boom");
+        });
+    };
+    CHECK_THROWS_AS(run(), std::runtime_error);
+    CHECK(started >= 6);
+    CHECK(ilp::detail::current_frame_pool == nullptr);
+}
+
+TEST_CASE("for_loop_coro nested drivers", "[coro][nested]") {
+    int total = 0;
+    auto r = ilp::for_loop_coro<2>(0, 4, [&](int, ilp::ForCtrl&) -> ilp::CoroTask {
+        auto inner = ilp::for_loop_coro<3>(0, 5, [&](int j, ilp::ForCtrl&) -> ilp::CoroTask {
+            co_await ilp::prefetch(&total);
+            total += j;
+        });
+        (void)inner;
+        co_return;
+    });
+    CHECK_FALSE(r.has_return);
+    CHECK(total == 40);
+}
+
+#endif // !ILP_MODE_SIMPLE
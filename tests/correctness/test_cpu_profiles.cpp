@@ -1,5 +1,7 @@
-#include "../../ilp_for/cpu_profiles/ilp_cpu_profiles.hpp"
+#include "../../ilp_for/cpu_profiles/ilp_cpu.hpp"
 #include "catch.hpp"
+#include <algorithm>
+#include <cstdint>
 
 TEST_CASE("cpu::get returns correct profiles for known names") {
     SECTION("Apple M1 variants") {
@@ -10,18 +12,210 @@ TEST_CASE("cpu::get returns correct profiles for known names") {
         CHECK(&ilp::cpu::get("alderlake") == &ilp::cpu::alderlake);
         CHECK(&ilp::cpu::get("alder_lake") == &ilp::cpu::alderlake);
     }
+    SECTION("Intel server variants") {
+        CHECK(&ilp::cpu::get("icelake") == &ilp::cpu::icelake);
+        CHECK(&ilp::cpu::get("ice_lake") == &ilp::cpu::icelake);
+        CHECK(&ilp::cpu::get("sapphirerapids") == &ilp::cpu::sapphirerapids);
+        CHECK(&ilp::cpu::get("sapphire_rapids") == &ilp::cpu::sapphirerapids);
+        CHECK(&ilp::cpu::get("spr") == &ilp::cpu::sapphirerapids);
+        CHECK(&ilp::cpu::get("icelake_avx512") == &ilp::cpu::icelake_avx512);
+        CHECK(&ilp::cpu::get("spr_avx512") == &ilp::cpu::sapphirerapids_avx512);
+    }
     SECTION("Zen variants") {
         CHECK(&ilp::cpu::get("zen5") == &ilp::cpu::zen5);
-        CHECK(&ilp::cpu::get("zen4") == &ilp::cpu::zen5);
+        CHECK(&ilp::cpu::get("zen4") == &ilp::cpu::zen4);
         CHECK(&ilp::cpu::get("zen") == &ilp::cpu::zen5);
+        CHECK(&ilp::cpu::get("zen4_avx512") == &ilp::cpu::zen4_avx512);
+        CHECK(&ilp::cpu::get("zen5_avx512") == &ilp::cpu::zen5_avx512);
+    }
+    SECTION("Neoverse variants") {
+        CHECK(&ilp::cpu::get("neoverse_v1") == &ilp::cpu::neoverse_v1);
+        CHECK(&ilp::cpu::get("graviton3") == &ilp::cpu::neoverse_v1);
+        CHECK(&ilp::cpu::get("neoverse_v2") == &ilp::cpu::neoverse_v2);
+        CHECK(&ilp::cpu::get("graviton4") == &ilp::cpu::neoverse_v2);
+        CHECK(&ilp::cpu::get("neoverse_n2") == &ilp::cpu::neoverse_n2);
+        CHECK(&ilp::cpu::get("neoverse_v1_sve") == &ilp::cpu::neoverse_v1_sve);
     }
     SECTION("Default profile") {
         CHECK(&ilp::cpu::get("default") == &ilp::cpu::default_profile);
     }
 }
 
+TEST_CASE("cpu profiles keep parts of a family apart") {
+    // Zen 5 cut FP add latency from 3 to 2 cycles
+    CHECK(ilp::cpu::zen4.sum_4f == 6);
+    CHECK(ilp::cpu::zen5.sum_4f == 4);
+    // Sapphire Rapids has VPMULLQ only with AVX-512; without it, like client Golden Cove, 64-bit
+    // multiply is scalar IMUL
+    CHECK(ilp::cpu::sapphirerapids_avx512.multiply_8i == 10);
+    CHECK(ilp::cpu::sapphirerapids.multiply_8i == 3);
+    CHECK(ilp::cpu::alderlake.multiply_8i == 3);
+    // Neoverse N2 has half the vector pipes of V1/V2
+    CHECK(ilp::cpu::neoverse_n2.dotproduct_4 * 2 == ilp::cpu::neoverse_v2.dotproduct_4);
+}
+
+TEST_CASE("Gather, Popcount, CompareExchange, Convert, Hash and Scan have profile fields") {
+    using ilp::LoopType;
+    SECTION("optimal_N reads the field for the element size") {
+        CHECK(ilp::optimal_N<LoopType::Gather, int> == std::size_t(ILP_CPU_PROFILE.gather_4));
+        CHECK(ilp::optimal_N<LoopType::Gather, double> == std::size_t(ILP_CPU_PROFILE.gather_8));
+        CHECK(ilp::optimal_N<LoopType::Convert, float> == std::size_t(ILP_CPU_PROFILE.convert_4));
+        CHECK(ilp::optimal_N<LoopType::CompareExchange, std::int64_t> == std::size_t(ILP_CPU_PROFILE.cmpxchg_8));
+        CHECK(ilp::optimal_N<LoopType::Scan, float> == std::size_t(ILP_CPU_PROFILE.scan_4f));
+        CHECK(ilp::optimal_N<LoopType::Scan, std::int64_t> == std::size_t(ILP_CPU_PROFILE.scan_8i));
+        // Accumulating kinds are register-capped like Sum; one live value never bites
+        CHECK(ilp::optimal_N<LoopType::Popcount, std::uint64_t> == std::size_t(ILP_CPU_PROFILE.popcount_8));
+        CHECK(ilp::optimal_N<LoopType::Hash, std::uint32_t> == std::size_t(ILP_CPU_PROFILE.hash_4));
+        CHECK(ilp::optimal_N<LoopType::Popcount, std::uint8_t> == std::size_t(ILP_CPU_PROFILE.popcount_4));
+    }
+    SECTION("Values follow the hardware") {
+        // Zen 4 microcodes gathers; Golden Cove runs them natively
+        CHECK(ilp::cpu::zen4.gather_4 < ilp::cpu::alderlake.gather_4);
+        // A scan stores every element, so one store port caps Skylake below its FP add N
+        CHECK(ilp::cpu::skylake.scan_4f < ilp::cpu::skylake.sum_4f);
+        // The xor and shift of a hash round sit on the multiply's chain
+        CHECK(ilp::cpu::skylake.hash_8 > ilp::cpu::skylake.multiply_8i);
+        // NEON has no gather: scalar loads, three per cycle on V1
+        CHECK(ilp::cpu::neoverse_v1.gather_4 > ilp::cpu::neoverse_v1_sve.gather_4);
+    }
+}
+
+TEST_CASE("cpu::for_isa picks the variant for the vector width") {
+    using ilp::cpu::VectorISA;
+    SECTION("AVX-512") {
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::icelake, VectorISA::AVX512) == &ilp::cpu::icelake_avx512);
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::sapphirerapids, VectorISA::AVX512) == &ilp::cpu::sapphirerapids_avx512);
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::zen4, VectorISA::AVX512) == &ilp::cpu::zen4_avx512);
+        // Zen 5's timings don't change with width; the variant adds VPMULLQ and VPMAXSQ
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::zen5, VectorISA::AVX512) == &ilp::cpu::zen5_avx512);
+    }
+    SECTION("SVE") {
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::neoverse_v1, VectorISA::SVE) == &ilp::cpu::neoverse_v1_sve);
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::neoverse_v2, VectorISA::SVE) == &ilp::cpu::neoverse_v2);
+    }
+    SECTION("Narrower ISAs keep the base profile") {
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::sapphirerapids, VectorISA::AVX2) == &ilp::cpu::sapphirerapids);
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::zen4, VectorISA::SSE) == &ilp::cpu::zen4);
+        CHECK(&ilp::cpu::for_isa(ilp::cpu::neoverse_v1, VectorISA::NEON) == &ilp::cpu::neoverse_v1);
+    }
+    SECTION("Variants differ where the hardware does") {
+        // Double-pumped 512-bit ops halve Zen 4 throughput
+        CHECK(ilp::cpu::zen4_avx512.sum_8f * 2 == ilp::cpu::zen4.sum_8f);
+        // Sapphire Rapids runs 512-bit FP adds on ports 0 and 5
+        CHECK(ilp::cpu::sapphirerapids_avx512.sum_8f > ilp::cpu::sapphirerapids.sum_8f);
+        // Without AVX-512, 64-bit multiply and max are scalar IMUL and VPCMPGTQ
+        CHECK(ilp::cpu::zen5.multiply_8i == 3);
+        CHECK(ilp::cpu::zen5_avx512.multiply_8i == 6);
+        CHECK(ilp::cpu::zen5_avx512.sum_8f == ilp::cpu::zen5.sum_8f);
+    }
+}
+
+TEST_CASE("ILP_VECTOR_ISA follows the target") {
+    constexpr auto isa = ilp::cpu::VectorISA::ILP_VECTOR_ISA;
+#if defined(__AVX512F__)
+    CHECK(isa == ilp::cpu::VectorISA::AVX512);
+#elif defined(__AVX2__)
+    CHECK(isa == ilp::cpu::VectorISA::AVX2);
+#elif defined(__SSE2__) || defined(_M_X64)
+    CHECK(isa == ilp::cpu::VectorISA::SSE);
+#endif
+    CHECK(&ILP_CPU_PROFILE == &ilp::cpu::for_isa(ILP_CPU_BASE_PROFILE, isa));
+}
+
 TEST_CASE("cpu::get falls back to skylake for unknown names") {
     CHECK(&ilp::cpu::get("unknown") == &ilp::cpu::skylake);
     CHECK(&ilp::cpu::get("") == &ilp::cpu::skylake);
     CHECK(&ilp::cpu::get("skylake") == &ilp::cpu::skylake);
 }
+
+TEST_CASE("register_capped_N keeps the unrolled block in registers") {
+    using ilp::cpu::register_capped_N;
+    SECTION("No hint leaves N alone") {
+        CHECK(register_capped_N(ilp::cpu::apple_m1, 16, 0, true) == 16);
+    }
+    SECTION("Floating point is bounded by the vector file") {
+        // 16 YMM on Skylake; 32 ZMM once AVX-512 is in use
+        CHECK(register_capped_N(ilp::cpu::skylake, 8, 3, true) == 5);
+        CHECK(register_capped_N(ilp::cpu::sapphirerapids_avx512, 16, 3, true) == 10);
+        CHECK(register_capped_N(ilp::cpu::apple_m1, 16, 2, true) == 16);
+    }
+    SECTION("Integers are bounded by the smaller file, less the loop's own GPRs") {
+        CHECK(register_capped_N(ilp::cpu::skylake, 10, 1, false) == 10);
+        CHECK(register_capped_N(ilp::cpu::skylake, 10, 2, false) == 6);
+    }
+    SECTION("Never below one lane") {
+        CHECK(register_capped_N(ilp::cpu::skylake, 8, 40, true) == 1);
+    }
+    SECTION("optimal_N applies the cap") {
+        CHECK(ilp::optimal_N<ilp::LoopType::Sum, double, 0> == ilp::optimal_N<ilp::LoopType::Sum, double>);
+        CHECK(ilp::optimal_N<ilp::LoopType::DotProduct, float, 64> == 1);
+        CHECK(ilp::optimal_N<ilp::LoopType::DotProduct, float, 2> <= ilp::optimal_N<ilp::LoopType::DotProduct, float>);
+    }
+}
+
+TEST_CASE("optimal_N_for combines the loop types in a body") {
+    using ilp::LoopType;
+    SECTION("A single LoopType is optimal_N") {
+        CHECK(ilp::optimal_N_for<float, LoopType::Sum> == ilp::optimal_N<LoopType::Sum, float>);
+        CHECK(ilp::optimal_N_for<int, LoopType::Search> == ilp::optimal_N<LoopType::Search, int>);
+    }
+    SECTION("Independent port groups take the longest chain") {
+        constexpr auto n = ilp::optimal_N_for<int, LoopType::Search, LoopType::Sum>;
+        CHECK(n == std::max(ilp::optimal_N<LoopType::Search, int>, ilp::optimal_N<LoopType::Sum, int>));
+        CHECK(ilp::optimal_N_for<double, LoopType::Sum, LoopType::Sqrt> == ilp::optimal_N<LoopType::Sum, double>);
+    }
+    SECTION("Accumulators of every class share the register file") {
+        using ilp::cpu::register_capped_N;
+        constexpr auto longest = std::max({ilp::optimal_N<LoopType::Sum, float>, ilp::optimal_N<LoopType::MinMax, float>,
+                                           ilp::optimal_N<LoopType::DotProduct, float>});
+        constexpr auto capped = register_capped_N(ILP_CPU_PROFILE, static_cast<int>(longest), 3, true);
+        CHECK(ilp::optimal_N_for<float, LoopType::Sum, LoopType::MinMax, LoopType::DotProduct> ==
+              static_cast<std::size_t>(capped));
+    }
+    SECTION("Classes without an accumulator add no pressure") {
+        CHECK(ilp::optimal_N_for<int, LoopType::Copy, LoopType::Search> ==
+              std::max(ilp::optimal_N<LoopType::Copy, int>, ilp::optimal_N<LoopType::Search, int>));
+    }
+}
+
+namespace {
+    // 16-byte decimal add: two dependent 64-bit adds with carry, in general-purpose registers
+    struct DecimalAdd {
+        static constexpr ilp::LoopCost cost(const ilp::cpu::Profile&) {
+            return {.latency = 2, .per_cycle = 2, .live_per_lane = 2, .vector = false};
+        }
+    };
+
+    // Cost that follows the profile: a chain of two FMAs. FMA latency is 4 on the parts this
+    // targets, so the profile's dotproduct N over 4 is FMA throughput.
+    struct TwoFma {
+        static constexpr ilp::LoopCost cost(const ilp::cpu::Profile& p) {
+            return {.latency = 8, .per_cycle = p.dotproduct_8 / 4.0};
+        }
+    };
+
+    struct NotALoopType {};
+} // namespace
+
+TEST_CASE("Custom loop types plug into optimal_N") {
+    using ilp::LoopType;
+    using ilp::cpu::register_capped_N;
+    static_assert(ilp::CustomLoopType<DecimalAdd>);
+    static_assert(!ilp::CustomLoopType<NotALoopType>);
+    static_assert(!ilp::LoopKind<int>);
+
+    SECTION("N is latency x throughput, capped by the type's registers") {
+        CHECK(ilp::optimal_N<DecimalAdd{}, int> ==
+              static_cast<std::size_t>(register_capped_N(ILP_CPU_PROFILE, 4, 2, false)));
+        CHECK(ilp::optimal_N<TwoFma{}, double> ==
+              std::min<std::size_t>(2 * static_cast<std::size_t>(ILP_CPU_PROFILE.dotproduct_8), 16));
+    }
+    SECTION("An explicit LivePerLane hint wins over the type's own") {
+        CHECK(ilp::optimal_N<DecimalAdd{}, int, 40> == 1);
+    }
+    SECTION("Custom types mix with built-in ones") {
+        CHECK(ilp::optimal_N_for<double, TwoFma{}> == ilp::optimal_N<TwoFma{}, double>);
+        CHECK(ilp::optimal_N_for<int, LoopType::Search, DecimalAdd{}> >= 1);
+        CHECK(ilp::optimal_N_for<int, LoopType::Search, DecimalAdd{}> <= ilp::optimal_N<DecimalAdd{}, int>);
+    }
+}
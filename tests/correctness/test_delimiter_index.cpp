@@ -0,0 +1,138 @@
+#include "../../ilp_for/kernels/delimiter_index.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ilp::delimiter_index - SWAR structural index vs a char-by-char reference
+
+namespace {
+    std::vector<std::uint32_t> reference_index(std::string_view text, std::string_view delims, char quote) {
+        std::vector<std::uint32_t> out;
+        bool in_quote = false;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (quote != '\0' && text[i] == quote)
+                in_quote = !in_quote;
+            else if (!in_quote && delims.find(text[i]) != std::string_view::npos)
+                out.push_back(static_cast<std::uint32_t>(i));
+        }
+        return out;
+    }
+
+    std::string random_csv(std::size_t rows, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::string s;
+        for (std::size_t r = 0; r < rows; ++r) {
+            const int fields = 1 + static_cast<int>(rng() % 8);
+            for (int f = 0; f < fields; ++f) {
+                if (f)
+                    s.push_back(',');
+                if (rng() % 4 == 0) {
+                    // Quoted field with embedded delimiters, newlines and "" escapes
+                    s.push_back('"');
+                    for (int k = static_cast<int>(rng() % 30); k > 0; --k) {
+                        const char pool[] = "ab,\n\"x y";
+                        char c = pool[rng() % (sizeof(pool) - 1)];
+                        if (c == '"')
+                            s += "\"\"";
+                        else
+                            s.push_back(c);
+                    }
+                    s.push_back('"');
+                } else {
+                    for (int k = static_cast<int>(rng() % 20); k > 0; --k)
+                        s.push_back(static_cast<char>('0' + rng() % 75));
+                }
+            }
+            s.push_back('\n');
+        }
+        return s;
+    }
+
+    std::vector<std::uint32_t> to_vector(std::span<const std::uint32_t> s) { return {s.begin(), s.end()}; }
+} // namespace
+
+TEST_CASE("delimiter_index matches the scalar reference", "[delimiter_index]") {
+    ilp::delimiter_index idx(",\n");
+
+    SECTION("random CSV, many lengths") {
+        for (std::uint32_t seed = 0; seed < 40; ++seed) {
+            const std::string csv = random_csv(seed * 7 + 1, seed);
+            INFO("seed " << seed << " size " << csv.size());
+            CHECK(to_vector(idx.build(csv)) == reference_index(csv, ",\n", '"'));
+            CHECK_FALSE(idx.in_quote());
+        }
+    }
+
+    SECTION("no quote tracking") {
+        const std::string csv = random_csv(300, 99);
+        ilp::delimiter_index raw(",\n", '\0');
+        CHECK(to_vector(raw.build(csv)) == reference_index(csv, ",\n", '\0'));
+    }
+
+    SECTION("block boundaries") {
+        for (std::size_t len = 0; len < 200; ++len) {
+            std::string s(len, 'x');
+            for (std::size_t i = 0; i < len; i += 3)
+                s[i] = (i % 63 == 0) ? '"' : ',';
+            INFO("len " << len);
+            CHECK(to_vector(idx.build(s)) == reference_index(s, ",\n", '"'));
+        }
+    }
+
+    SECTION("all delimiters") {
+        const std::string s(130, ',');
+        CHECK(idx.build(s).size() == 130);
+    }
+}
+
+TEST_CASE("delimiter_index append carries quote state", "[delimiter_index][append]") {
+    const std::string csv = random_csv(500, 1234);
+    const auto expected = reference_index(csv, ",\n", '"');
+
+    for (std::size_t chunk : {1u, 7u, 64u, 100u, 4096u}) {
+        ilp::delimiter_index idx(",\n");
+        idx.build({});
+        for (std::size_t i = 0; i < csv.size(); i += chunk)
+            idx.append(std::string_view(csv).substr(i, chunk));
+        INFO("chunk " << chunk);
+        CHECK(to_vector(idx.offsets()) == expected);
+    }
+
+    SECTION("open quote at the end") {
+        ilp::delimiter_index idx(",");
+        idx.build("a,\"b,c");
+        CHECK(idx.in_quote());
+        CHECK(idx.size() == 1);
+        idx.append("d\",e");
+        CHECK(to_vector(idx.offsets()) == std::vector<std::uint32_t>{1, 8});
+    }
+}
+
+TEST_CASE("delimiter_index field extraction", "[delimiter_index][field]") {
+    const std::string_view text = "id,name,note\n1,\"Smith, J\",\"said \"\"hi\"\"\"\n2,Lee,";
+    ilp::delimiter_index idx(",\n");
+    idx.build(text);
+
+    REQUIRE(idx.size() == 8);
+    CHECK(idx.field(text, 0) == "id");
+    CHECK(idx.field(text, 2) == "note");
+    CHECK(idx.field(text, 4) == "\"Smith, J\"");
+    CHECK(idx.field(text, 5) == "\"said \"\"hi\"\"\"");
+    CHECK(idx.field(text, 7) == "Lee");
+    CHECK(idx.field(text, 8).empty());
+}
+
+TEST_CASE("swar primitives", "[swar]") {
+    using namespace ilp::swar;
+    // Exact zero bytes, including a 0x01 byte right after a zero (borrow case)
+    const std::uint64_t w = 0x0100FF0001800000ull;
+    CHECK(high_bit_mask(zero_bytes(w)) == 0b01010011u);
+    CHECK(high_bit_mask(equal_bytes(0x2C00002C2C00002Cull, broadcast(','))) == 0b10011001u);
+    CHECK(prefix_xor(0b1001000) == 0b0111000);
+    CHECK(prefix_xor(1) == ~0ull);
+    CHECK(low_mask(0) == 0);
+    CHECK(low_mask(64) == ~0ull);
+}
@@ -0,0 +1,126 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/io/file_chunks.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// ilp::file_chunks - chunked file source (io_uring when available, pread otherwise)
+
+namespace {
+    struct TempFile {
+        std::filesystem::path path;
+
+        TempFile(const std::string& name, const void* bytes, std::size_t n)
+            : path(std::filesystem::temp_directory_path() / ("ilp_for_" + name)) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(n));
+        }
+
+        ~TempFile() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    };
+
+    std::vector<std::uint32_t> iota_u32(std::size_t n) {
+        std::vector<std::uint32_t> v(n);
+        std::iota(v.begin(), v.end(), 0u);
+        return v;
+    }
+} // namespace
+
+TEST_CASE("file_chunks delivers the file in order", "[file_chunks]") {
+    // Not a multiple of the chunk size, so the last chunk is short
+    auto data = iota_u32(300007);
+    TempFile tmp("fc_order.bin", data.data(), data.size() * sizeof(std::uint32_t));
+
+    auto backend = GENERATE(ilp::io_backend::automatic, ilp::io_backend::uring, ilp::io_backend::pread);
+    auto depth = GENERATE(1u, 3u, 8u);
+
+    ilp::file_chunks<std::uint32_t, 8> in(tmp.path, 4000, depth, backend);
+    CHECK(in.chunk_capacity() == 4000);
+    CHECK(in.size() == data.size());
+    if (backend == ilp::io_backend::pread)
+        CHECK(in.backend() == ilp::io_backend::pread);
+
+    std::vector<std::uint32_t> out;
+    std::uint64_t sum = 0;
+    for (auto chunk : in) {
+        ILP_FOR_RANGE(auto v, chunk, 8) {
+            sum += v;
+        }
+        ILP_END;
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    }
+    CHECK(out == data);
+    CHECK(sum == std::uint64_t{data.size()} * (data.size() - 1) / 2);
+}
+
+#if !defined(ILP_MODE_SIMPLE)
+TEST_CASE("file_chunks early exit cancels outstanding reads", "[file_chunks][cancel]") {
+    auto data = iota_u32(1u << 20);
+    data[123456] = 0xFFFFFFFFu;
+    TempFile tmp("fc_cancel.bin", data.data(), data.size() * sizeof(std::uint32_t));
+
+    auto backend = GENERATE(ilp::io_backend::uring, ilp::io_backend::pread);
+    auto find = [&]() -> std::size_t {
+        ilp::file_chunks<std::uint32_t> in(tmp.path, 16384, 16, backend);
+        std::size_t base = 0;
+        for (auto chunk : in) {
+            ILP_FOR(auto i, std::size_t{0}, chunk.size(), 4) {
+                if (chunk[i] == 0xFFFFFFFFu)
+                    ILP_RETURN(base + i);
+            }
+            ILP_END_RETURN;
+            base += chunk.size();
+        }
+        return base;
+    };
+    // Returning destroys the source with reads still queued; the next run reuses the file
+    CHECK(find() == 123456);
+    CHECK(find() == 123456);
+}
+#endif
+
+TEST_CASE("file_chunks edge cases", "[file_chunks][edge]") {
+    SECTION("empty file") {
+        TempFile tmp("fc_empty.bin", "", 0);
+        ilp::file_chunks<char> in(tmp.path);
+        CHECK(in.next().empty());
+        CHECK(in.next().empty());
+    }
+
+    SECTION("trailing partial element is dropped") {
+        const char bytes[10] = {1, 0, 0, 0, 2, 0, 0, 0, 9, 9};
+        TempFile tmp("fc_tail.bin", bytes, sizeof(bytes));
+        ilp::file_chunks<std::uint32_t, 4> in(tmp.path, 4);
+        auto chunk = in.next();
+        REQUIRE(chunk.size() == 2);
+        CHECK(chunk[0] == 1u);
+        CHECK(chunk[1] == 2u);
+        CHECK(in.next().empty());
+    }
+
+    SECTION("stop ends iteration") {
+        auto data = iota_u32(100000);
+        TempFile tmp("fc_stop.bin", data.data(), data.size() * sizeof(std::uint32_t));
+        ilp::file_chunks<std::uint32_t> in(tmp.path, 1024, 8);
+        CHECK_FALSE(in.next().empty());
+        in.stop();
+        CHECK(in.next().empty());
+    }
+
+    SECTION("missing file throws") {
+        CHECK_THROWS_AS(ilp::file_chunks<char>(std::filesystem::temp_directory_path() / "ilp_for_no_such_file"),
+                        std::system_error);
+    }
+}
+
+#endif // POSIX
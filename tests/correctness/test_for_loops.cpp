@@ -1,5 +1,7 @@
 #include "../../ilp_for.hpp"
 #include "catch.hpp"
+#include <algorithm>
+#include <bit>
 #include <vector>
 
 // Basic ILP_FOR tests - works in all modes including SUPER_SIMPLE
@@ -175,6 +177,89 @@ TEST_CASE("ILP_FOR_RANGE_AUTO basic", "[for_range_auto][basic]") {
         ILP_END;
         REQUIRE(sum == 150);
     }
+
+    SECTION("popcount and gather loop types") {
+        std::vector<unsigned> data = {0x1u, 0x3u, 0x7u, 0xFFu};
+        std::vector<std::size_t> idx = {3, 0, 3, 1};
+        int bits = 0;
+        ILP_FOR_RANGE_AUTO(auto val, data, Popcount, unsigned) {
+            bits += std::popcount(val);
+        }
+        ILP_END;
+        REQUIRE(bits == 14);
+
+        unsigned picked = 0;
+        ILP_FOR_RANGE_AUTO(auto i, idx, Gather, unsigned) {
+            picked += data[i];
+        }
+        ILP_END;
+        REQUIRE(picked == 0x1u + 0xFFu * 2 + 0x3u);
+    }
+}
+
+namespace {
+    struct PairAdd {
+        static constexpr ilp::LoopCost cost(const ilp::cpu::Profile&) {
+            return {.latency = 3, .per_cycle = 2, .live_per_lane = 2, .vector = false};
+        }
+    };
+} // namespace
+
+ILP_REGISTER_LOOP_TYPE(PairAdd, PairAdd)
+
+TEST_CASE("ILP_FOR_AUTO with a registered custom loop type", "[for_auto][custom]") {
+    SECTION("index loop") {
+        long lo = 0;
+        long hi = 0;
+        ILP_FOR_AUTO(auto i, 0, 100, PairAdd, long) {
+            lo += i;
+            hi += 2 * i;
+        }
+        ILP_END;
+        REQUIRE(lo == 4950);
+        REQUIRE(hi == 9900);
+    }
+
+    SECTION("mixed with a built-in type") {
+        std::vector<long> data = {5, 1, 4, 2, 3};
+        long sum = 0;
+        long best = data[0];
+        ILP_FOR_RANGE_MIX_AUTO(auto val, data, long, PairAdd, MinMax) {
+            sum += val;
+            best = std::max(best, val);
+        }
+        ILP_END;
+        REQUIRE(sum == 15);
+        REQUIRE(best == 5);
+    }
+}
+
+TEST_CASE("ILP_FOR_MIX_AUTO basic", "[for_mix_auto][basic]") {
+    SECTION("sum and min in one body") {
+        std::vector<float> data = {4.0f, -2.0f, 7.5f, 1.0f, 3.5f};
+        float sum = 0.0f;
+        float lo = data[0];
+        ILP_FOR_MIX_AUTO(auto i, std::size_t{0}, data.size(), float, Sum, MinMax) {
+            sum += data[i];
+            lo = std::min(lo, data[i]);
+        }
+        ILP_END;
+        REQUIRE(sum == 14.0f);
+        REQUIRE(lo == -2.0f);
+    }
+
+    SECTION("range with four loop types") {
+        std::vector<unsigned> data = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        unsigned sum = 0;
+        unsigned bits = 0;
+        ILP_FOR_RANGE_MIX_AUTO(auto val, data, unsigned, Sum, Bitwise, Shift, MinMax) {
+            sum += val;
+            bits |= 1u << val;
+        }
+        ILP_END;
+        REQUIRE(sum == 45);
+        REQUIRE(bits == 0x3FEu);
+    }
 }
 
 // Test ILP_RETURN only in non-SUPER_SIMPLE modes (different semantics)
@@ -261,6 +346,42 @@ TEST_CASE("ILP_FOR_T_AUTO basic", "[for_t_auto][basic]") {
     }
 }
 
+TEST_CASE("ILP_FOR_T_MIX_AUTO basic", "[for_t_mix_auto][basic]") {
+    SECTION("search that also accumulates") {
+        std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
+        auto running_total_past = [&](int limit) -> int {
+            int total = 0;
+            ILP_FOR_T_MIX_AUTO(int, auto i, std::size_t{0}, data.size(), int, Search, Sum) {
+                total += data[i];
+                if (total > limit)
+                    ILP_RETURN(static_cast<int>(i));
+            }
+            ILP_END_RETURN;
+            return -1;
+        };
+        REQUIRE(running_total_past(0) == 0);
+        REQUIRE(running_total_past(100) == -1);
+    }
+}
+
+TEST_CASE("ILP_FOR_RANGE_T_MIX_AUTO basic", "[for_range_t_mix_auto][basic]") {
+    SECTION("typed return from a mixed range body") {
+        auto first_over = [](const std::vector<int>& data, int target) -> int {
+            int hi = data[0];
+            ILP_FOR_RANGE_T_MIX_AUTO(int, auto val, data, int, Search, MinMax) {
+                hi = std::max(hi, val);
+                if (val > target)
+                    ILP_RETURN(hi);
+            }
+            ILP_END_RETURN;
+            return -1;
+        };
+        std::vector<int> data = {10, 20, 30, 40, 50};
+        REQUIRE(first_over(data, 25) == 30);
+        REQUIRE(first_over(data, 99) == -1);
+    }
+}
+
 TEST_CASE("ILP_FOR_RANGE_T_AUTO basic", "[for_range_t_auto][basic]") {
     SECTION("typed return with auto N and range") {
         auto find_triple = [](const std::vector<int>& data, int target) -> int {
@@ -0,0 +1,92 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/cpu_profiles/ilp_topology.hpp"
+#include "catch.hpp"
+#include <numeric>
+#include <vector>
+
+TEST_CASE("parse_cpu_list reads sysfs CPU lists") {
+    using ilp::cpu::detail::parse_cpu_list;
+    SECTION("Ranges and single CPUs") {
+        const auto cpus = parse_cpu_list("0-2,5,7-8\n");
+        REQUIRE(cpus.size() == 9);
+        CHECK(cpus == std::vector<bool>{true, true, true, false, false, true, false, true, true});
+    }
+    SECTION("Empty and malformed lists give an empty mask") {
+        CHECK(parse_cpu_list("").empty());
+        CHECK(parse_cpu_list("\n").empty());
+        CHECK(parse_cpu_list("cpu0").empty());
+        CHECK(parse_cpu_list("4-2").empty());
+    }
+}
+
+TEST_CASE("efficiency_cores pairs hybrid parts with their E-core profile") {
+    using ilp::LoopType;
+    CHECK(ilp::cpu::efficiency_cores(ilp::cpu::alderlake) == &ilp::cpu::gracemont);
+    CHECK(ilp::cpu::efficiency_cores(ilp::cpu::skylake) == nullptr);
+    CHECK(ilp::cpu::efficiency_cores(ilp::cpu::gracemont) == nullptr);
+    CHECK(&ilp::cpu::get("gracemont") == &ilp::cpu::gracemont);
+
+    SECTION("Gracemont's 128-bit pipes want fewer chains than Golden Cove") {
+        CHECK(ilp::cpu::gracemont.sum_4f < ilp::cpu::alderlake.sum_4f);
+        CHECK(ilp::cpu::gracemont.dotproduct_4 < ilp::cpu::alderlake.dotproduct_4);
+        CHECK(ilp::cpu::gracemont.bitwise_4 < ilp::cpu::alderlake.bitwise_4);
+    }
+    SECTION("optimal_N_on reads the named profile") {
+        CHECK(ilp::optimal_N_on<ilp::cpu::gracemont, float, LoopType::Sum> ==
+              std::size_t(ilp::cpu::gracemont.sum_4f));
+        CHECK(ilp::optimal_N_on<ilp::cpu::alderlake, double, LoopType::DotProduct> ==
+              std::size_t(ilp::cpu::alderlake.dotproduct_8));
+        CHECK(ilp::optimal_N_on<ILP_CPU_PROFILE, int, LoopType::Search, LoopType::Sum> ==
+              ilp::optimal_N_for<int, LoopType::Search, LoopType::Sum>);
+    }
+    SECTION("efficiency_N_for is 0 unless the selected CPU is hybrid") {
+        constexpr const ilp::cpu::Profile* e = ilp::cpu::efficiency_cores(ILP_CPU_PROFILE);
+        CHECK(ilp::detail::efficiency_N_for<float, LoopType::Sum> == (e ? std::size_t(e->sum_4f) : 0));
+    }
+}
+
+TEST_CASE("current_core_type is cached per thread and detected again on another CPU") {
+    using ilp::cpu::CoreType;
+    auto& cache = ilp::cpu::detail::thread_core_type();
+    const CoreType first = ilp::cpu::current_core_type();
+    CHECK(cache.cpu == ilp::cpu::detail::current_cpu());
+
+    // As if the last detection was made on a CPU the thread has since left
+    cache.cpu = -3;
+    cache.type = first == CoreType::Performance ? CoreType::Efficiency : CoreType::Performance;
+    ilp::cpu::current_core_type();
+    CHECK(cache.cpu != -3);
+
+    // A uniform part has no E-cores
+    if (ilp::cpu::detail::sysfs_atom_cpus().empty()) {
+        CoreType type = CoreType::Performance;
+        if (!ilp::cpu::detail::cpuid_core_type(type))
+            CHECK(ilp::cpu::current_core_type() == CoreType::Performance);
+    }
+}
+
+#ifdef ILP_HYBRID_CORES
+TEST_CASE("_AUTO loops take the E-core N on an E-core") {
+    std::vector<int> data(1000);
+    std::iota(data.begin(), data.end(), 1);
+    const int expected = 500500;
+
+    auto sum = [&] {
+        int total = 0;
+        ILP_FOR_RANGE_AUTO(auto&& x, data, Sum, int) {
+            total += x;
+        }
+        ILP_END;
+        return total;
+    };
+
+    // Seed this thread's cache with each core type for the CPU it is on; a migration between
+    // here and the loop only means the other instantiation runs, which must agree
+    auto& cache = ilp::cpu::detail::thread_core_type();
+    for (auto type : {ilp::cpu::CoreType::Efficiency, ilp::cpu::CoreType::Performance}) {
+        cache.cpu = ilp::cpu::detail::current_cpu();
+        cache.type = type;
+        CHECK(sum() == expected);
+    }
+}
+#endif
@@ -0,0 +1,149 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/io/mapped_file.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// ilp::mapped_file - mmap-backed range source for the range macros
+
+static_assert(std::ranges::random_access_range<ilp::mapped_file<std::uint32_t>&>);
+static_assert(std::ranges::sized_range<ilp::mapped_file<std::uint32_t>&>);
+static_assert(std::random_access_iterator<ilp::mapped_file<std::uint64_t>::iterator>);
+
+namespace {
+    // Writes bytes to a unique temp file, removed on scope exit
+    struct TempFile {
+        std::filesystem::path path;
+
+        TempFile(const std::string& name, const void* bytes, std::size_t n)
+            : path(std::filesystem::temp_directory_path() / ("ilp_for_" + name)) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(n));
+        }
+
+        ~TempFile() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    };
+
+    std::vector<std::uint32_t> iota_u32(std::size_t n) {
+        std::vector<std::uint32_t> v(n);
+        std::iota(v.begin(), v.end(), 0u);
+        return v;
+    }
+} // namespace
+
+TEST_CASE("mapped_file with ILP_FOR_RANGE", "[mapped_file]") {
+    // 1 MB of data with a one-page window: the scan crosses ~256 windows
+    auto data = iota_u32(1u << 18);
+    TempFile tmp("mf_sum.bin", data.data(), data.size() * sizeof(std::uint32_t));
+    ilp::mapped_file<std::uint32_t> file(tmp.path, 4096);
+
+    REQUIRE(file.size() == data.size());
+    REQUIRE(file.size_bytes() == data.size() * sizeof(std::uint32_t));
+
+    SECTION("full scan") {
+        std::uint64_t sum = 0;
+        ILP_FOR_RANGE(auto v, file, 8) {
+            sum += v;
+        }
+        ILP_END;
+        CHECK(sum == std::uint64_t{data.size()} * (data.size() - 1) / 2);
+    }
+
+    SECTION("auto N") {
+        std::uint64_t sum = 0;
+        ILP_FOR_RANGE_AUTO(auto v, file, Sum, std::uint32_t) {
+            sum += v;
+        }
+        ILP_END;
+        CHECK(sum == std::uint64_t{data.size()} * (data.size() - 1) / 2);
+    }
+
+    SECTION("early exit") {
+        std::size_t seen = 0;
+        ILP_FOR_RANGE(auto v, file, 4) {
+            if (v == 5000)
+                ILP_BREAK;
+            ++seen;
+        }
+        ILP_END;
+        CHECK(seen == 5000);
+    }
+
+    SECTION("backwards access after release") {
+        std::uint64_t sum = 0;
+        ILP_FOR_RANGE(auto v, file, 4) {
+            sum += v;
+        }
+        ILP_END;
+        // Pages behind the cursor were dropped; they fault back in unchanged
+        CHECK(file.begin()[0] == 0u);
+        CHECK(file.begin()[12345] == 12345u);
+    }
+}
+
+#if !defined(ILP_MODE_SIMPLE)
+TEST_CASE("mapped_file with ILP_RETURN", "[mapped_file][return]") {
+    auto data = iota_u32(100000);
+    data[70001] = 0xFFFFFFFFu;
+    TempFile tmp("mf_find.bin", data.data(), data.size() * sizeof(std::uint32_t));
+    ilp::mapped_file<std::uint32_t> file(tmp.path, 4096);
+
+    auto find = [&](std::uint32_t needle) -> std::size_t {
+        ILP_FOR(auto i, std::size_t{0}, file.size(), 4) {
+            if (file.begin()[static_cast<std::ptrdiff_t>(i)] == needle)
+                ILP_RETURN(i);
+        }
+        ILP_END_RETURN;
+        return file.size();
+    };
+    CHECK(find(0xFFFFFFFFu) == 70001);
+    CHECK(find(0xFFFFFFFEu) == file.size());
+}
+#endif
+
+TEST_CASE("mapped_file edge cases", "[mapped_file][edge]") {
+    SECTION("empty file") {
+        TempFile tmp("mf_empty.bin", "", 0);
+        ilp::mapped_file<std::uint64_t> file(tmp.path);
+        CHECK(file.empty());
+        int count = 0;
+        ILP_FOR_RANGE([[maybe_unused]] auto v, file, 4) {
+            ++count;
+        }
+        ILP_END;
+        CHECK(count == 0);
+    }
+
+    SECTION("trailing partial element is excluded") {
+        const char bytes[11] = {1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0};
+        TempFile tmp("mf_tail.bin", bytes, sizeof(bytes));
+        ilp::mapped_file<std::uint32_t> file(tmp.path);
+        CHECK(file.size() == 2);
+        CHECK(file.size_bytes() == 11);
+    }
+
+    SECTION("missing file throws") {
+        CHECK_THROWS_AS(ilp::mapped_file<char>(std::filesystem::temp_directory_path() / "ilp_for_no_such_file"),
+                        std::system_error);
+    }
+
+    SECTION("move keeps the mapping") {
+        auto data = iota_u32(3000);
+        TempFile tmp("mf_move.bin", data.data(), data.size() * sizeof(std::uint32_t));
+        ilp::mapped_file<std::uint32_t> a(tmp.path, 4096);
+        ilp::mapped_file<std::uint32_t> b(std::move(a));
+        std::uint64_t sum = 0;
+        for (auto v : b)
+            sum += v;
+        CHECK(sum == 3000ull * 2999 / 2);
+    }
+}
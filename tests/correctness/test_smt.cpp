@@ -0,0 +1,107 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/cpu_profiles/ilp_topology.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("shared_core halves the port-bound fields") {
+    constexpr ilp::cpu::Profile shared = ilp::cpu::shared_core(ilp::cpu::skylake);
+    SECTION("Port-bound loop types need half the chains") {
+        CHECK(shared.sum_4f == ilp::cpu::skylake.sum_4f / 2);
+        CHECK(shared.dotproduct_8 == ilp::cpu::skylake.dotproduct_8 / 2);
+        CHECK(shared.bitwise_4 == (ilp::cpu::skylake.bitwise_4 + 1) / 2);
+        CHECK(shared.scan_8f == ilp::cpu::skylake.scan_8f / 2);
+    }
+    SECTION("Memory-bound types and registers are untouched") {
+        CHECK(shared.copy_1 == ilp::cpu::skylake.copy_1);
+        CHECK(shared.transform_4 == ilp::cpu::skylake.transform_4);
+        CHECK(shared.gpr_registers == ilp::cpu::skylake.gpr_registers);
+        CHECK(shared.vector_registers == ilp::cpu::skylake.vector_registers);
+    }
+    SECTION("N never drops below one chain") {
+        constexpr ilp::cpu::Profile twice = ilp::cpu::shared_core(shared);
+        constexpr ilp::cpu::Profile thrice = ilp::cpu::shared_core(twice);
+        CHECK(thrice.divide_8f == 1);
+        CHECK(thrice.sum_1 >= 1);
+    }
+    SECTION("shared_core_N_for reads the shared profile") {
+        using ilp::LoopType;
+        constexpr ilp::cpu::Profile active = ilp::cpu::shared_core(ILP_CPU_PROFILE);
+        CHECK(ilp::detail::shared_core_N_for<float, LoopType::Sum> == std::size_t(active.sum_4f));
+        CHECK(ilp::detail::shared_core_N_for<std::uint32_t, LoopType::Bitwise> == std::size_t(active.bitwise_4));
+        CHECK(ilp::detail::shared_core_N_for<float, LoopType::Sum> <= ilp::optimal_N_for<float, LoopType::Sum>);
+    }
+}
+
+TEST_CASE("parse_proc_stat_line reads per-CPU jiffies") {
+    using ilp::cpu::detail::parse_proc_stat_line;
+    int cpu = -1;
+    unsigned long long busy = 0, total = 0;
+    SECTION("A CPU line") {
+        REQUIRE(parse_proc_stat_line("cpu12 100 5 50 800 20 3 2 0 0 0", cpu, busy, total));
+        CHECK(cpu == 12);
+        CHECK(total == 980);
+        CHECK(busy == 160);
+    }
+    SECTION("The aggregate line and other lines are skipped") {
+        CHECK_FALSE(parse_proc_stat_line("cpu  100 5 50 800 20 3 2 0 0 0", cpu, busy, total));
+        CHECK_FALSE(parse_proc_stat_line("intr 12345 0 0", cpu, busy, total));
+        CHECK_FALSE(parse_proc_stat_line("cpu3 100 5", cpu, busy, total));
+        CHECK_FALSE(parse_proc_stat_line("", cpu, busy, total));
+    }
+}
+
+TEST_CASE("core_is_shared follows the SMT policy") {
+    using ilp::cpu::SmtPolicy;
+    const SmtPolicy before = ilp::cpu::smt_policy();
+    CHECK(before == SmtPolicy::SharedCore);
+
+    ilp::cpu::set_smt_policy(SmtPolicy::FullCore);
+    CHECK_FALSE(ilp::cpu::core_is_shared());
+
+    // Without SMT there is never a sibling to share with
+    bool any_siblings = false;
+    for (const auto& s : ilp::cpu::detail::smt_siblings())
+        any_siblings |= !s.empty();
+    for (auto policy : {SmtPolicy::SharedCore, SmtPolicy::SiblingLoad}) {
+        ilp::cpu::set_smt_policy(policy);
+        const bool shared = ilp::cpu::core_is_shared();
+        if (!any_siblings)
+            CHECK_FALSE(shared);
+    }
+
+    ilp::cpu::set_smt_policy(before);
+}
+
+TEST_CASE("Sibling lists leave the CPU itself out") {
+    const auto& siblings = ilp::cpu::detail::smt_siblings();
+    for (std::size_t cpu = 0; cpu < siblings.size(); ++cpu)
+        for (int other : siblings[cpu])
+            CHECK(static_cast<std::size_t>(other) != cpu);
+}
+
+#ifdef ILP_SMT_AWARE
+TEST_CASE("_AUTO loops agree under every SMT policy") {
+    std::vector<std::uint32_t> data(1000);
+    std::iota(data.begin(), data.end(), 1u);
+
+    const ilp::cpu::SmtPolicy before = ilp::cpu::smt_policy();
+    for (auto policy : {ilp::cpu::SmtPolicy::FullCore, ilp::cpu::SmtPolicy::SharedCore,
+                        ilp::cpu::SmtPolicy::SiblingLoad}) {
+        ilp::cpu::set_smt_policy(policy);
+        std::uint32_t sum = 0, bits = 0;
+        ILP_FOR_RANGE_AUTO(auto x, data, Sum, std::uint32_t) {
+            sum += x;
+        }
+        ILP_END;
+        ILP_FOR_RANGE_AUTO(auto x, data, Bitwise, std::uint32_t) {
+            bits |= x;
+        }
+        ILP_END;
+        CHECK(sum == 500500u);
+        CHECK(bits == 1023u);
+    }
+    ilp::cpu::set_smt_policy(before);
+}
+#endif
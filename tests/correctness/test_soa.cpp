@@ -0,0 +1,139 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/memory/soa_vector.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    struct Order {
+        double price = 0;
+        std::int32_t qty = 0;
+        std::uint64_t id = 0;
+        char venue[40] = {};
+    };
+
+    using Orders = ilp::soa_vector<ilp::field<"price", double>, ilp::field<"qty", std::int32_t>,
+                                   ilp::field<"id", std::uint64_t>>;
+
+    Orders make_orders(std::size_t n) {
+        Orders orders;
+        for (std::size_t i = 0; i < n; ++i)
+            orders.push_back(1.0 + static_cast<double>(i), static_cast<std::int32_t>(i % 7), 1000 + i);
+        return orders;
+    }
+
+} // namespace
+
+TEST_CASE("ILP_FOR_SOA declarations name their columns") {
+    using ilp::detail::soa_decl_count;
+    using ilp::detail::soa_decl_name;
+    constexpr std::string_view decls = "(const auto& price, auto&& qty, std::uint64_t id)";
+    STATIC_REQUIRE(soa_decl_count(decls) == 3);
+    STATIC_REQUIRE(soa_decl_name(decls, 0) == "price");
+    STATIC_REQUIRE(soa_decl_name(decls, 1) == "qty");
+    STATIC_REQUIRE(soa_decl_name(decls, 2) == "id");
+    STATIC_REQUIRE(soa_decl_name("(auto x)", 0) == "x");
+    STATIC_REQUIRE(Orders::column_index("qty") == 1);
+    STATIC_REQUIRE(Orders::column_index("venue") == Orders::columns);
+}
+
+TEST_CASE("soa_vector stores each field as an aligned column") {
+    Orders orders = make_orders(100);
+    CHECK(orders.size() == 100);
+    CHECK(orders.column<"qty">().size() == 100);
+    CHECK(reinterpret_cast<std::uintptr_t>(orders.column<"price">().data()) % ilp::arch::cache_line == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(orders.column<2>().data()) % ilp::arch::cache_line == 0);
+    CHECK(&orders.column<"id">() == &orders.column<2>());
+
+    auto [price, qty, id] = orders.row(10);
+    CHECK(price == 11.0);
+    CHECK(qty == 3);
+    id = 7;
+    CHECK(orders.column<"id">()[10] == 7u);
+
+    orders.resize(20);
+    CHECK(orders.column<1>().size() == 20);
+    orders.clear();
+    CHECK(orders.empty());
+}
+
+TEST_CASE("ILP_FOR_SOA") {
+    Orders orders = make_orders(1001);
+
+    SECTION("Reads only the named columns, in declaration order") {
+        double notional = 0;
+        ILP_FOR_SOA((std::int32_t qty, double price), orders, 8) {
+            notional += price * qty;
+        }
+        ILP_END;
+        double expected = 0;
+        for (std::size_t i = 0; i < orders.size(); ++i)
+            expected += orders.column<"price">()[i] * orders.column<"qty">()[i];
+        CHECK(notional == expected);
+    }
+
+    SECTION("References write through to the column") {
+        ILP_FOR_SOA((auto& qty), orders, 4) {
+            qty *= 2;
+        }
+        ILP_END;
+        CHECK(orders.column<"qty">()[6] == 12);
+    }
+
+    SECTION("Continue and break") {
+        std::size_t visited = 0;
+        ILP_FOR_SOA((auto price, auto qty), orders, 4) {
+            if (qty == 0)
+                ILP_CONTINUE;
+            if (price > 500.0)
+                ILP_BREAK;
+            ++visited;
+        }
+        ILP_END;
+        CHECK(visited == 428);
+    }
+
+    SECTION("Return") {
+        auto find_id = [&](double at_least) -> std::uint64_t {
+            ILP_FOR_SOA((auto id, auto price), orders, 8) {
+                if (price >= at_least)
+                    ILP_RETURN(id);
+            }
+            ILP_END_RETURN;
+            return 0;
+        };
+        CHECK(find_id(250.0) == 1249u);
+        CHECK(find_id(1e9) == 0u);
+    }
+
+    SECTION("Const soa_vector") {
+        const Orders& view = orders;
+        std::uint64_t ids = 0;
+        ILP_FOR_SOA((const auto& id), view, 4) {
+            ids += id;
+        }
+        ILP_END;
+        CHECK(ids == 1001u * 1000u + 1000u * 1001u / 2);
+    }
+}
+
+TEST_CASE("AoS and SoA conversion") {
+    std::vector<Order> aos(37);
+    for (std::size_t i = 0; i < aos.size(); ++i)
+        aos[i] = Order{0.5 * static_cast<double>(i), static_cast<std::int32_t>(i), 9u * i, {}};
+
+    Orders soa = ilp::to_soa<Orders>(aos, &Order::price, &Order::qty, &Order::id);
+    REQUIRE(soa.size() == aos.size());
+    CHECK(soa.column<"price">()[36] == 18.0);
+    CHECK(soa.column<"id">()[4] == 36u);
+
+    std::vector<Order> back = ilp::to_aos<Order>(soa, &Order::price, &Order::qty, &Order::id);
+    REQUIRE(back.size() == aos.size());
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        CHECK(back[i].price == aos[i].price);
+        CHECK(back[i].qty == aos[i].qty);
+        CHECK(back[i].id == aos[i].id);
+    }
+}
@@ -0,0 +1,143 @@
+#include "../../ilp_for.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+    template<ilp::StoreMode Mode>
+    std::vector<float> doubled(const std::vector<float>& src, std::size_t offset) {
+        std::vector<float> buf(src.size() + offset, -1.0f);
+        std::span<float> dst(buf.data() + offset, src.size());
+        (void)ilp::for_loop_range_store<8, Mode>(src, dst, [](float x, float& out, ilp::ForCtrl&) { out = x * 2.0f; });
+        return {dst.begin(), dst.end()};
+    }
+
+} // namespace
+
+TEST_CASE("for_loop_range_store writes the same output with every store mode") {
+    std::vector<float> src(1037);
+    std::iota(src.begin(), src.end(), 0.0f);
+    std::vector<float> expected(src.size());
+    for (std::size_t i = 0; i < src.size(); ++i)
+        expected[i] = src[i] * 2.0f;
+
+    // Offsets put the output off a cache line boundary so the head runs before the streamed lines
+    for (std::size_t offset : {0u, 1u, 5u, 15u}) {
+        CHECK(doubled<ilp::StoreMode::Cached>(src, offset) == expected);
+        CHECK(doubled<ilp::StoreMode::Streaming>(src, offset) == expected);
+        CHECK(doubled<ilp::StoreMode::Auto>(src, offset) == expected);
+    }
+
+    SECTION("Shorter than one streamed block") {
+        std::vector<float> few = {1.0f, 2.0f, 3.0f};
+        CHECK(doubled<ilp::StoreMode::Streaming>(few, 0) == std::vector<float>{2.0f, 4.0f, 6.0f});
+    }
+}
+
+TEST_CASE("for_loop_range_store stops at early exit with the breaking element written") {
+    std::vector<std::uint32_t> src(1000);
+    std::iota(src.begin(), src.end(), 0u);
+    for (std::size_t stop : {3u, 64u, 517u}) {
+        std::vector<std::uint32_t> dst(src.size(), 7u);
+        auto r = ilp::for_loop_range_store<4, ilp::StoreMode::Streaming>(
+            src, dst, [&](std::uint32_t x, std::uint32_t& out, ilp::ForCtrl& ctrl) {
+                out = x + 1;
+                if (x == stop)
+                    ctrl.ok = false;
+            });
+        CHECK_FALSE(r.has_return);
+        for (std::size_t i = 0; i <= stop; ++i)
+            CHECK(dst[i] == i + 1);
+        for (std::size_t i = stop + 1; i < dst.size(); ++i)
+            CHECK(dst[i] == 7u);
+    }
+}
+
+TEST_CASE("for_loop_range_store falls back to regular stores") {
+    SECTION("Output that isn't trivially copyable") {
+        std::vector<int> src = {1, 2, 3, 4, 5};
+        std::vector<std::string> dst(src.size());
+        (void)ilp::for_loop_range_store<2, ilp::StoreMode::Streaming>(
+            src, dst, [](int x, std::string& out, ilp::ForCtrl&) { out = std::to_string(x); });
+        CHECK(dst == std::vector<std::string>{"1", "2", "3", "4", "5"});
+    }
+    SECTION("Output that isn't contiguous") {
+        std::vector<int> src(100);
+        std::iota(src.begin(), src.end(), 0);
+        std::deque<long> dst(src.size());
+        (void)ilp::for_loop_range_store<4, ilp::StoreMode::Streaming>(
+            src, dst, [](int x, long& out, ilp::ForCtrl&) { out = -x; });
+        CHECK(dst[0] == 0);
+        CHECK(dst[99] == -99);
+    }
+}
+
+TEST_CASE("ILP_FOR_RANGE_STORE") {
+    std::vector<int> src(100);
+    std::iota(src.begin(), src.end(), 0);
+
+    SECTION("Transform") {
+        std::vector<int> dst(src.size());
+        ILP_FOR_RANGE_STORE(auto x, auto& out, src, dst, 4) {
+            out = x * 3;
+        }
+        ILP_END;
+        CHECK(dst[10] == 30);
+        CHECK(dst[99] == 297);
+    }
+
+    SECTION("Skipped elements are written as T{}") {
+        std::vector<int> dst(src.size(), -1);
+        ILP_FOR_RANGE_STORE(auto x, auto& out, src, dst, 4) {
+            if (x % 2)
+                ILP_CONTINUE;
+            out = x;
+        }
+        ILP_END;
+        CHECK(dst[4] == 4);
+        CHECK(dst[5] == 0);
+    }
+
+    SECTION("Break") {
+        std::vector<int> dst(src.size(), -1);
+        ILP_FOR_RANGE_STORE(auto x, auto& out, src, dst, 4) {
+            out = x;
+            if (x == 41)
+                ILP_BREAK;
+        }
+        ILP_END;
+        CHECK(dst[41] == 41);
+        CHECK(dst[42] == -1);
+    }
+
+    SECTION("Return") {
+        std::vector<int> dst(src.size());
+        auto first_negative = [&]() -> std::size_t {
+            std::vector<int> input = {4, 9, -2, 7};
+            ILP_FOR_RANGE_STORE(auto&& x, auto& out, input, dst, 4) {
+                if (x < 0)
+                    ILP_RETURN(static_cast<std::size_t>(&x - input.data()));
+                out = x;
+            }
+            ILP_END_RETURN;
+            return input.size();
+        };
+        CHECK(first_negative() == 2);
+        CHECK(dst[1] == 9);
+    }
+
+    SECTION("AUTO") {
+        std::vector<int> dst(src.size());
+        ILP_FOR_RANGE_STORE_AUTO(auto x, auto& out, src, dst, Transform, int) {
+            out = x + 1;
+        }
+        ILP_END;
+        CHECK(dst[0] == 1);
+        CHECK(dst[99] == 100);
+    }
+}
@@ -0,0 +1,181 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/io/stream_chunks.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// ilp::stream_chunks - double-buffered chunks from a file descriptor
+
+namespace {
+    // Writes bytes into a pipe in random-sized pieces from another thread
+    struct PipeWriter {
+        int fds[2] = {-1, -1};
+        std::thread writer;
+
+        explicit PipeWriter(std::string bytes) {
+            REQUIRE(::pipe(fds) == 0);
+            writer = std::thread([this, bytes = std::move(bytes)] {
+                std::mt19937 rng(7);
+                std::size_t off = 0;
+                while (off < bytes.size()) {
+                    std::size_t n = std::min<std::size_t>(bytes.size() - off, 1 + rng() % 5000);
+                    ssize_t w = ::write(fds[1], bytes.data() + off, n);
+                    if (w <= 0)
+                        break;
+                    off += static_cast<std::size_t>(w);
+                }
+                ::close(fds[1]);
+            });
+        }
+
+        int read_fd() const { return fds[0]; }
+
+        ~PipeWriter() {
+            writer.join();
+            ::close(fds[0]);
+        }
+    };
+
+    std::string make_lines(std::size_t count) {
+        std::mt19937 rng(42);
+        std::string text;
+        for (std::size_t i = 0; i < count; ++i) {
+            text.append(1 + rng() % 120, static_cast<char>('a' + i % 26));
+            text.push_back('\n');
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("stream_chunks delivers the whole stream", "[stream_chunks]") {
+    std::string input(1 << 20, '\0');
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<char>(i * 31 + 7);
+
+    PipeWriter w(input);
+    ilp::stream_chunks<char, 8> in(w.read_fd(), 4000);
+    CHECK(in.chunk_capacity() == 4000);
+
+    std::string out;
+    std::uint64_t sum = 0;
+    for (auto chunk : in) {
+        CHECK(chunk.size() <= in.chunk_capacity());
+        ILP_FOR_RANGE(auto c, chunk, 8) {
+            sum += static_cast<unsigned char>(c);
+        }
+        ILP_END;
+        out.append(chunk.data(), chunk.size());
+    }
+
+    std::uint64_t expected = 0;
+    for (char c : input)
+        expected += static_cast<unsigned char>(c);
+    CHECK(out == input);
+    CHECK(sum == expected);
+}
+
+TEST_CASE("stream_chunks carries records across chunks", "[stream_chunks][delimiter]") {
+    const std::string input = make_lines(20000);
+    PipeWriter w(input);
+    ilp::stream_chunks<char> in(w.read_fd(), 1000, '\n');
+
+    std::string out;
+    std::size_t lines = 0;
+    for (auto chunk : in) {
+        REQUIRE_FALSE(chunk.empty());
+        CHECK(chunk.back() == '\n');
+        ILP_FOR_RANGE(auto c, chunk, 8) {
+            if (c == '\n')
+                ++lines;
+        }
+        ILP_END;
+        out.append(chunk.data(), chunk.size());
+    }
+    CHECK(lines == 20000);
+    CHECK(out == input);
+}
+
+TEST_CASE("stream_chunks edge cases", "[stream_chunks][edge]") {
+    SECTION("empty input") {
+        PipeWriter w("");
+        ilp::stream_chunks<char> in(w.read_fd());
+        CHECK(in.next().empty());
+        CHECK(in.next().empty());
+    }
+
+    SECTION("final record without delimiter") {
+        PipeWriter w("one\ntwo\nthree");
+        ilp::stream_chunks<char> in(w.read_fd(), 16, '\n');
+        std::string out;
+        for (auto chunk : in)
+            out.append(chunk.data(), chunk.size());
+        CHECK(out == "one\ntwo\nthree");
+    }
+
+    SECTION("elements split across reads") {
+        std::vector<std::uint32_t> values(10000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<std::uint32_t>(i * 2654435761u);
+        PipeWriter w(std::string(reinterpret_cast<const char*>(values.data()), values.size() * 4));
+        ilp::stream_chunks<std::uint32_t, 4> in(w.read_fd(), 1001);
+        CHECK(in.chunk_capacity() == 1004);
+
+        std::vector<std::uint32_t> out;
+        for (auto chunk : in)
+            out.insert(out.end(), chunk.begin(), chunk.end());
+        CHECK(out == values);
+    }
+
+    SECTION("read error is reported") {
+        int dir = ::open(std::filesystem::temp_directory_path().c_str(), O_RDONLY);
+        REQUIRE(dir >= 0);
+        {
+            ilp::stream_chunks<char> in(dir);
+            CHECK_THROWS_AS(in.next(), std::system_error);
+        }
+        ::close(dir);
+    }
+
+    SECTION("invalid fd") {
+        CHECK_THROWS_AS(ilp::stream_chunks<char>(-1), std::system_error);
+    }
+}
+
+TEST_CASE("stream_chunks early exit stops reading", "[stream_chunks][stop]") {
+    const auto path = std::filesystem::temp_directory_path() / "ilp_for_stream_stop.bin";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string block(1 << 20, 'x');
+        for (int i = 0; i < 8; ++i)
+            out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    {
+        ilp::stream_chunks<char> in(fd, 4096);
+        int seen = 0;
+        for (auto chunk : in) {
+            (void)chunk;
+            if (++seen == 2)
+                break;
+        }
+    }
+    // Two chunks consumed, plus at most one buffered ahead and one being filled
+    CHECK(::lseek(fd, 0, SEEK_CUR) <= 4 * 4096);
+    ::close(fd);
+    std::filesystem::remove(path);
+}
+
+#endif // POSIX
@@ -0,0 +1,127 @@
+#include "../../ilp_for/kernels/striped_hash.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ilp::striped_hash - N-lane FNV-1a, XXH64 and CRC32C
+
+namespace {
+    std::uint32_t crc32c_bitwise(std::string_view s) {
+        std::uint32_t crc = ~0u;
+        for (unsigned char c : s) {
+            crc ^= c;
+            for (int k = 0; k < 8; ++k)
+                crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+        }
+        return ~crc;
+    }
+
+    std::uint64_t fnv1a_bytewise(std::string_view s) {
+        std::uint64_t h = 0xCBF29CE484222325ull;
+        for (unsigned char c : s)
+            h = (h ^ c) * 0x100000001B3ull;
+        return h;
+    }
+
+    std::string random_bytes(std::size_t n, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::string s(n, '\0');
+        for (auto& c : s)
+            c = static_cast<char>(rng());
+        return s;
+    }
+
+    template<typename Algo, std::size_t N>
+    auto h(std::string_view s, std::uint64_t seed = 0) {
+        return ilp::striped_hash<Algo, N>::hash(s.data(), s.size(), seed);
+    }
+} // namespace
+
+TEST_CASE("crc32c check values", "[striped_hash][crc32c]") {
+    CHECK(ilp::crc32c("123456789", 9) == 0xE3069283u);
+    CHECK(ilp::crc32c("", 0) == 0u);
+    // RFC 3720 B.4: 32 bytes of zeros / ones
+    const std::string zeros(32, '\0'), ones(32, '\xFF');
+    CHECK(ilp::crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+    CHECK(ilp::crc32c(ones.data(), ones.size()) == 0x62A8AB43u);
+}
+
+TEST_CASE("crc32c is independent of N", "[striped_hash][crc32c]") {
+    for (std::size_t len : {0u, 1u, 7u, 8u, 63u, 255u, 1024u, 4099u, 65536u + 13u}) {
+        const std::string s = random_bytes(len, static_cast<std::uint32_t>(len));
+        const std::uint32_t expected = crc32c_bitwise(s);
+        INFO("len " << len);
+        CHECK(ilp::crc32c<1>(s.data(), s.size()) == expected);
+        CHECK(ilp::crc32c<3>(s.data(), s.size()) == expected);
+        CHECK(ilp::crc32c<4>(s.data(), s.size()) == expected);
+        CHECK(ilp::crc32c<8>(s.data(), s.size()) == expected);
+        CHECK(ilp::crc32c(s.data(), s.size()) == expected);
+
+        // Continuing from a previous CRC
+        const std::size_t cut = len / 3;
+        CHECK(ilp::crc32c<4>(s.data() + cut, len - cut, ilp::crc32c<4>(s.data(), cut)) == expected);
+        CHECK(ilp::crc32c_combine(ilp::crc32c(s.data(), cut), ilp::crc32c(s.data() + cut, len - cut), len - cut) ==
+              expected);
+    }
+
+    SECTION("table path matches") {
+        const std::string s = random_bytes(1000, 5);
+        std::uint32_t a = ~0u, b = ~0u;
+        for (std::size_t i = 0; i + 8 <= s.size(); i += 8) {
+            a = ilp::detail::crc32c_word_table(a, ilp::swar::load_le(s.data() + i));
+            b = ilp::detail::crc32c_word(b, ilp::swar::load_le(s.data() + i));
+        }
+        CHECK(a == b);
+    }
+}
+
+TEST_CASE("fnv1a with one lane is standard FNV-1a", "[striped_hash][fnv1a]") {
+    CHECK(h<ilp::hash::fnv1a, 1>("") == 0xCBF29CE484222325ull);
+    CHECK(h<ilp::hash::fnv1a, 1>("a") == 0xAF63DC4C8601EC8Cull);
+    CHECK(h<ilp::hash::fnv1a, 1>("foobar") == 0x85944171F73967E8ull);
+    for (std::size_t len : {3u, 8u, 17u, 100u, 1001u}) {
+        const std::string s = random_bytes(len, 9);
+        CHECK(h<ilp::hash::fnv1a, 1>(s) == fnv1a_bytewise(s));
+    }
+}
+
+TEST_CASE("xxh64 with four lanes is XXH64", "[striped_hash][xxh64]") {
+    CHECK(h<ilp::hash::xxh64, 4>("") == 0xEF46DB3751D8E999ull);
+    CHECK(h<ilp::hash::xxh64, 4>("a") == 0xD24EC4F1A98C6E5Bull);
+    CHECK(h<ilp::hash::xxh64, 4>("abc") == 0x44BC2CF5AD770999ull);
+    CHECK(h<ilp::hash::xxh64, 4>("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ull);
+    CHECK(h<ilp::hash::xxh64, 4>("", 1) != h<ilp::hash::xxh64, 4>("", 0));
+}
+
+TEMPLATE_TEST_CASE("striped hashes are deterministic and length-sensitive", "[striped_hash]", ilp::hash::fnv1a,
+                   ilp::hash::xxh64, ilp::hash::crc32c) {
+    const std::string s = random_bytes(5000, 11);
+    for (std::size_t len = 0; len < 300; ++len) {
+        const std::string_view v(s.data(), len);
+        CHECK(h<TestType, 4>(v) == h<TestType, 4>(std::string(v)));
+        if (len > 0)
+            CHECK(h<TestType, 4>(v) != h<TestType, 4>(v.substr(0, len - 1)));
+    }
+
+    SECTION("hasher form and default N") {
+        ilp::striped_hash<TestType> hasher;
+        CHECK(decltype(hasher)::lanes >= 1);
+        CHECK(hasher(s) == decltype(hasher)::hash(s.data(), s.size()));
+        if constexpr (!TestType::lane_invariant)
+            STATIC_REQUIRE(decltype(hasher)::lanes == 4);
+        CHECK(ilp::striped_hash<TestType, ilp::striped_fast_N<TestType>>::lanes >= 1);
+    }
+
+    SECTION("single bit flips change the hash") {
+        std::string t = s;
+        const auto base = h<TestType, 8>(t);
+        for (std::size_t i = 0; i < t.size(); i += 97) {
+            t[i] ^= 1;
+            CHECK(h<TestType, 8>(t) != base);
+            t[i] ^= 1;
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include "../../ilp_for/kernels/utf8.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+// ilp::utf8_validate / utf8_count - interleaved DFA segments vs a reference decoder
+
+namespace {
+    // Straight decoder from the RFC 3629 rules, independent of the DFA table.
+    // Returns the start of the first ill-formed sequence, or size().
+    std::size_t reference_validate(std::string_view text, std::size_t* count = nullptr) {
+        const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t n = text.size();
+        std::size_t i = 0, cps = 0;
+        while (i < n) {
+            const unsigned b = p[i];
+            std::size_t len;
+            std::uint32_t cp;
+            if (b < 0x80) {
+                len = 1;
+                cp = b;
+            } else if ((b & 0xE0) == 0xC0) {
+                len = 2;
+                cp = b & 0x1F;
+            } else if ((b & 0xF0) == 0xE0) {
+                len = 3;
+                cp = b & 0x0F;
+            } else if ((b & 0xF8) == 0xF0) {
+                len = 4;
+                cp = b & 0x07;
+            } else {
+                break;
+            }
+            std::size_t k = 1;
+            for (; k < len && i + k < n && (p[i + k] & 0xC0) == 0x80; ++k)
+                cp = (cp << 6) | (p[i + k] & 0x3F);
+            if (k < len)
+                break;
+            static constexpr std::uint32_t min_cp[] = {0, 0, 0x80, 0x800, 0x10000};
+            if (cp < min_cp[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+                break;
+            i += len;
+            ++cps;
+        }
+        if (count)
+            *count = cps;
+        return i;
+    }
+
+    std::string encode(std::uint32_t cp) {
+        std::string s;
+        if (cp < 0x80) {
+            s += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            s += static_cast<char>(0xC0 | (cp >> 6));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            s += static_cast<char>(0xE0 | (cp >> 12));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            s += static_cast<char>(0xF0 | (cp >> 18));
+            s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return s;
+    }
+
+    // Mostly ASCII with runs of 2-, 3- and 4-byte characters
+    std::string random_text(std::size_t cps, std::mt19937& rng) {
+        std::string s;
+        for (std::size_t i = 0; i < cps; ++i) {
+            switch (rng() % 8) {
+            case 0:
+                s += encode(0x80 + rng() % (0x800 - 0x80));
+                break;
+            case 1: {
+                std::uint32_t cp = 0x800 + rng() % (0x10000 - 0x800);
+                s += encode(cp >= 0xD800 && cp <= 0xDFFF ? cp - 0x800 : cp);
+                break;
+            }
+            case 2:
+                s += encode(0x10000 + rng() % (0x110000 - 0x10000));
+                break;
+            default:
+                s += static_cast<char>(' ' + rng() % 95);
+            }
+        }
+        return s;
+    }
+} // namespace
+
+TEST_CASE("utf8_validate accepts valid text", "[utf8]") {
+    std::mt19937 rng(1);
+    for (std::size_t cps : {0u, 1u, 5u, 100u, 3000u, 50000u}) {
+        const std::string s = random_text(cps, rng);
+        INFO("bytes " << s.size());
+        CHECK(ilp::utf8_validate(s) == s.size());
+        CHECK(ilp::utf8_validate<1>(s) == s.size());
+        CHECK(ilp::utf8_validate<8>(s) == s.size());
+        CHECK(ilp::utf8_valid(s));
+        CHECK(ilp::utf8_count(s) == cps);
+        CHECK(ilp::utf8_count<1>(s) == cps);
+    }
+
+    SECTION("boundary code points") {
+        for (std::uint32_t cp : {0x0u, 0x7Fu, 0x80u, 0x7FFu, 0x800u, 0xD7FFu, 0xE000u, 0xFFFFu, 0x10000u, 0x10FFFFu})
+            CHECK(ilp::utf8_valid(encode(cp)));
+    }
+}
+
+TEST_CASE("utf8_validate rejects ill-formed sequences", "[utf8]") {
+    const std::string_view bad[] = {
+        "\x80",             // stray continuation
+        "\xC0\xAF",         // overlong '/'
+        "\xC1\xBF",         // overlong
+        "\xE0\x80\xAF",     // overlong 3-byte
+        "\xED\xA0\x80",     // surrogate U+D800
+        "\xF0\x80\x80\xAF", // overlong 4-byte
+        "\xF4\x90\x80\x80", // U+110000
+        "\xF5\x80\x80\x80", // lead above F4
+        "\xFF",
+        "\xC3",             // truncated
+        "\xE2\x82",         // truncated
+        "\xE2\x82\x41",     // bad continuation
+        "\xF0\x9F\x98",     // truncated 4-byte
+    };
+    for (auto b : bad) {
+        const std::string s = "ok " + std::string(b) + " tail";
+        INFO("sequence " << s);
+        CHECK(ilp::utf8_validate(s) == 3);
+        CHECK(reference_validate(s) == 3);
+    }
+}
+
+TEST_CASE("utf8_validate finds the first error across segments", "[utf8]") {
+    std::mt19937 rng(7);
+    const std::string clean = random_text(20000, rng);
+    const std::string_view corruptions[] = {"\x80", "\xC3", "\xED\xA0\x80", "\xF8", "\xE2\x28\xA1"};
+
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string s = clean;
+        // One or two corruptions anywhere, including right at the segment splits
+        const int errors = 1 + trial % 2;
+        for (int e = 0; e < errors; ++e) {
+            std::size_t at = trial < 40 ? s.size() / 4 * static_cast<std::size_t>(1 + trial % 3) + trial / 4
+                                        : rng() % s.size();
+            s.insert(at, corruptions[rng() % std::size(corruptions)]);
+        }
+        INFO("trial " << trial);
+        const std::size_t expected = reference_validate(s);
+        REQUIRE(expected < s.size());
+        CHECK(ilp::utf8_validate(s) == expected);
+        CHECK(ilp::utf8_validate<3>(s) == expected);
+        CHECK(ilp::utf8_validate<1>(s) == expected);
+    }
+
+    SECTION("error at the very end") {
+        std::string s = clean;
+        s.push_back('\xE2');
+        CHECK(ilp::utf8_validate(s) == clean.size());
+    }
+}
+
+TEST_CASE("utf8_count counts code points", "[utf8]") {
+    CHECK(ilp::utf8_count("") == 0);
+    CHECK(ilp::utf8_count("h\xC3\xA9llo w\xC3\xB6rld \xF0\x9F\x98\x80") == 13);
+
+    std::mt19937 rng(3);
+    for (int len = 0; len < 100; ++len) {
+        const std::string s = random_text(static_cast<std::size_t>(len), rng);
+        std::size_t cps = 0;
+        reference_validate(s, &cps);
+        CHECK(ilp::utf8_count(s) == cps);
+    }
+}
@@ -0,0 +1,200 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/kernels/varint.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+// ILP_FOR_VARSTEP - data-dependent stride, and ilp::for_each_varint - speculative varint lanes
+
+namespace {
+    // Records of [len][len payload bytes]
+    std::vector<std::uint8_t> make_records(const std::vector<std::uint8_t>& lengths) {
+        std::vector<std::uint8_t> buf;
+        for (auto len : lengths) {
+            buf.push_back(len);
+            for (std::uint8_t k = 0; k < len; ++k)
+                buf.push_back(static_cast<std::uint8_t>(k + 1));
+        }
+        return buf;
+    }
+
+    std::optional<std::size_t> find_record(const std::vector<std::uint8_t>& buf, std::uint8_t len) {
+        ILP_FOR_VARSTEP(auto i, std::size_t{0}, buf.size(), 4) {
+            ILP_STEP(1 + buf[i]);
+            if (buf[i] == len)
+                ILP_RETURN(i);
+        }
+        ILP_END_RETURN;
+        return std::nullopt;
+    }
+
+    std::vector<std::uint64_t> random_values(std::size_t n, std::uint32_t seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint64_t> v(n);
+        for (auto& x : v) {
+            // Mix of every encoded length, weighted toward short values like real protobuf data
+            const unsigned bits = static_cast<unsigned>(rng() % 4 == 0 ? rng() % 65 : rng() % 15);
+            x = bits == 0 ? 0 : rng() >> (64 - bits);
+        }
+        return v;
+    }
+
+    std::vector<std::uint8_t> encode_all(const std::vector<std::uint64_t>& values) {
+        std::vector<std::uint8_t> buf(values.size() * ilp::varint::max_bytes);
+        std::size_t n = 0;
+        for (auto v : values)
+            n += ilp::varint::encode(v, buf.data() + n);
+        buf.resize(n);
+        return buf;
+    }
+} // namespace
+
+TEST_CASE("ILP_FOR_VARSTEP walks length-prefixed records", "[varstep]") {
+    const auto buf = make_records({3, 0, 7, 1, 12, 2, 0, 5, 9});
+
+    std::vector<std::size_t> starts;
+    int payload_sum = 0;
+    ILP_FOR_VARSTEP(auto i, std::size_t{0}, buf.size(), 4) {
+        starts.push_back(i);
+        for (std::size_t k = 1; k <= buf[i]; ++k)
+            payload_sum += buf[i + k];
+        ILP_STEP(1 + buf[i]);
+    }
+    ILP_END;
+
+    CHECK(starts == std::vector<std::size_t>{0, 4, 5, 13, 15, 28, 31, 32, 38});
+    CHECK(payload_sum == 6 + 0 + 28 + 1 + 78 + 3 + 0 + 15 + 45);
+}
+
+TEST_CASE("ILP_FOR_VARSTEP control flow", "[varstep]") {
+    const auto buf = make_records({2, 4, 6, 8, 10});
+
+    SECTION("return") {
+        CHECK(find_record(buf, 6) == 8u);
+        CHECK(find_record(buf, 10) == 24u);
+        CHECK(find_record(buf, 5) == std::nullopt);
+    }
+
+    SECTION("break") {
+        int seen = 0;
+        ILP_FOR_VARSTEP(auto i, std::size_t{0}, buf.size(), 2) {
+            if (buf[i] > 4)
+                ILP_BREAK;
+            ILP_STEP(1 + buf[i]);
+            ++seen;
+        }
+        ILP_END;
+        CHECK(seen == 2);
+    }
+
+    SECTION("continue keeps the step") {
+        int even = 0;
+        ILP_FOR_VARSTEP(auto i, std::size_t{0}, buf.size(), 4) {
+            ILP_STEP(1 + buf[i]);
+            if (buf[i] % 4 != 0)
+                ILP_CONTINUE;
+            ++even;
+        }
+        ILP_END;
+        CHECK(even == 2);
+    }
+
+    SECTION("default step is 1") {
+        int count = 0;
+        ILP_FOR_VARSTEP(auto i, 0, 10, 4) {
+            (void)i;
+            ++count;
+        }
+        ILP_END;
+        CHECK(count == 10);
+    }
+
+    SECTION("step past the end and empty range") {
+        int count = 0;
+        ILP_FOR_VARSTEP(auto i, 0, 10, 4) {
+            (void)i;
+            ILP_STEP(7);
+            ++count;
+        }
+        ILP_END;
+        CHECK(count == 2);
+
+        ILP_FOR_VARSTEP(auto i, 5, 5, 4) {
+            (void)i;
+            ++count;
+        }
+        ILP_END;
+        CHECK(count == 2);
+    }
+}
+
+TEST_CASE("for_each_varint matches the scalar decoder", "[varstep][varint]") {
+    for (std::size_t count : {0u, 1u, 7u, 40u, 1000u, 20000u}) {
+        const auto values = random_values(count, static_cast<std::uint32_t>(count));
+        const auto buf = encode_all(values);
+
+        std::vector<std::uint64_t> out;
+        const std::size_t used = ilp::for_each_varint(buf, [&](std::uint64_t v) { out.push_back(v); });
+        INFO("count " << count);
+        CHECK(used == buf.size());
+        CHECK(out == values);
+
+        std::vector<std::uint64_t> narrow;
+        ilp::for_each_varint<1>(buf, [&](std::uint64_t v) { narrow.push_back(v); });
+        CHECK(narrow == values);
+    }
+}
+
+TEST_CASE("for_each_varint edge cases", "[varstep][varint]") {
+    SECTION("every length, including 10-byte values") {
+        std::vector<std::uint64_t> values;
+        for (unsigned b = 0; b <= 64; ++b)
+            values.push_back(b == 64 ? ~0ull : (1ull << b) - 1);
+        const auto buf = encode_all(values);
+        CHECK(buf.size() > 64 + 8);
+
+        std::vector<std::uint64_t> out;
+        CHECK(ilp::for_each_varint(buf, [&](std::uint64_t v) { out.push_back(v); }) == buf.size());
+        CHECK(out == values);
+
+        for (auto v : values) {
+            std::uint8_t enc[ilp::varint::max_bytes];
+            CHECK(ilp::varint::encode(v, enc) == ilp::varint::encoded_size(v));
+        }
+    }
+
+    SECTION("truncated tail is left for the next chunk") {
+        auto buf = encode_all({300, 5, 1ull << 40});
+        buf.pop_back();
+        std::vector<std::uint64_t> out;
+        CHECK(ilp::for_each_varint(buf, [&](std::uint64_t v) { out.push_back(v); }) == 3);
+        CHECK(out == std::vector<std::uint64_t>{300, 5});
+    }
+
+    SECTION("overlong varint stops decoding") {
+        std::vector<std::uint8_t> buf = {1, 2};
+        buf.insert(buf.end(), 11, 0x80);
+        buf.push_back(0);
+        buf.push_back(3);
+        std::vector<std::uint64_t> out;
+        CHECK(ilp::for_each_varint(buf, [&](std::uint64_t v) { out.push_back(v); }) == 2);
+        CHECK(out == std::vector<std::uint64_t>{1, 2});
+    }
+
+    SECTION("early exit through LoopCtrl") {
+        const auto values = random_values(500, 7);
+        const auto buf = encode_all(values);
+        std::size_t seen = 0;
+        const std::size_t used = ilp::for_each_varint(buf, [&](std::uint64_t, ilp::LoopCtrl<void>& ctrl) {
+            if (++seen == 123)
+                ctrl.break_loop();
+        });
+        CHECK(seen == 123);
+        std::size_t expect = 0;
+        for (std::size_t k = 0; k < 123; ++k)
+            expect += ilp::varint::encoded_size(values[k]);
+        CHECK(used == expect);
+    }
+}
@@ -0,0 +1,111 @@
+#include "../../ilp_for.hpp"
+#include "../../ilp_for/cpu_profiles/ilp_topology.hpp"
+#include "catch.hpp"
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("streaming caps Copy and Transform on top of the shared-core halving") {
+    constexpr ilp::cpu::Profile s = ilp::cpu::streaming(ilp::cpu::apple_m1);
+    constexpr ilp::cpu::Profile shared = ilp::cpu::shared_core(ilp::cpu::apple_m1);
+    SECTION("Port-bound loop types take the shared-core N") {
+        CHECK(s.sum_4f == shared.sum_4f);
+        CHECK(s.dotproduct_4 == shared.dotproduct_4);
+        CHECK(s.search_1 == shared.search_1);
+    }
+    SECTION("Memory-bound loop types need no more than two chains") {
+        CHECK(ilp::cpu::apple_m1.copy_2 == 8);
+        CHECK(s.copy_2 == 2);
+        CHECK(s.transform_1 == 2);
+        CHECK(s.copy_8 <= 2);
+    }
+    SECTION("Registers and cache sizes are untouched") {
+        CHECK(s.vector_registers == ilp::cpu::apple_m1.vector_registers);
+        CHECK(s.llc_kib == ilp::cpu::apple_m1.llc_kib);
+    }
+    SECTION("streaming_N_for reads the streaming profile") {
+        using ilp::LoopType;
+        constexpr ilp::cpu::Profile active = ilp::cpu::streaming(ILP_CPU_PROFILE);
+        CHECK(ilp::detail::streaming_N_for<float, LoopType::Sum> == std::size_t(active.sum_4f));
+        CHECK(ilp::detail::streaming_N_for<std::uint8_t, LoopType::Copy> == std::size_t(active.copy_1));
+        CHECK(ilp::detail::streaming_N_for<double, LoopType::Transform> <=
+              ilp::optimal_N_for<double, LoopType::Transform>);
+    }
+}
+
+TEST_CASE("Profiles carry their cache sizes") {
+    constexpr ilp::cpu::CacheSizes skl = ilp::cpu::cache_sizes(ilp::cpu::skylake);
+    CHECK(skl.l1d == 32u * 1024);
+    CHECK(skl.l2 == 256u * 1024);
+    CHECK(skl.llc == 8u * 1024 * 1024);
+    for (const auto* p : {&ilp::cpu::skylake, &ilp::cpu::apple_m1, &ilp::cpu::alderlake, &ilp::cpu::gracemont,
+                          &ilp::cpu::icelake, &ilp::cpu::sapphirerapids, &ilp::cpu::zen4, &ilp::cpu::zen5,
+                          &ilp::cpu::neoverse_v1, &ilp::cpu::neoverse_v2, &ilp::cpu::neoverse_n2,
+                          &ilp::cpu::default_profile}) {
+        CHECK(p->l1d_kib > 0);
+        CHECK(p->l1d_kib <= p->l2_kib);
+        CHECK(p->l2_kib <= p->llc_kib);
+    }
+}
+
+TEST_CASE("parse_cache_size reads sysfs sizes") {
+    using ilp::cpu::detail::parse_cache_size;
+    CHECK(parse_cache_size("48K") == 48u * 1024);
+    CHECK(parse_cache_size("2048K\n") == 2048u * 1024);
+    CHECK(parse_cache_size("300M") == 300u * 1024 * 1024);
+    CHECK(parse_cache_size("512") == 512u);
+    CHECK(parse_cache_size("") == 0u);
+    CHECK(parse_cache_size("K") == 0u);
+    CHECK(parse_cache_size("32X") == 0u);
+}
+
+TEST_CASE("detect_cache_sizes is 0 or ordered by level") {
+    const ilp::cpu::CacheSizes& host = ilp::cpu::detect_cache_sizes();
+    CHECK(&host == &ilp::cpu::detect_cache_sizes());
+    if (host.llc != 0) {
+        CHECK(host.l1d != 0);
+        CHECK(host.l1d <= host.llc);
+        CHECK(host.l2 <= host.llc);
+    }
+}
+
+#if ILP_WORKING_SET_AWARE
+TEST_CASE("_AUTO range loops switch to the streaming N past the last-level cache") {
+    using ilp::LoopType;
+    const std::size_t llc = ilp::detail::streaming_bytes();
+    auto n_of = [](auto n) { return decltype(n)::value; };
+
+    std::vector<std::uint8_t> big(llc + 1, 1);
+    std::vector<std::uint8_t> fits(llc);
+    constexpr std::size_t S = ilp::detail::streaming_N_for<std::uint8_t, LoopType::Copy>;
+    CHECK(ilp::detail::with_range_auto_N<std::uint8_t, LoopType::Copy>(big, n_of) == S);
+#if !defined(ILP_HYBRID_CORES) && !defined(ILP_SMT_AWARE)
+    CHECK(ilp::detail::with_range_auto_N<std::uint8_t, LoopType::Copy>(fits, n_of) ==
+          ilp::optimal_N_for<std::uint8_t, LoopType::Copy>);
+    SECTION("Ranges that aren't contiguous never stream") {
+        std::deque<std::uint8_t> chunked(llc + 1);
+        CHECK(ilp::detail::with_range_auto_N<std::uint8_t, LoopType::Copy>(chunked, n_of) ==
+              ilp::optimal_N_for<std::uint8_t, LoopType::Copy>);
+    }
+#endif
+
+    SECTION("Both instantiations give the same result") {
+        std::uint64_t total = 0;
+        ILP_FOR_RANGE_AUTO(auto x, big, Sum, std::uint8_t) {
+            total += x;
+        }
+        ILP_END;
+        CHECK(total == big.size());
+
+        std::vector<std::uint32_t> small(1000);
+        std::iota(small.begin(), small.end(), 1u);
+        std::uint32_t sum = 0;
+        ILP_FOR_RANGE_AUTO(auto x, small, Sum, std::uint32_t) {
+            sum += x;
+        }
+        ILP_END;
+        CHECK(sum == 500500u);
+    }
+}
+#endif
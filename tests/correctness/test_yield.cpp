@@ -0,0 +1,140 @@
+#include "../../ilp_for.hpp"
+#include "catch.hpp"
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ILP_FOR_YIELD / ilp::generate - lazy block-at-a-time production
+
+static_assert(std::ranges::input_range<ilp::generate_view<int, 4, int, void (*)(int, ilp::YieldCtrl<int>&)>>);
+
+TEST_CASE("ILP_FOR_YIELD yields filtered values in order", "[yield]") {
+    std::vector<int> data(37);
+    for (int i = 0; i < 37; ++i)
+        data[i] = i;
+
+    auto gen = ILP_FOR_YIELD(int, auto i, 0, 37, 4) {
+        if (data[i] % 3 == 0)
+            ILP_YIELD(data[i] * 10);
+    }
+    ILP_END_YIELD;
+
+    std::vector<int> out;
+    for (int v : gen)
+        out.push_back(v);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 37; i += 3)
+        expected.push_back(i * 10);
+    CHECK(out == expected);
+}
+
+TEST_CASE("ILP_FOR_YIELD empty and no-match ranges", "[yield]") {
+    SECTION("empty range") {
+        auto gen = ILP_FOR_YIELD(int, auto i, 0, 0, 4) {
+            ILP_YIELD(i);
+        }
+        ILP_END_YIELD;
+        CHECK(gen.begin() == std::default_sentinel);
+    }
+
+    SECTION("nothing yielded") {
+        auto gen = ILP_FOR_YIELD(int, auto i, 0, 100, 8) {
+            if (i < 0)
+                ILP_YIELD(i);
+        }
+        ILP_END_YIELD;
+        CHECK(gen.begin() == std::default_sentinel);
+    }
+}
+
+TEST_CASE("ILP_FOR_YIELD production is lazy", "[yield][lazy]") {
+    int calls = 0;
+    auto gen = ILP_FOR_YIELD(int, auto i, 0, 1000, 4) {
+        ++calls;
+        ILP_YIELD(i);
+    }
+    ILP_END_YIELD;
+
+    int taken = 0;
+    for (int v : gen | std::views::take(6)) {
+        CHECK(v == taken);
+        ++taken;
+    }
+    CHECK(taken == 6);
+    // Only the blocks needed to supply 6 values (plus at most one lookahead block)
+    CHECK(calls <= 12);
+}
+
+TEST_CASE("ILP_YIELD_BREAK stops production", "[yield][break]") {
+    auto gen = ILP_FOR_YIELD(int, auto i, 0, 100, 4) {
+        if (i == 10)
+            ILP_YIELD_BREAK;
+        ILP_YIELD(i);
+    }
+    ILP_END_YIELD;
+
+    int count = 0, last = -1;
+    for (int v : gen) {
+        ++count;
+        last = v;
+    }
+    CHECK(count == 10);
+    CHECK(last == 9);
+}
+
+TEST_CASE("ilp::generate blocks and non-trivial values", "[yield][block]") {
+    auto gen = ilp::generate<std::string, 4>(0, 10, [](int i, ilp::YieldCtrl<std::string>& y) {
+        if (i != 5)
+            y.yield(std::string(static_cast<std::size_t>(i) + 20, 'x'));
+    });
+
+    std::size_t total = 0, blocks = 0;
+    for (auto block = gen.next_block(); !block.empty(); block = gen.next_block()) {
+        CHECK(block.size() <= 4);
+        ++blocks;
+        for (auto& s : block)
+            total += s.size();
+    }
+    CHECK(blocks >= 3);
+    CHECK(total == (20 + 21 + 22 + 23 + 24 + 26 + 27 + 28 + 29));
+}
+
+TEST_CASE("ILP_YIELD keeps one value per iteration", "[yield]") {
+    auto gen = ILP_FOR_YIELD(int, auto i, 0, 10, 4) {
+        ILP_YIELD(i);
+        ILP_YIELD(-i); // no slot left in this iteration
+    }
+    ILP_END_YIELD;
+
+    std::vector<int> out;
+    for (int v : gen)
+        out.push_back(v);
+    CHECK(out == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+namespace {
+    struct Counted {
+        static inline int live = 0;
+        int v;
+        explicit Counted(int x) : v(x) { ++live; }
+        Counted(const Counted& o) : v(o.v) { ++live; }
+        ~Counted() { --live; }
+    };
+} // namespace
+
+TEST_CASE("ilp::generate destroys yielded values when the body throws", "[yield][block]") {
+    {
+        auto gen = ilp::generate<Counted, 4>(0, 10, [](int i, ilp::YieldCtrl<Counted>& y) {
+            if (i == 6)
+                throw std::runtime_error("body");
+            y.yield(Counted(i));
+        });
+        auto block = gen.next_block();
+        CHECK(block.size() == 4);
+        CHECK_THROWS_AS(gen.next_block(), std::runtime_error);
+        CHECK(Counted::live == 2);
+    }
+    CHECK(Counted::live == 0);
+}
@@ -18,7 +18,7 @@ run_tests() {
     mkdir -p "$BUILD_DIR"
     cd "$BUILD_DIR"
 
-    cmake .. $cmake_flags
+    cmake .. ${cmake_flags:+"$cmake_flags"}
     cmake --build . -j
 
     ./test_runner
@@ -27,9 +27,10 @@ run_tests() {
     echo ""
 }
 
-# Test both modes
+# Test all modes; RUNTIME picks a hybrid part with SMT so every runtime instantiation is built
 run_tests "ILP (default)" ""
 run_tests "SIMPLE" "-DCMAKE_CXX_FLAGS=-DILP_MODE_SIMPLE"
+run_tests "RUNTIME" "-DCMAKE_CXX_FLAGS=-DILP_HYBRID_CORES -DILP_SMT_AWARE -DILP_DETECT_CACHES -DILP_CPU_ALDERLAKE"
 
 echo "=========================================="
 echo "All modes passed!"
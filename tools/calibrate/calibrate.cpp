@@ -0,0 +1,794 @@
+// ilp_for - ILP loop unrolling for C++20
+// Copyright (c) 2025 Matt Vanderdorff
+// https://github.com/mattyv/ilp_for
+// SPDX-License-Identifier: BSL-1.0
+
+// ilp_calibrate - measure the unroll knee of every Profile field on this machine
+//
+// For each field a kernel is instantiated for N = 1..16 and timed over an L1-resident buffer.
+// Reductions (Sum, DotProduct, Multiply, Divide, Sqrt, MinMax, Bitwise, Shift, Gather, Popcount,
+// CompareExchange, Convert, Hash) run N independent accumulator chains of the field's operation,
+// which is what L×TPC counts; Scan does the same with a store per link. Search, Copy and
+// Transform run the library's own ILP_FOR loop with unroll factor N. The chosen N is the knee of
+// the throughput curve: the smallest N within --tolerance of the best throughput seen.
+//
+// Output is a Profile block for ilp_cpu_profiles.hpp plus the selector lines for ilp_cpu.hpp.
+//
+// Custom loop types (ilp::CustomLoopType) are measured the same way when the tool is built with
+// -DILP_CALIBRATE_USER_KERNELS=<header>; see README.md for what the header declares.
+
+#include "ilp_for.hpp"
+#include "ilp_for/cpu_profiles/ilp_cpu_profiles.hpp"
+#include "ilp_for/cpu_profiles/ilp_topology.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <intrin.h>
+#include <windows.h>
+#endif
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+#ifdef ILP_CALIBRATE_USER_KERNELS
+#include ILP_CALIBRATE_USER_KERNELS
+#endif
+
+namespace {
+
+    constexpr std::size_t max_n = 16;
+    constexpr std::size_t buffer_bytes = 8192; // per buffer: Copy/Transform use two, both stay in L1
+    constexpr unsigned seed = 42;
+
+    // Stops the compiler from hoisting loads of the input across passes
+    inline void clobber() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" ::: "memory");
+#endif
+    }
+
+    // Integer chains would otherwise be reassociated into a tree, which hides the latency being
+    // measured. Floating point is left alone: without -ffast-math the compiler keeps the order.
+    template<typename T>
+    inline T opaque(T v) {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (std::is_integral_v<T>)
+            asm("" : "+r"(v));
+#endif
+        return v;
+    }
+
+    template<typename T>
+    volatile T sink{};
+
+    // For values that can't go through sink<T> (custom types have no volatile assignment)
+    inline void escape(const void* p) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static const void* volatile escaped;
+        escaped = p;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r"(p) : "memory");
+#endif
+    }
+
+    // ==================== Operations ====================
+    // apply(acc, x) is one link of an accumulator chain; sample() gives inputs that keep the chain
+    // finite and normal for the whole run (no overflow, no denormals, no data-dependent fast paths).
+
+    struct Add {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>(a + x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) {
+            if constexpr (std::is_floating_point_v<T>)
+                return static_cast<T>(1e-3 * std::uniform_real_distribution<double>(0.5, 1.0)(rng));
+            else
+                return static_cast<T>(rng());
+        }
+    };
+
+    struct Fma {
+        template<typename T>
+        static T apply(T a, T x) { return std::fma(x, x, a); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return Add::sample<T>(rng); }
+    };
+
+    struct Mul {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>(a * x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) {
+            if constexpr (std::is_floating_point_v<T>)
+                return static_cast<T>(std::uniform_real_distribution<double>(0.999999, 1.000001)(rng));
+            else
+                return static_cast<T>(rng() | 1); // odd, so the product never collapses to zero
+        }
+    };
+
+    // a' = x / a with x near 1 keeps a near 1 and puts exactly one divide on the chain
+    struct Div {
+        template<typename T>
+        static T apply(T a, T x) { return x / a; }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return Mul::sample<T>(rng); }
+    };
+
+    // The add is on the chain too (it converges instead of collapsing to sqrt(1)), so this
+    // slightly overstates N for cores where sqrt latency is short next to add latency
+    struct Sqrt {
+        template<typename T>
+        static T apply(T a, T x) { return std::sqrt(a + x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return Add::sample<T>(rng); }
+    };
+
+    struct Max {
+        template<typename T>
+        static T apply(T a, T x) { return a < x ? x : a; }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) {
+            if constexpr (std::is_floating_point_v<T>)
+                return static_cast<T>(std::uniform_real_distribution<double>(-1.0, 1.0)(rng));
+            else
+                return static_cast<T>(rng());
+        }
+    };
+
+    struct Xor {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>(a ^ x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng()); }
+    };
+
+    // Variable count from the data, so consecutive shifts can't be folded into one
+    struct Shift {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>(a << (x & 1)); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng()); }
+    };
+
+    struct Popcount {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>(static_cast<T>(std::popcount(a)) + x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng()); }
+    };
+
+    // A sorting-network compare-exchange: both halves depend on a. Folding them back into one
+    // value puts an xor and a shift on the chain as well
+    struct CmpXchg {
+        template<typename T>
+        static T apply(T a, T x) {
+            const T lo = x < a ? x : a;
+            const T hi = x < a ? a : x;
+            return static_cast<T>(lo ^ (hi >> 1));
+        }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng()); }
+    };
+
+    // Round trip through the integer of the same width: half of each link is the int -> FP
+    // convert the field is about, so this overstates N where FP -> int is the slower direction
+    struct Convert {
+        template<typename T>
+        static T apply(T a, T x) {
+            using I = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+            return static_cast<T>(static_cast<I>(a) ^ static_cast<I>(x));
+        }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng() % 1024); }
+    };
+
+    // One multiply-xorshift round (the murmur/splitmix finalizer step)
+    struct Hash {
+        template<typename T>
+        static T apply(T a, T x) { return static_cast<T>((a ^ (a >> (sizeof(T) * 4 - 3))) * x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return Mul::sample<T>(rng); }
+    };
+
+    template<typename T, typename Sampler>
+    std::vector<T> make_data(Sampler sample) {
+        std::mt19937_64 rng(seed);
+        std::vector<T> v(buffer_bytes / sizeof(T));
+        for (auto& x : v)
+            x = sample(rng);
+        return v;
+    }
+
+    // A dependent indexed load: the loaded value picks the next slot. With no gather on the chain
+    // this times scalar loads, the NEON form; x86 vector gathers are slower than this shows.
+    struct Gather {
+        template<typename T>
+        static inline const std::vector<T> table =
+            make_data<T>([](auto& rng) { return static_cast<T>(rng() % (buffer_bytes / sizeof(T))); });
+
+        template<typename T>
+        static T apply(T a, T x) { return table<T>[static_cast<std::size_t>(a ^ x) & (buffer_bytes / sizeof(T) - 1)]; }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return static_cast<T>(rng() % (buffer_bytes / sizeof(T))); }
+    };
+
+    // ==================== Kernels ====================
+    // run<N>(reps) makes reps passes over the buffer; one pass is elems operations.
+
+    template<typename T, typename Op>
+    struct Chains {
+        static inline const std::vector<T> data = make_data<T>([](auto& rng) { return Op::template sample<T>(rng); });
+        static std::size_t elems() { return data.size(); }
+
+        template<std::size_t N>
+        NOINLINE static void run(std::size_t reps) {
+            const T* x = data.data();
+            const std::size_t n = data.size(); // a multiple of max_n
+            std::array<T, N> acc;
+            for (std::size_t j = 0; j < N; ++j)
+                acc[j] = x[j];
+            // Always max_n elements per iteration, element k on lane k % N, so the loop overhead
+            // is the same for every N and only the number of chains changes
+            for (std::size_t r = 0; r < reps; ++r) {
+                for (std::size_t i = 0; i < n; i += max_n) {
+                    [&]<std::size_t... K>(std::index_sequence<K...>) {
+                        ((acc[K % N] = opaque(Op::apply(acc[K % N], x[i + K]))), ...);
+                    }(std::make_index_sequence<max_n>{});
+                }
+                clobber();
+            }
+            if constexpr (std::is_arithmetic_v<T>) {
+                T folded = acc[0];
+                for (std::size_t j = 1; j < N; ++j)
+                    folded = static_cast<T>(folded + acc[j]);
+                sink<T> = folded;
+            } else {
+                escape(acc.data());
+            }
+        }
+    };
+
+    // Prefix sum: Chains with every running total stored, so the store port joins the add chain
+    template<typename T>
+    struct Scan {
+        static inline const std::vector<T> data = make_data<T>([](auto& rng) { return Add::sample<T>(rng); });
+        static inline std::vector<T> out = std::vector<T>(buffer_bytes / sizeof(T));
+        static std::size_t elems() { return data.size(); }
+
+        template<std::size_t N>
+        NOINLINE static void run(std::size_t reps) {
+            const T* x = data.data();
+            T* y = out.data();
+            const std::size_t n = data.size();
+            std::array<T, N> acc{};
+            for (std::size_t r = 0; r < reps; ++r) {
+                for (std::size_t i = 0; i < n; i += max_n) {
+                    [&]<std::size_t... K>(std::index_sequence<K...>) {
+                        ((y[i + K] = acc[K % N] = opaque(static_cast<T>(acc[K % N] + x[i + K]))), ...);
+                    }(std::make_index_sequence<max_n>{});
+                }
+                clobber();
+            }
+        }
+    };
+
+    // Compare + early exit through ILP_FOR; the target is absent so every pass scans the buffer
+    template<typename T>
+    struct Search {
+        static inline const std::vector<T> data = make_data<T>([](auto& rng) { return static_cast<T>(rng() | 1); });
+        static std::size_t elems() { return data.size(); }
+
+        template<std::size_t N>
+        NOINLINE static std::size_t find(const T* x, std::size_t n, T target) {
+            ILP_FOR(auto i, std::size_t{0}, n, N) {
+                if (x[i] == target)
+                    ILP_RETURN(i);
+            }
+            ILP_END_RETURN;
+            return n;
+        }
+
+        template<std::size_t N>
+        static void run(std::size_t reps) {
+            std::size_t found = 0;
+            for (std::size_t r = 0; r < reps; ++r) {
+                found += find<N>(data.data(), data.size(), T{0});
+                clobber();
+            }
+            sink<std::size_t> = found;
+        }
+    };
+
+    // dst[i] = f(src[i]) through ILP_FOR; Copy is the identity, Transform a multiply-add
+    template<typename T, bool Compute>
+    struct Stream {
+        static inline const std::vector<T> src = make_data<T>([](auto& rng) { return static_cast<T>(rng()); });
+        static inline std::vector<T> dst = std::vector<T>(buffer_bytes / sizeof(T));
+        static std::size_t elems() { return src.size(); }
+
+        template<std::size_t N>
+        NOINLINE static void pass(const T* in, T* out, std::size_t n) {
+            ILP_FOR(auto i, std::size_t{0}, n, N) {
+                if constexpr (Compute)
+                    out[i] = static_cast<T>(in[i] * T{3} + T{1});
+                else
+                    out[i] = in[i];
+            }
+            ILP_END;
+        }
+
+        template<std::size_t N>
+        static void run(std::size_t reps) {
+            for (std::size_t r = 0; r < reps; ++r) {
+                pass<N>(src.data(), dst.data(), src.size());
+                clobber();
+            }
+        }
+    };
+
+    // ==================== Fields ====================
+
+    using Runner = void (*)(std::size_t);
+
+    struct Field {
+        const char* name;
+        const char* group; // comment line emitted before the first field of a group
+        std::size_t (*elems)();
+        std::array<Runner, max_n> run;
+    };
+
+    template<typename K>
+    Field field(const char* name, const char* group = nullptr) {
+        return {name, group, &K::elems, []<std::size_t... I>(std::index_sequence<I...>) {
+                    return std::array<Runner, max_n>{&K::template run<I + 1>...};
+                }(std::make_index_sequence<max_n>{})};
+    }
+
+    // Same order as ilp::cpu::Profile: designated initializers must follow declaration order
+    std::vector<Field> all_fields() {
+        using u8 = std::uint8_t;
+        using u16 = std::uint16_t;
+        using u32 = std::uint32_t;
+        using u64 = std::uint64_t;
+        using i8 = std::int8_t;
+        using i16 = std::int16_t;
+        using i32 = std::int32_t;
+        using i64 = std::int64_t;
+        // After the id, 56 timed fields plus the two register counts and three cache sizes emit() writes
+        static_assert(offsetof(ilp::cpu::Profile, llc_kib) - offsetof(ilp::cpu::Profile, sum_1) == 60 * sizeof(int),
+                      "keep the field list in step with Profile");
+        return {
+            field<Chains<u8, Add>>("sum_1", "Sum - add chains"),
+            field<Chains<u16, Add>>("sum_2"),
+            field<Chains<u32, Add>>("sum_4i"),
+            field<Chains<u64, Add>>("sum_8i"),
+            field<Chains<float, Add>>("sum_4f"),
+            field<Chains<double, Add>>("sum_8f"),
+            field<Chains<float, Fma>>("dotproduct_4", "DotProduct - FMA chains"),
+            field<Chains<double, Fma>>("dotproduct_8"),
+            field<Search<u8>>("search_1", "Search - ILP_FOR compare + early exit"),
+            field<Search<u16>>("search_2"),
+            field<Search<u32>>("search_4"),
+            field<Search<u64>>("search_8"),
+            field<Stream<u8, false>>("copy_1", "Copy - ILP_FOR dst[i] = src[i]"),
+            field<Stream<u16, false>>("copy_2"),
+            field<Stream<u32, false>>("copy_4"),
+            field<Stream<u64, false>>("copy_8"),
+            field<Stream<u8, true>>("transform_1", "Transform - ILP_FOR dst[i] = src[i] * 3 + 1"),
+            field<Stream<u16, true>>("transform_2"),
+            field<Stream<u32, true>>("transform_4"),
+            field<Stream<u64, true>>("transform_8"),
+            field<Chains<float, Mul>>("multiply_4f", "Multiply - product chains"),
+            field<Chains<double, Mul>>("multiply_8f"),
+            field<Chains<u32, Mul>>("multiply_4i"),
+            field<Chains<u64, Mul>>("multiply_8i"),
+            field<Chains<float, Div>>("divide_4f", "Divide - a = x / a chains"),
+            field<Chains<double, Div>>("divide_8f"),
+            field<Chains<float, Sqrt>>("sqrt_4f", "Sqrt - a = sqrt(a + x) chains"),
+            field<Chains<double, Sqrt>>("sqrt_8f"),
+            field<Chains<i8, Max>>("minmax_1", "MinMax - max chains"),
+            field<Chains<i16, Max>>("minmax_2"),
+            field<Chains<i32, Max>>("minmax_4i"),
+            field<Chains<i64, Max>>("minmax_8i"),
+            field<Chains<float, Max>>("minmax_4f"),
+            field<Chains<double, Max>>("minmax_8f"),
+            field<Chains<u8, Xor>>("bitwise_1", "Bitwise - xor chains"),
+            field<Chains<u16, Xor>>("bitwise_2"),
+            field<Chains<u32, Xor>>("bitwise_4"),
+            field<Chains<u64, Xor>>("bitwise_8"),
+            field<Chains<u8, Shift>>("shift_1", "Shift - variable shift chains"),
+            field<Chains<u16, Shift>>("shift_2"),
+            field<Chains<u32, Shift>>("shift_4"),
+            field<Chains<u64, Shift>>("shift_8"),
+            field<Chains<u32, Gather>>("gather_4", "Gather - dependent indexed load chains"),
+            field<Chains<u64, Gather>>("gather_8"),
+            field<Chains<u32, Popcount>>("popcount_4", "Popcount - a = popcount(a) + x chains"),
+            field<Chains<u64, Popcount>>("popcount_8"),
+            field<Chains<i32, CmpXchg>>("cmpxchg_4", "CompareExchange - min + max chains"),
+            field<Chains<i64, CmpXchg>>("cmpxchg_8"),
+            field<Chains<float, Convert>>("convert_4", "Convert - int <-> FP round-trip chains"),
+            field<Chains<double, Convert>>("convert_8"),
+            field<Chains<u32, Hash>>("hash_4", "Hash - multiply-xorshift chains"),
+            field<Chains<u64, Hash>>("hash_8"),
+            field<Scan<u32>>("scan_4i", "Scan - add chains storing every total"),
+            field<Scan<u64>>("scan_8i"),
+            field<Scan<float>>("scan_4f"),
+            field<Scan<double>>("scan_8f"),
+        };
+    }
+
+    // A custom loop type's chain link: Tag::apply(acc, x) over Tag::sample() inputs
+    template<typename Tag>
+    struct TagOp {
+        template<typename T>
+        static T apply(T a, T x) { return Tag::apply(a, x); }
+        template<typename T>
+        static T sample(std::mt19937_64& rng) { return Tag::sample(rng); }
+    };
+
+    // Not Profile fields: reported as LoopCost figures for the tags' cost() functions
+    std::vector<Field> custom_fields() {
+#ifdef ILP_CALIBRATE_USER_KERNELS
+        return []<typename... Tags>(std::tuple<Tags...>*) {
+            return std::vector<Field>{field<Chains<typename Tags::value_type, TagOp<Tags>>>(Tags::name)...};
+        }(static_cast<ilp_calibrate_types*>(nullptr));
+#else
+        return {};
+#endif
+    }
+
+    // ==================== Measurement ====================
+
+    struct Options {
+        std::string name = "host";
+        std::string output;
+        std::string csv;
+        std::string only;
+        int trials = 7;
+        double pass_ms = 2.0;
+        double tolerance = 0.05;
+        int cpu = -1;
+    };
+
+    struct Result {
+        std::array<double, max_n> rate{}; // operations per ns, median over trials
+        int knee = 1;
+    };
+
+    double seconds_since(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    double time_run(Runner run, std::size_t reps) {
+        const auto t0 = std::chrono::steady_clock::now();
+        run(reps);
+        return seconds_since(t0);
+    }
+
+    // Smallest N whose throughput is within tolerance of the best
+    int pick_knee(const std::array<double, max_n>& rate, double tolerance) {
+        const double best = *std::max_element(rate.begin(), rate.end());
+        for (std::size_t i = 0; i < max_n; ++i)
+            if (rate[i] >= best * (1.0 - tolerance))
+                return static_cast<int>(i + 1);
+        return static_cast<int>(max_n);
+    }
+
+    Result measure(const Field& f, const Options& opt) {
+        // Size the run on the middle of the range so every N gets the same work
+        Runner probe = f.run[3];
+        std::size_t reps = 1;
+        while (time_run(probe, reps) * 1e3 < opt.pass_ms && reps < (std::size_t{1} << 30))
+            reps *= 2;
+
+        for (Runner run : f.run)
+            run(reps); // warm-up: page in, train predictors, settle the clock
+
+        // Trials are interleaved across N so that clock drift lands on every N alike
+        std::array<std::vector<double>, max_n> samples;
+        for (int t = 0; t < opt.trials; ++t)
+            for (std::size_t i = 0; i < max_n; ++i)
+                samples[i].push_back(time_run(f.run[i], reps));
+
+        Result res;
+        const double ops = static_cast<double>(reps) * static_cast<double>(f.elems());
+        for (std::size_t i = 0; i < max_n; ++i) {
+            auto& s = samples[i];
+            std::nth_element(s.begin(), s.begin() + s.size() / 2, s.end());
+            res.rate[i] = ops / (s[s.size() / 2] * 1e9);
+        }
+        res.knee = pick_knee(res.rate, opt.tolerance);
+        return res;
+    }
+
+    // Run the first kernel for a while so a power-saving core reaches its steady clock
+    void spin_up() {
+        const auto t0 = std::chrono::steady_clock::now();
+        while (seconds_since(t0) < 0.25)
+            Chains<double, Add>::run<4>(64);
+    }
+
+    // ==================== Host ====================
+
+    std::string pin_thread(int cpu) {
+#if defined(__linux__)
+        if (cpu < 0)
+            cpu = sched_getcpu();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (cpu >= 0 && sched_setaffinity(0, sizeof(set), &set) == 0)
+            return "pinned to CPU " + std::to_string(cpu);
+        return "not pinned (sched_setaffinity failed)";
+#elif defined(_WIN32)
+        if (cpu < 0)
+            cpu = static_cast<int>(GetCurrentProcessorNumber());
+        if (SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0)
+            return "pinned to CPU " + std::to_string(cpu);
+        return "not pinned (SetThreadAffinityMask failed)";
+#else
+        (void)cpu;
+        return "not pinned (no affinity API on this platform)";
+#endif
+    }
+
+    std::string cpu_brand() {
+#if defined(__linux__)
+        std::ifstream in("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.rfind("model name", 0) == 0 || line.rfind("Model", 0) == 0) {
+                const auto colon = line.find(':');
+                if (colon != std::string::npos)
+                    return line.substr(line.find_first_not_of(" \t", colon + 1));
+            }
+        }
+#elif defined(__APPLE__)
+        char buf[256];
+        std::size_t len = sizeof(buf);
+        if (sysctlbyname("machdep.cpu.brand_string", buf, &len, nullptr, 0) == 0)
+            return std::string(buf);
+#endif
+        return "unknown CPU";
+    }
+
+    // ==================== Output ====================
+
+    std::string upper(std::string s) {
+        for (auto& c : s)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return s;
+    }
+
+    std::string fixed(double v, int digits = 2) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.*f", digits, v);
+        return buf;
+    }
+
+    // Register file of the target this binary is compiled for; these are counted, not timed
+#if defined(__aarch64__) || defined(_M_ARM64)
+    constexpr int host_gpr_registers = 31;
+    constexpr int host_vector_registers = 32;
+#elif defined(__AVX512F__)
+    constexpr int host_gpr_registers = 16;
+    constexpr int host_vector_registers = 32;
+#else
+    constexpr int host_gpr_registers = 16;
+    constexpr int host_vector_registers = 16;
+#endif
+
+    void emit(std::ostream& out, const Options& opt, const std::vector<Field>& fields,
+              const std::vector<Result>& results, const std::string& brand) {
+        out << "// ---- ilp_cpu_profiles.hpp ----\n\n";
+        out << "    // " << brand << " - Source: ilp_calibrate (" << opt.trials << " trials, knee within "
+            << fixed(opt.tolerance * 100, 0) << "% of peak)\n";
+        out << "    // Comments give operations per ns at N=1 and at the peak\n";
+        out << "    inline constexpr Profile " << opt.name << " = {\n";
+        out << "        .id = \"" << opt.name << "\",\n";
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].group)
+                out << "        // " << fields[i].group << "\n";
+            const auto& r = results[i];
+            const double peak = *std::max_element(r.rate.begin(), r.rate.end());
+            out << "        ." << fields[i].name << " = " << r.knee << ", // " << fixed(r.rate[0]) << " -> "
+                << fixed(peak) << "\n";
+        }
+        out << "        // Registers - architectural counts for the compile target\n";
+        out << "        .gpr_registers = " << host_gpr_registers << ",\n";
+        out << "        .vector_registers = " << host_vector_registers << ",\n";
+        // Read rather than timed; the default profile's where the host doesn't say
+        const ilp::cpu::CacheSizes fallback = ilp::cpu::cache_sizes(ilp::cpu::default_profile);
+        const ilp::cpu::CacheSizes& host = ilp::cpu::detect_cache_sizes();
+        auto kib = [](std::size_t host_bytes, std::size_t fallback_bytes) {
+            return (host_bytes != 0 ? host_bytes : fallback_bytes) / 1024;
+        };
+        out << "        // Caches - detected on this host\n";
+        out << "        .l1d_kib = " << kib(host.l1d, fallback.l1d) << ",\n";
+        out << "        .l2_kib = " << kib(host.l2, fallback.l2) << ",\n";
+        out << "        .llc_kib = " << kib(host.llc, fallback.llc) << ",\n";
+        out << "    };\n\n";
+        out << "    // ilp::cpu::get()\n";
+        out << "        if (name == \"" << opt.name << "\")\n";
+        out << "            return " << opt.name << ";\n\n";
+
+        out << "// ---- ilp_cpu.hpp ----\n\n";
+        out << "#elif defined(ILP_CPU_" << upper(opt.name) << ") || defined(ILP_CPU_" << opt.name << ")\n";
+        out << "#define ILP_CPU_BASE_PROFILE ilp::cpu::" << opt.name << "\n";
+    }
+
+    // The knee is L×TPC; cost() only needs the product, so it is given as latency with one per cycle
+    void emit_custom(std::ostream& out, const std::vector<Field>& fields, const std::vector<Result>& results) {
+        out << "// ---- custom loop types ----\n\n";
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            const auto& r = results[i];
+            const double peak = *std::max_element(r.rate.begin(), r.rate.end());
+            out << "    // " << fields[i].name << ": " << fixed(r.rate[0]) << " -> " << fixed(peak)
+                << " operations per ns\n";
+            out << "    return ilp::LoopCost{.latency = " << r.knee << ", .per_cycle = 1};\n\n";
+        }
+    }
+
+    void emit_csv(std::ostream& out, const std::vector<Field>& fields, const std::vector<Result>& results) {
+        out << "field,n,ops_per_ns,knee\n";
+        for (std::size_t i = 0; i < fields.size(); ++i)
+            for (std::size_t n = 0; n < max_n; ++n)
+                out << fields[i].name << ',' << n + 1 << ',' << fixed(results[i].rate[n], 4) << ','
+                    << results[i].knee << '\n';
+    }
+
+    // ==================== Command line ====================
+
+    void usage() {
+        std::cerr << "usage: ilp_calibrate [options]\n"
+                     "  --name NAME        profile name (default: host)\n"
+                     "  --output FILE      write the profile block to FILE instead of stdout\n"
+                     "  --csv FILE         also write the full throughput curves as CSV\n"
+                     "  --only FIELD       measure fields whose name starts with FIELD\n"
+                     "  --trials K         timed trials per N, median is kept (default: 7)\n"
+                     "  --pass-ms MS       minimum duration of one timed run (default: 2)\n"
+                     "  --tolerance F      knee = smallest N within F of the peak (default: 0.05)\n"
+                     "  --cpu C            pin to CPU C (default: the current one)\n"
+                     "  --quick            3 trials of 0.5 ms, for a smoke test\n";
+    }
+
+    bool valid_name(std::string_view name) {
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+            return false;
+        return std::all_of(name.begin(), name.end(),
+                           [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+    }
+
+    bool parse(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+            const char* v = nullptr;
+            if (arg == "--quick") {
+                opt.trials = 3;
+                opt.pass_ms = 0.5;
+                continue;
+            }
+            if (arg == "--help" || arg == "-h")
+                return false;
+            if (!(v = value()))
+                return false;
+            if (arg == "--name")
+                opt.name = v;
+            else if (arg == "--output")
+                opt.output = v;
+            else if (arg == "--csv")
+                opt.csv = v;
+            else if (arg == "--only")
+                opt.only = v;
+            else if (arg == "--trials")
+                opt.trials = std::max(1, std::atoi(v));
+            else if (arg == "--pass-ms")
+                opt.pass_ms = std::atof(v);
+            else if (arg == "--tolerance")
+                opt.tolerance = std::clamp(std::atof(v), 0.0, 0.5);
+            else if (arg == "--cpu")
+                opt.cpu = std::atoi(v);
+            else
+                return false;
+        }
+        if (!valid_name(opt.name)) {
+            std::cerr << "ilp_calibrate: --name must be a C++ identifier\n";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    auto fields = all_fields();
+    auto custom = custom_fields();
+    if (!opt.only.empty()) {
+        auto unselected = [&](const Field& f) { return std::string_view(f.name).rfind(opt.only, 0) != 0; };
+        std::erase_if(fields, unselected);
+        std::erase_if(custom, unselected);
+        if (fields.empty() && custom.empty()) {
+            std::cerr << "ilp_calibrate: no field starts with '" << opt.only << "'\n";
+            return 2;
+        }
+    }
+
+    const std::string brand = cpu_brand();
+    std::cerr << "ilp_calibrate: " << brand << ", " << pin_thread(opt.cpu) << "\n";
+    spin_up();
+
+    auto measure_all = [&](const std::vector<Field>& list) {
+        std::vector<Result> results;
+        for (const auto& f : list) {
+            results.push_back(measure(f, opt));
+            const auto& r = results.back();
+            const std::size_t len = std::strlen(f.name);
+            std::cerr << "  " << f.name << std::string(len < 14 ? 14 - len : 1, ' ') << "N=" << r.knee << "  ";
+            for (double rate : r.rate)
+                std::cerr << ' ' << fixed(rate);
+            std::cerr << "\n";
+        }
+        return results;
+    };
+    const auto results = measure_all(fields);
+    const auto custom_results = measure_all(custom);
+
+    if (!opt.csv.empty()) {
+        auto curves = fields;
+        curves.insert(curves.end(), custom.begin(), custom.end());
+        auto curve_results = results;
+        curve_results.insert(curve_results.end(), custom_results.begin(), custom_results.end());
+        std::ofstream csv(opt.csv);
+        emit_csv(csv, curves, curve_results);
+    }
+    std::ofstream file;
+    if (!opt.output.empty())
+        file.open(opt.output);
+    std::ostream& out = opt.output.empty() ? std::cout : file;
+    if (!fields.empty())
+        emit(out, opt, fields, results, brand);
+    if (!custom.empty())
+        emit_custom(out, custom, custom_results);
+    if (!fields.empty() && fields.size() != all_fields().size())
+        std::cerr << "ilp_calibrate: --only was given, the Profile block is incomplete\n";
+    return 0;
+}
@@ -52,6 +52,48 @@ namespace clang::tidy::ilp {
 
             return false;
         }
+
+        // Element size of a builtin scalar type; 4 when unknown
+        unsigned builtinSize(QualType Ty) {
+            if (Ty.isNull() || Ty->isDependentType())
+                return 4;
+            if (const auto* BT = Ty->getAs<BuiltinType>()) {
+                switch (BT->getKind()) {
+                case BuiltinType::Char_S:
+                case BuiltinType::Char_U:
+                case BuiltinType::SChar:
+                case BuiltinType::UChar:
+                    return 1;
+                case BuiltinType::Short:
+                case BuiltinType::UShort:
+                    return 2;
+                case BuiltinType::Long:
+                case BuiltinType::ULong:
+                case BuiltinType::LongLong:
+                case BuiltinType::ULongLong:
+                case BuiltinType::Double:
+                    return 8;
+                default:
+                    return 4;
+                }
+            }
+            return 4;
+        }
+
+        bool isShift(const Expr* E) {
+            if (const auto* BO = dyn_cast<BinaryOperator>(E->IgnoreParenImpCasts()))
+                return BO->getOpcode() == BO_Shl || BO->getOpcode() == BO_Shr;
+            return false;
+        }
+
+        // Returns the captured variable an assignment writes, if any (sum in sum += x)
+        const ValueDecl* capturedTarget(const Expr* E) {
+            if (const auto* DRE = dyn_cast<DeclRefExpr>(E->IgnoreParenImpCasts())) {
+                if (DRE->refersToEnclosingVariableOrCapture())
+                    return DRE->getDecl();
+            }
+            return nullptr;
+        }
     } // namespace
 
     void LoopAnalysis::computeLoopType() {
@@ -114,22 +156,45 @@ namespace clang::tidy::ilp {
             updateMax(DetectedLoopType::Divide);
         if (Analysis.hasMulInAdd)
             updateMax(DetectedLoopType::DotProduct);
-        if (Analysis.hasCompoundMul)
+        // A hash round's multiply, xor and shift are one chain, and the add feeding a scan is the
+        // scan: count those once, as the combined pattern
+        const bool isHash = Analysis.hasXorShift && (Analysis.hasMul || Analysis.hasCompoundMul);
+        if (Analysis.hasCompoundMul && !isHash)
             updateMax(DetectedLoopType::Multiply);
         if (Analysis.hasMinMax)
             updateMax(DetectedLoopType::MinMax);
-        if (Analysis.hasBitwise)
+        if (Analysis.hasBitwise && !isHash)
             updateMax(DetectedLoopType::Bitwise);
-        if (Analysis.hasShift)
+        if (Analysis.hasShift && !isHash)
             updateMax(DetectedLoopType::Shift);
+        if (isHash)
+            updateMax(DetectedLoopType::Hash);
+        if (Analysis.hasGather)
+            updateMax(DetectedLoopType::Gather);
+        if (Analysis.hasPopcount)
+            updateMax(DetectedLoopType::Popcount);
+        if (Analysis.hasCompareExchange)
+            updateMax(DetectedLoopType::CompareExchange);
+        if (Analysis.hasConvert)
+            updateMax(DetectedLoopType::Convert);
+        if (Analysis.hasScan)
+            updateMax(DetectedLoopType::Scan);
         if (Analysis.hasTransform)
             updateMax(DetectedLoopType::Transform);
         if (Analysis.hasCopy)
             updateMax(DetectedLoopType::Copy);
-        if (Analysis.hasCompoundAdd)
+        if (Analysis.hasCompoundAdd && !Analysis.hasScan)
             updateMax(DetectedLoopType::Sum);
 
-        return {dominantType, maxN};
+        return {dominantType, capForRegisters(maxN, Analysis)};
+    }
+
+    int ILPLoopCheck::capForRegisters(int N, const LoopAnalysis& Analysis) {
+        // Same formula as ilp::optimal_N's LivePerLane hint. Only accumulators are counted:
+        // loaded operands are consumed straight away and can share scratch registers.
+        return ::ilp::cpu::register_capped_N(::ilp::cpu::get(TargetCPU), N,
+                                             static_cast<int>(Analysis.accumulators.size()),
+                                             Analysis.isFloatingPoint);
     }
 
     ILPLoopCheck::ILPLoopCheck(StringRef Name, ClangTidyContext* Context)
@@ -220,6 +285,11 @@ namespace clang::tidy::ilp {
         // Recursively analyze all statements in the body
         analyzeStatement(Body, Analysis, Context);
 
+        for (const ValueDecl* Stored : Analysis.storedValues) {
+            if (Analysis.runningTotals.count(Stored))
+                Analysis.hasScan = true;
+        }
+
         // Note: We don't call computeLoopType() here anymore.
         // The caller should use computeOptimalN() to find the pattern
         // requiring the highest N (the bottleneck).
@@ -254,12 +324,24 @@ namespace clang::tidy::ilp {
         // Check for copy/transform pattern: assignment to indexed element
         // Handles: arr[i], i[arr], *(arr + i), *(i + arr)
         if (const auto* BO = dyn_cast<BinaryOperator>(S)) {
+            if (BO->isAssignmentOp()) {
+                if (const ValueDecl* Target = capturedTarget(BO->getLHS()))
+                    Analysis.accumulators.insert(Target);
+            }
             if (BO->isAssignmentOp() && !BO->isCompoundAssignmentOp()) {
                 const Expr* LHS = BO->getLHS();
                 const Expr* RHS = BO->getRHS()->IgnoreParenImpCasts();
 
                 // Check if LHS is an indexed access (dst[i] = ..., *(dst + i) = ...)
                 if (isIndexedAccess(LHS)) {
+                    // Storing a running total - a scan once we know the total is added to
+                    if (const ValueDecl* Stored = capturedTarget(RHS))
+                        Analysis.storedValues.insert(Stored);
+                    if (const auto* CAO = dyn_cast<CompoundAssignOperator>(RHS)) {
+                        if (CAO->getOpcode() == BO_AddAssign && capturedTarget(CAO->getLHS()))
+                            Analysis.hasScan = true;
+                    }
+
                     // Check if RHS is a function call - that's Transform
                     if (isa<CallExpr>(RHS)) {
                         Analysis.hasTransform = true;
@@ -272,6 +354,27 @@ namespace clang::tidy::ilp {
             }
         }
 
+        // Gather: an index that is itself loaded (src[idx[i]])
+        if (const auto* ASE = dyn_cast<ArraySubscriptExpr>(S)) {
+            if (isIndexedAccess(ASE->getIdx())) {
+                Analysis.hasGather = true;
+                Analysis.typeSize = builtinSize(ASE->getType());
+                Analysis.isFloatingPoint = ASE->getType()->isFloatingType();
+            }
+        }
+
+        // Convert: an explicit cast between integer and floating point. Implicit conversions are
+        // left alone - they are mostly incidental (an int index scaled by a float)
+        if (const auto* CE = dyn_cast<CastExpr>(S)) {
+            const auto* ICE = dyn_cast<ImplicitCastExpr>(CE);
+            const bool Explicit = isa<ExplicitCastExpr>(CE) || (ICE && ICE->isPartOfExplicitCast());
+            const bool ToFP = CE->getCastKind() == CK_IntegralToFloating;
+            if (Explicit && (ToFP || CE->getCastKind() == CK_FloatingToIntegral)) {
+                Analysis.hasConvert = true;
+                Analysis.typeSize = builtinSize(ToFP ? CE->getType() : CE->getSubExpr()->getType());
+            }
+        }
+
         // Recurse into child statements with depth limit
         for (const Stmt* Child : S->children()) {
             if (Child)
@@ -300,6 +403,13 @@ namespace clang::tidy::ilp {
             }
         }
 
+        if (Op == BO_Mul)
+            Analysis.hasMul = true;
+
+        // Xorshift: h ^ (h >> s), half of a hash round
+        if (Op == BO_Xor && (isShift(BO->getLHS()) || isShift(BO->getRHS())))
+            Analysis.hasXorShift = true;
+
         // Shift operations
         if (Op == BO_Shl || Op == BO_Shr) {
             Analysis.hasShift = true;
@@ -360,6 +470,8 @@ namespace clang::tidy::ilp {
         case BO_AddAssign:
         case BO_SubAssign:
             Analysis.hasCompoundAdd = true;
+            if (const ValueDecl* Total = capturedTarget(CAO->getLHS()))
+                Analysis.runningTotals.insert(Total);
             // Check for FMA pattern: acc += a * b
             // Only mark as FMA/DotProduct if BOTH operands are indexed expressions
             // This distinguishes dot product (a[i] * b[i]) from scaled sum (data[i] * 2.0)
@@ -382,6 +494,8 @@ namespace clang::tidy::ilp {
         case BO_OrAssign:
         case BO_XorAssign:
             Analysis.hasBitwise = true;
+            if (Op == BO_XorAssign && isShift(CAO->getRHS()))
+                Analysis.hasXorShift = true;
             break;
 
         case BO_ShlAssign:
@@ -435,6 +549,24 @@ namespace clang::tidy::ilp {
             Analysis.isFloatingPoint = true;
         }
 
+        // Popcount: std::popcount, __builtin_popcount{,l,ll}, _mm_popcnt_u32/u64
+        if (Name.find("popcount") != std::string::npos || Name.find("popcnt") != std::string::npos) {
+            Analysis.hasPopcount = true;
+            if (CE->getNumArgs() > 0)
+                Analysis.typeSize = builtinSize(CE->getArg(0)->getType());
+            Analysis.isFloatingPoint = false;
+        }
+
+        // Compare-exchange: the swap or min/max pair of a sorting network
+        if (Name == "swap" || Name == "iter_swap" || Name == "minmax") {
+            Analysis.hasCompareExchange = true;
+            if (CE->getNumArgs() > 0) {
+                QualType ArgTy = CE->getArg(0)->getType();
+                Analysis.typeSize = builtinSize(ArgTy);
+                Analysis.isFloatingPoint = !ArgTy->isDependentType() && ArgTy->isFloatingType();
+            }
+        }
+
         // Check for min/max (handles std::min, std::max, fmin, fmax, etc.)
         bool isMinMax = Name == "min" || Name == "max" || Name == "fmin" || Name == "fmax" || Name == "fminf" ||
                         Name == "fmaxf" || QualifiedName.find("::min") != std::string::npos ||
@@ -583,6 +715,40 @@ namespace clang::tidy::ilp {
                 return P.shift_8;
             return 2;
 
+        case DetectedLoopType::Gather:
+            if (Size == 8)
+                return P.gather_8;
+            return P.gather_4;
+
+        case DetectedLoopType::Popcount:
+            if (Size == 8)
+                return P.popcount_8;
+            return P.popcount_4;
+
+        case DetectedLoopType::CompareExchange:
+            if (Size == 8)
+                return P.cmpxchg_8;
+            return P.cmpxchg_4;
+
+        case DetectedLoopType::Convert:
+            if (Size == 8)
+                return P.convert_8;
+            return P.convert_4;
+
+        case DetectedLoopType::Hash:
+            if (Size == 8)
+                return P.hash_8;
+            return P.hash_4;
+
+        case DetectedLoopType::Scan:
+            if (Size == 8 && FP)
+                return P.scan_8f;
+            if (Size == 8)
+                return P.scan_8i;
+            if (FP)
+                return P.scan_4f;
+            return P.scan_4i;
+
         case DetectedLoopType::Unknown:
         default:
             return 4;
@@ -613,6 +779,18 @@ namespace clang::tidy::ilp {
             return "Bitwise";
         case DetectedLoopType::Shift:
             return "Shift";
+        case DetectedLoopType::Gather:
+            return "Gather";
+        case DetectedLoopType::Popcount:
+            return "Popcount";
+        case DetectedLoopType::CompareExchange:
+            return "CompareExchange";
+        case DetectedLoopType::Convert:
+            return "Convert";
+        case DetectedLoopType::Hash:
+            return "Hash";
+        case DetectedLoopType::Scan:
+            return "Scan";
         case DetectedLoopType::Unknown:
             return "Unknown";
         }
@@ -8,6 +8,7 @@
 
 #include "clang-tidy/ClangTidyCheck.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include <optional>
 #include <string>
 #include <utility>
@@ -16,18 +17,24 @@ namespace clang::tidy::ilp {
 
     /// Detected loop type patterns matching ilp::LoopType enum
     enum class DetectedLoopType {
-        Sum,        // acc += val
-        DotProduct, // acc += a * b (FMA pattern)
-        Search,     // early exit (if...break/return)
-        Copy,       // dst[i] = src[i]
-        Transform,  // dst[i] = f(src[i])
-        Multiply,   // acc *= val
-        Divide,     // x / y
-        Sqrt,       // sqrt(x)
-        MinMax,     // min(a,b) / max(a,b)
-        Bitwise,    // acc &= x, |=, ^=
-        Shift,      // x << n, x >> n
-        Unknown     // Could not determine
+        Sum,             // acc += val
+        DotProduct,      // acc += a * b (FMA pattern)
+        Search,          // early exit (if...break/return)
+        Copy,            // dst[i] = src[i]
+        Transform,       // dst[i] = f(src[i])
+        Multiply,        // acc *= val
+        Divide,          // x / y
+        Sqrt,            // sqrt(x)
+        MinMax,          // min(a,b) / max(a,b)
+        Bitwise,         // acc &= x, |=, ^=
+        Shift,           // x << n, x >> n
+        Gather,          // src[idx[i]]
+        Popcount,        // std::popcount(x), __builtin_popcount(x)
+        CompareExchange, // std::swap(a, b), std::minmax(a, b)
+        Convert,         // static_cast<float>(int), (int)x
+        Hash,            // h ^= h >> s; h *= k
+        Scan,            // acc += x; dst[i] = acc
+        Unknown          // Could not determine
     };
 
     /// Parsed macro arguments for fix generation
@@ -45,23 +52,38 @@ namespace clang::tidy::ilp {
         DetectedLoopType detectedType = DetectedLoopType::Unknown;
 
         // Evidence flags for each pattern
-        bool hasCompoundAdd = false; // +=
-        bool hasCompoundMul = false; // *=
-        bool hasMulInAdd = false;    // acc += a * b
-        bool hasEarlyExit = false;   // if(...) break/return
-        bool hasCopy = false;        // dst = src (different arrays)
-        bool hasTransform = false;   // dst = f(src)
-        bool hasDivision = false;    // a / b
-        bool hasSqrt = false;        // sqrt(x)
-        bool hasMinMax = false;      // std::min/max
-        bool hasBitwise = false;     // &=, |=, ^=
-        bool hasShift = false;       // <<, >>
+        bool hasCompoundAdd = false;     // +=
+        bool hasCompoundMul = false;     // *=
+        bool hasMulInAdd = false;        // acc += a * b
+        bool hasEarlyExit = false;       // if(...) break/return
+        bool hasCopy = false;            // dst = src (different arrays)
+        bool hasTransform = false;       // dst = f(src)
+        bool hasDivision = false;        // a / b
+        bool hasSqrt = false;            // sqrt(x)
+        bool hasMinMax = false;          // std::min/max
+        bool hasBitwise = false;         // &=, |=, ^=
+        bool hasShift = false;           // <<, >>
+        bool hasGather = false;          // src[idx[i]]
+        bool hasPopcount = false;        // popcount(x)
+        bool hasCompareExchange = false; // swap(a, b), minmax(a, b)
+        bool hasConvert = false;         // explicit int <-> FP cast
+        bool hasMul = false;             // a * b
+        bool hasXorShift = false;        // h ^ (h >> s)
+        bool hasScan = false;            // a running total stored every iteration
 
         // Type information for N computation
         QualType accumulatorType;
         unsigned typeSize = 0; // 1, 2, 4, 8 bytes
         bool isFloatingPoint = false;
 
+        // Captured variables the body writes - each lane keeps its own copy in a register
+        llvm::SmallPtrSet<const ValueDecl*, 8> accumulators;
+
+        // Captured variables added to (acc += x) and stored to memory (dst[i] = acc): the same
+        // variable in both is a scan
+        llvm::SmallPtrSet<const ValueDecl*, 4> runningTotals;
+        llvm::SmallPtrSet<const ValueDecl*, 4> storedValues;
+
         // Determine the primary loop type from evidence
         void computeLoopType();
     };
@@ -93,6 +115,9 @@ namespace clang::tidy::ilp {
         // Find the pattern needing the highest N - that's the bottleneck
         std::pair<DetectedLoopType, int> computeOptimalN(const LoopAnalysis& Analysis);
 
+        // Cap N so every lane's accumulators fit the target's register file
+        int capForRegisters(int N, const LoopAnalysis& Analysis);
+
         // Diagnostic helpers
         std::string getLoopTypeName(DetectedLoopType Type);
 
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <utility>
 
 // 1. Sum pattern: acc += val
 // Expected: DetectedLoopType::Sum, N varies by type
@@ -197,3 +198,70 @@ void test_shift_right(const unsigned* data, unsigned* result, std::size_t n) {
     }
     ILP_END;
 }
+
+// 12. Gather pattern: src[idx[i]]
+// Expected: DetectedLoopType::Gather, N=5
+void test_gather(const float* data, const int* idx, float* out, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        // CHECK: warning: Loop body contains Gather pattern
+        out[i] = data[idx[i]];
+    }
+    ILP_END;
+}
+
+// 13. Popcount pattern: std::popcount, __builtin_popcount
+// Expected: DetectedLoopType::Popcount, N=3
+void test_popcount(const unsigned* data, std::size_t n) {
+    int bits = 0;
+    ILP_FOR(auto i, 0uz, n, 4) {
+        // CHECK: warning: Loop body contains Popcount pattern
+        bits += __builtin_popcount(data[i]);
+    }
+    ILP_END;
+}
+
+// 14. CompareExchange pattern: std::swap, std::minmax
+// Expected: DetectedLoopType::CompareExchange, N=2
+void test_compare_exchange(int* data, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n / 2, 4) {
+        // CHECK: warning: Loop body contains CompareExchange pattern
+        if (data[2 * i + 1] < data[2 * i])
+            std::swap(data[2 * i], data[2 * i + 1]);
+    }
+    ILP_END;
+}
+
+// 15. Convert pattern: explicit int <-> FP cast
+// Expected: DetectedLoopType::Convert, N=8
+void test_convert(const int* data, float* result, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        // CHECK: warning: Loop body contains Convert pattern
+        result[i] = static_cast<float>(data[i]);
+    }
+    ILP_END;
+}
+
+// 16. Hash pattern: h ^= h >> s; h *= k
+// Expected: DetectedLoopType::Hash, N=5
+void test_hash(const unsigned long long* keys, unsigned long long* result, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        // CHECK: warning: Loop body contains Hash pattern
+        unsigned long long h = keys[i];
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        result[i] = h;
+    }
+    ILP_END;
+}
+
+// 17. Scan pattern: acc += x; dst[i] = acc
+// Expected: DetectedLoopType::Scan, N=4
+void test_scan(const float* data, float* result, std::size_t n) {
+    float total = 0.0f;
+    ILP_FOR(auto i, 0uz, n, 4) {
+        // CHECK: warning: Loop body contains Scan pattern
+        total += data[i];
+        result[i] = total;
+    }
+    ILP_END;
+}
@@ -258,6 +258,123 @@ TEST_CASE("Pattern detection", "[clang-tidy][detection]") {
     fs::remove(tmpFile);
 }
 
+// Patterns added with the Gather..Scan loop types; N values are skylake's
+TEST_CASE("Gather, Popcount, CompareExchange, Convert, Hash and Scan patterns", "[clang-tidy][detection]") {
+    std::string tmpFile = "/tmp/ilp_clang_tidy_test.cpp";
+
+    SECTION("Gather pattern: indexed load through an index array") {
+        // VPGATHERDD: L=22, TPC=0.2 → 5, above Copy's 4
+        const char* input = R"(
+#include "ilp_for.hpp"
+
+void test(const float* data, const int* idx, float* out, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        out[i] = data[idx[i]];
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("Gather pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=5") != std::string::npos);
+    }
+
+    SECTION("Popcount pattern") {
+        // POPCNT: N=3, ties with the 8-byte Sum it feeds
+        const char* input = R"(
+#include "ilp_for.hpp"
+#include <bit>
+
+void test(const unsigned long long* a, std::size_t n) {
+    int bits = 0;
+    ILP_FOR(auto i, 0uz, n, 4) {
+        bits += std::popcount(a[i]);
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("Popcount pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=3") != std::string::npos);
+    }
+
+    SECTION("CompareExchange pattern: std::swap in a sorting network") {
+        const char* input = R"(
+#include "ilp_for.hpp"
+#include <utility>
+
+void test(int* a, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n / 2, 4) {
+        if (a[2 * i + 1] < a[2 * i])
+            std::swap(a[2 * i], a[2 * i + 1]);
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("CompareExchange pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=2") != std::string::npos);
+    }
+
+    SECTION("Convert pattern: explicit int to float cast") {
+        // VCVTDQ2PS: L=4, TPC=2 → 8
+        const char* input = R"(
+#include "ilp_for.hpp"
+
+void test(const int* a, float* out, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        out[i] = static_cast<float>(a[i]) * 0.5f;
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("Convert pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=8") != std::string::npos);
+    }
+
+    SECTION("Hash pattern: multiply-xorshift round") {
+        // IMUL + xor + shift: L=5, TPC=1 → 5; not Multiply's 3 or Bitwise's 3
+        const char* input = R"(
+#include "ilp_for.hpp"
+
+void test(const unsigned long long* keys, unsigned long long* out, std::size_t n) {
+    ILP_FOR(auto i, 0uz, n, 4) {
+        unsigned long long h = keys[i];
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        out[i] = h;
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("Hash pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=5") != std::string::npos);
+    }
+
+    SECTION("Scan pattern: running total stored every iteration") {
+        // One store per cycle caps the FP add chain: 4, not Sum's 8
+        const char* input = R"(
+#include "ilp_for.hpp"
+
+void test(const float* a, float* out, std::size_t n) {
+    float total = 0;
+    ILP_FOR(auto i, 0uz, n, 4) {
+        total += a[i];
+        out[i] = total;
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("Scan pattern") != std::string::npos);
+        REQUIRE(result.output.find("N=4") != std::string::npos);
+    }
+
+    fs::remove(tmpFile);
+}
+
 // Test that regular for loops are not detected
 TEST_CASE("Regular for loops not detected", "[clang-tidy][negative]") {
     std::string tmpFile = "/tmp/ilp_clang_tidy_test.cpp";
@@ -695,6 +812,26 @@ void test(const int* a, const float* b, std::size_t n) {
         REQUIRE(result.output.find("N=8") != std::string::npos);
     }
 
+    SECTION("Four float accumulators capped by register file") {
+        // Sum (float): N=8, but 8 lanes x 4 accumulators won't fit skylake's 16 YMM → N=4
+        const char* input = R"(
+#include "ilp_for.hpp"
+
+void test(const float* a, const float* b, const float* c, const float* d, std::size_t n) {
+    float sa = 0, sb = 0, sc = 0, sd = 0;
+    ILP_FOR(auto i, 0uz, n, 4) {
+        sa += a[i];
+        sb += b[i];
+        sc += c[i];
+        sd += d[i];
+    } ILP_END;
+}
+)";
+        writeFile(tmpFile, input);
+        auto result = runClangTidy(tmpFile);
+        REQUIRE(result.output.find("N=4") != std::string::npos);
+    }
+
     fs::remove(tmpFile);
 }
 